@@ -0,0 +1,177 @@
+#include "hospital.h"        // Includes the main hospital system header
+#include "authentication.h"  // For credential checks
+#include "alloc_counter.h"   // For counting heap allocations
+#include "workload.h"        // For generated people and a quiet console
+#include <iomanip>           // For the results table
+#include <cstdlib>           // For strtoul
+
+// ========== ALLOCATION CHECK ========== //
+
+// One measured loop
+struct LoopResult {
+    string name;              // What the loop does
+    size_t iterations = 0;    // Lookups performed
+    size_t allocations = 0;   // Heap allocations made by them
+    size_t found = 0;         // Matches (printed so the loop cannot be optimized away)
+};
+
+// Builds a hospital with realistic (longer than inline-string) names and
+// addresses, then runs the lookups the menus and reports repeat most often and
+// counts the heap allocations they make. Every lookup loop must make none; a
+// loop that copies names is run first to show the counter sees copies.
+static bool runAllocationCheck(size_t patients) {
+    static const char* roomTypes[] = { "General", "ICU", "Private" };
+    PopulationBuilder people(2024, true);
+    patients = max<size_t>(patients, 1);
+
+    cout << "\nGenerating " << patients << " patients...\n";
+    HospitalSystem hospital;
+    vector<Patient*> patientList;
+    vector<Doctor*> doctorList;
+    vector<Medicine*> medicineList;
+    vector<Room*> roomList;
+    vector<UserCredentials> users;
+    {
+        ConsoleSilencer quiet;
+        doctorList = people.addDoctors(hospital, 20);
+        for (size_t i = 0; i < patients; i++) {
+            int id = 100000 + static_cast<int>(i);
+            Patient* patient = hospital.newPatient(people.patient(id, 1));
+            hospital.addPatient(patient);
+            hospital.scheduleAppointment(patient, 1 + static_cast<int>(people.pick(20)), "01/02/2025 10:30");
+            Billing* bill;
+            hospital.createBill(id, bill);
+            patientList.push_back(patient);
+        }
+        medicineList = people.addMedicines(hospital, 50, 1000);
+        for (int i = 0; i < 60; i++) {
+            Room* room = hospital.newRoom(roomTypes[i % 3]);
+            hospital.addRoom(room);
+            roomList.push_back(room);
+        }
+        for (int i = 0; i < 50; i++) {
+            users.emplace_back("front.desk.clerk" + to_string(i), "correct horse battery " + to_string(i), "Admin");
+        }
+    }
+
+    const string wantedName = patientList[patients / 2]->getName();
+    const string wantedPhone(patientList[patients / 3]->getContactNumber());
+    const string wantedMedicine = medicineList[25]->getName();
+    vector<LoopResult> results;
+    auto measure = [&results](const string& name, size_t iterations, auto loop) {
+        LoopResult result;
+        result.name = name;
+        result.iterations = iterations;
+        AllocationScope scope;
+        result.found = loop();
+        result.allocations = scope.allocations();
+        results.push_back(result);
+    };
+
+    // Counter self-test: copying the names out allocates once per long name
+    measure("Copy every patient name (should allocate)", patientList.size(), [&]() {
+        size_t found = 0;
+        for (Patient* patient : patientList) {
+            string copy = patient->getName();
+            found += copy == wantedName;
+        }
+        return found;
+    });
+
+    measure("Find patients, doctors, medicines by ID", patientList.size(), [&]() {
+        size_t found = 0;
+        for (size_t i = 0; i < patientList.size(); i++) {
+            Patient* patient;
+            Doctor* doctor;
+            Medicine* medicine;
+            hospital.findPatient(patientList[i]->getId(), patient);
+            hospital.findDoctor(doctorList[i % doctorList.size()]->getId(), doctor);
+            hospital.findMedicine(medicineList[i % medicineList.size()]->getId(), medicine);
+            found += patient && doctor && medicine;
+        }
+        return found;
+    });
+
+    measure("Match name and phone (Person getters)", patientList.size() + doctorList.size(), [&]() {
+        size_t found = 0;
+        for (Patient* patient : patientList) {
+            found += patient->getName() == wantedName || patient->getContactNumber() == wantedPhone;
+            found += patient->getAddress().empty() || patient->getGender() == "Other";
+        }
+        for (Doctor* doctor : doctorList) {
+            found += doctor->getName() == wantedName || doctor->getSpecialization() == "Cardiology";
+            found += doctor->getLicenseNumber().empty() || doctor->getDepartment() == "Cardiology";
+        }
+        return found;
+    });
+
+    measure("Blood group and appointment status", patientList.size(), [&]() {
+        size_t found = 0;
+        for (Patient* patient : patientList) {
+            found += patient->getBloodGroup() == "AB+";
+            for (const Appointment& appointment : patient->getAppointments()) {
+                found += appointment.getStatus() == AppointmentStatus::Pending;
+            }
+        }
+        return found;
+    });
+
+    measure("Find unpaid bills", patientList.size(), [&]() {
+        size_t found = 0;
+        for (Patient* patient : patientList) {
+            Billing* bill;
+            hospital.findPatientBill(patient->getId(), bill);
+            found += bill && bill->getPaymentStatus() == PaymentStatus::Unpaid;
+        }
+        return found;
+    });
+
+    measure("Find vacant rooms and medicines by name", 10000, [&]() {
+        size_t found = 0;
+        for (size_t i = 0; i < 10000; i++) {
+            Room* room;
+            hospital.findAvailableRoom(roomTypes[i % 3], room);
+            found += room && room->getType() == roomTypes[i % 3] && room->getStatus() == RoomStatus::Vacant;
+            const Medicine* medicine = medicineList[i % medicineList.size()];
+            found += medicine->getName() == wantedMedicine && !medicine->getExpiryDate().empty();
+        }
+        return found;
+    });
+
+    measure("Check credentials", users.size() * 100, [&]() {
+        size_t found = 0;
+        for (int round = 0; round < 100; round++) {
+            for (const UserCredentials& user : users) {
+                found += user.authenticate("front.desk.clerk7", "correct horse battery 7") &&
+                         user.getRole() == "Admin" && !user.getUsername().empty();
+            }
+        }
+        return found;
+    });
+
+    // Results (the first loop must allocate, every other must not)
+    bool passed = results[0].allocations > 0;
+    cout << "\n" << left << setw(46) << "Loop" << right << setw(12) << "Iterations" << setw(13) << "Allocations"
+         << setw(10) << "Matches" << setw(8) << "Result" << "\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const LoopResult& result = results[i];
+        bool ok = i == 0 ? result.allocations > 0 : result.allocations == 0;
+        if (!ok) passed = false;
+        cout << left << setw(46) << result.name << right << setw(12) << result.iterations << setw(13)
+             << result.allocations << setw(10) << result.found << setw(8) << (ok ? "PASS" : "FAIL") << "\n";
+    }
+    cout.unsetf(ios::adjustfield);
+    cout << (passed ? "\nAll lookup loops ran without a single heap allocation.\n"
+                    : "\nFAILED: a lookup loop allocated (or the counter saw no copies).\n");
+    return passed;
+}
+
+// ========== ENTRY POINT ========== //
+
+// Built as its own program (with alloc_counter.cpp instead of main.cpp), so
+// the counting operator new never replaces the hospital program's allocator.
+// Usage: alloc_check [patients]; the exit status is 1 if a lookup loop allocated.
+int main(int argc, char* argv[]) {
+    size_t patients = argc >= 2 ? strtoul(argv[1], nullptr, 10) : 2000;
+    return runAllocationCheck(patients) ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+#include "alloc_counter.h"  // Allocation counter declarations
+#include <new>              // For the replaced operators and bad_alloc
+#include <cstdlib>          // For malloc and free
+
+// Per thread, so concurrent work elsewhere never shows up in a measurement
+static thread_local size_t allocations = 0;
+
+size_t threadAllocationCount() { return allocations; }
+
+// ========== GLOBAL ALLOCATION OPERATORS ========== //
+// Same behaviour as the standard ones plus the count. The array and nothrow
+// forms call these, so replacing the two basic forms covers them all.
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* block = malloc(size ? size : 1)) return block;
+    throw bad_alloc();
+}
+
+void operator delete(void* block) noexcept { free(block); }
+
+void operator delete(void* block, size_t) noexcept { free(block); }
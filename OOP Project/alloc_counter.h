@@ -0,0 +1,23 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <cstddef>  // For size_t
+using namespace std;
+
+// Heap allocations made so far by the calling thread. Only the alloc_check
+// program links alloc_counter.cpp; there every allocation goes through its
+// operator new, so this counts strings and containers as well as the
+// hospital's own objects.
+size_t threadAllocationCount();
+
+// Counts the allocations the calling thread makes while it is alive
+class AllocationScope {
+private:
+    size_t start;  // Count when the scope began
+
+public:
+    AllocationScope() : start(threadAllocationCount()) {}
+
+    // Allocations since the scope began
+    size_t allocations() const { return threadAllocationCount() - start; }
+};
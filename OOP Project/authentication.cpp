@@ -3,11 +3,11 @@
 // UserCredentials implementation
 
 // Constructor for UserCredentials class
-UserCredentials::UserCredentials(const string& uname, const string& pwd, const string& r)
-    : username(uname), password(pwd), role(r) {}  // Initializes username, password, and role with provided values
+UserCredentials::UserCredentials(string uname, string pwd, string r)
+    : username(move(uname)), password(move(pwd)), role(move(r)) {}  // Initializes username, password, and role with provided values
 
 // Method to authenticate user by comparing provided credentials with stored ones
-bool UserCredentials::authenticate(const string& uname, const string& pwd) const {
+bool UserCredentials::authenticate(string_view uname, string_view pwd) const {
     return (username == uname && password == pwd);  // Returns true if both username and password match
 }
 
@@ -18,13 +18,20 @@ void UserCredentials::resetPassword(const string& newPwd) {
 }
 
 // Getter method for user's role
-string UserCredentials::getRole() const { return role; }
+const string& UserCredentials::getRole() const { return role; }
 
 // Getter method for username
-string UserCredentials::getUsername() const { return username; }
+const string& UserCredentials::getUsername() const { return username; }
 
 // AuthenticationSystem implementation
 
+// Destructor releases every UserCredentials object owned by the system
+AuthenticationSystem::~AuthenticationSystem() {
+    for (auto& user : users) {
+        delete user.second;
+    }
+}
+
 // Method to add a new user to the system
 void AuthenticationSystem::addUser(const string& username, const string& password, const string& role) {
     users.push_back(make_pair(username, new UserCredentials(username, password, role)));  // Creates new UserCredentials and adds to users vector
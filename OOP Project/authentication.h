@@ -2,6 +2,7 @@
 
 #include <iostream>   // For input/output operations (cout, cin)
 #include <string>     // For string class
+#include <string_view> // For comparisons without copies
 #include <vector>     // For vector container
 using namespace std;  // Using standard namespace (simplifies code but not recommended for large projects)
 
@@ -14,19 +15,19 @@ private:
 
 public:
     // Constructor to initialize credentials
-    UserCredentials(const string& uname, const string& pwd, const string& r);
+    UserCredentials(string uname, string pwd, string r);
     
     // Method to verify if provided credentials match stored ones
-    bool authenticate(const string& uname, const string& pwd) const;
+    bool authenticate(string_view uname, string_view pwd) const;
     
     // Method to change the user's password
     void resetPassword(const string& newPwd);
     
     // Getter for user's role
-    string getRole() const;
+    const string& getRole() const;
     
     // Getter for username
-    string getUsername() const;
+    const string& getUsername() const;
 };
 
 // Class representing the authentication system that manages multiple users
@@ -37,6 +38,13 @@ private:
     vector<pair<string, UserCredentials*>> users;
 
 public:
+    AuthenticationSystem() = default;
+    AuthenticationSystem(const AuthenticationSystem&) = delete;             // Owns its credentials
+    AuthenticationSystem& operator=(const AuthenticationSystem&) = delete;
+    
+    // Releases all stored credentials
+    ~AuthenticationSystem();
+    
     // Adds a new user to the system
     void addUser(const string& username, const string& password, const string& role);
     
@@ -1,4 +1,5 @@
 #include "hospital.h"  // Includes the hospital header file which likely contains Billing class declaration
+#include "varint.h"    // For checkpoint serialization
 
 // Billing implementation
 
@@ -10,12 +11,29 @@ Billing::Billing(int pId)
     : billId(nextId++),       // Assigns auto-incremented bill ID
       patientId(pId),         // Sets patient ID from parameter
       totalAmount(0),         // Initializes amount to 0
-      paymentStatus("Unpaid") {} // Default status is "Unpaid"
+      paymentStatus(PaymentStatus::Unpaid) {} // Default status is "Unpaid"
+
+// Payment status names, indexed by PaymentStatus
+const string& statusName(PaymentStatus status) {
+    static const string names[] = { "Unpaid", "Paid" };
+    return names[static_cast<int>(status)];
+}
+
+// A bill is paid once; a refund makes it unpaid again
+bool isValidTransition(PaymentStatus from, PaymentStatus to) { return from != to; }
+
+// Sets the ID the next bill receives
+void Billing::setNextId(int id) { nextId = id; }
+
+// ID the next bill receives
+int Billing::getNextId() { return nextId; }
 
 // Adds a medical service to the bill
 void Billing::addService(const string& service, double cost) {
     servicesAvailed.push_back(service);  // Adds service to vector
     totalAmount += cost;                // Updates total cost
+    changed = true;
+    publishVersion();
     cout << "\nAdded service: " << service << " ($" << cost << ")\n";  // Confirmation message
 }
 
@@ -23,27 +41,78 @@ void Billing::addService(const string& service, double cost) {
 void Billing::addMedicine(int medId, int quantity, double price) {
     medicines.emplace_back(medId, quantity);  // Adds medicine as pair (ID, quantity)
     totalAmount += (price * quantity);       // Updates total with calculated cost
+    changed = true;
+    publishVersion();
     cout << "\nAdded medicine ID " << medId << " (x" << quantity << ") - $" 
          << (price * quantity) << "\n";     // Confirmation message
 }
 
 // Processes payment for the bill
-void Billing::processPayment(double amount) {
+bool Billing::processPayment(double amount) {
+    if (!isValidTransition(paymentStatus, PaymentStatus::Paid)) {
+        cout << "\nBill #" << billId << " is already paid!\n";  // Error message
+        return false;
+    }
     if (amount >= totalAmount) {                    // If payment covers full amount
-        paymentStatus = "Paid";                    // Update status
+        paymentStatus = PaymentStatus::Paid;       // Update status
+        changed = true;
+        publishVersion();
         cout << "\nPayment processed. Change: $" << (amount - totalAmount) << "\n";  // Show change
-    } else {                                       // If payment is insufficient
-        cout << "\nInsufficient payment! Remaining balance: $" 
-             << (totalAmount - amount) << "\n";    // Show remaining balance
+        return true;
+    }
+    cout << "\nInsufficient payment! Remaining balance: $" 
+         << (totalAmount - amount) << "\n";        // Show remaining balance
+    return false;
+}
+
+// Removes the most recent charge for a service
+void Billing::removeService(const string& service, double cost) {
+    for (auto it = servicesAvailed.rbegin(); it != servicesAvailed.rend(); ++it) {
+        if (*it == service) {
+            servicesAvailed.erase(next(it).base());
+            totalAmount -= cost;  // Takes the charge back off the total
+            changed = true;
+            publishVersion();
+            cout << "\nRemoved service: " << service << " ($" << cost << ")\n";  // Confirmation
+            return;
+        }
+    }
+}
+
+// Removes the most recent charge for a quantity of medicine
+void Billing::removeMedicine(int medId, int quantity, double price) {
+    for (auto it = medicines.rbegin(); it != medicines.rend(); ++it) {
+        if (it->first == medId && it->second == quantity) {
+            medicines.erase(next(it).base());
+            totalAmount -= price * quantity;  // Takes the charge back off the total
+            changed = true;
+            publishVersion();
+            cout << "\nRemoved medicine ID " << medId << " (x" << quantity << ") - $"
+                 << (price * quantity) << "\n";  // Confirmation
+            return;
+        }
     }
 }
 
+// Marks a paid bill as unpaid again
+bool Billing::refundPayment() {
+    if (!isValidTransition(paymentStatus, PaymentStatus::Unpaid)) {
+        cout << "\nBill #" << billId << " is not paid; there is nothing to refund.\n";  // Error message
+        return false;
+    }
+    paymentStatus = PaymentStatus::Unpaid;
+    changed = true;
+    publishVersion();
+    cout << "\nPayment reversed; bill #" << billId << " is unpaid again.\n";  // Confirmation
+    return true;
+}
+
 // Displays detailed bill information
 void Billing::displayBill() const {
     // Bill header
     cout << "\n=== BILL #" << billId << " ===\n";
     cout << "Patient ID: " << patientId << "\n";
-    cout << "Payment Status: " << paymentStatus << "\n\n";
+    cout << "Payment Status: " << statusName(paymentStatus) << "\n\n";
     
     // List services
     cout << "Services Availed:\n";
@@ -73,4 +142,58 @@ int Billing::getPatientId() const { return patientId; }
 double Billing::getTotalAmount() const { return totalAmount; }
 
 // Getter for payment status
-string Billing::getPaymentStatus() const { return paymentStatus; }
\ No newline at end of file
+PaymentStatus Billing::getPaymentStatus() const { return paymentStatus; }
+
+// Links the bill to its report snapshot row
+void Billing::setVersions(VersionedTable<Billing>* table, uint32_t row) {
+    versions = table;
+    versionRow = row;
+}
+
+// True if modified since the last checkpoint
+bool Billing::isChanged() const { return changed; }
+
+// The last checkpoint now holds this bill's state
+void Billing::markSaved() { changed = false; }
+
+// Serializes the bill for a checkpoint
+void Billing::writeTo(vector<uint8_t>& out) const {
+    writeSigned(out, billId);
+    writeSigned(out, patientId);
+    writeDouble(out, totalAmount);
+    writeVarint(out, static_cast<uint32_t>(paymentStatus));
+    writeVarint(out, servicesAvailed.size());
+    for (const auto& service : servicesAvailed) writeString(out, service);
+    writeVarint(out, medicines.size());
+    for (const auto& item : medicines) {
+        writeSigned(out, item.first);
+        writeSigned(out, item.second);
+    }
+}
+
+// Reads a bill written by writeTo (keeps its original ID)
+Billing Billing::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    int id = static_cast<int>(readSigned(in, pos));
+    Billing bill(static_cast<int>(readSigned(in, pos)));
+    bill.billId = id;
+    bill.totalAmount = readDouble(in, pos);
+    bill.paymentStatus = static_cast<PaymentStatus>(readVarint(in, pos));
+    bill.servicesAvailed.resize(readVarint(in, pos));
+    for (auto& service : bill.servicesAvailed) service = readString(in, pos);
+    bill.medicines.resize(readVarint(in, pos));
+    for (auto& item : bill.medicines) {
+        item.first = static_cast<int>(readSigned(in, pos));
+        item.second = static_cast<int>(readSigned(in, pos));
+    }
+    return bill;
+}
+
+// Publishes the current state to report snapshots
+void Billing::publishVersion() const {
+    if (versions) versions->update(versionRow, *this);
+}
+
+// Object size plus owned heap memory
+size_t Billing::memoryUsage() const {
+    return sizeof(Billing) + stringVectorHeapBytes(servicesAvailed) + vectorBufferBytes(medicines);
+}
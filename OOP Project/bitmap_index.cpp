@@ -0,0 +1,263 @@
+#include "bitmap_index.h"  // Bitmap index declarations
+#include "memory.h"        // For footprint helpers
+#include <algorithm>       // For lower_bound and set merges
+
+// ========== CONTAINER IMPLEMENTATION ========== //
+
+// Returns true if low value is stored
+bool RoaringBitmap::Container::contains(uint16_t low) const {
+    if (isBitset()) return (bitset[low >> 6] >> (low & 63)) & 1;
+    return binary_search(array.begin(), array.end(), low);
+}
+
+// Adds low value, switching to bitset form when the array grows too large
+bool RoaringBitmap::Container::add(uint16_t low) {
+    if (isBitset()) {
+        uint64_t bit = 1ULL << (low & 63);
+        if (bitset[low >> 6] & bit) return false;
+        bitset[low >> 6] |= bit;
+    } else {
+        auto it = lower_bound(array.begin(), array.end(), low);
+        if (it != array.end() && *it == low) return false;
+        array.insert(it, low);
+        if (array.size() > ARRAY_LIMIT) toBitset();
+    }
+    cardinality++;
+    return true;
+}
+
+// Removes low value, switching back to array form when sparse
+bool RoaringBitmap::Container::remove(uint16_t low) {
+    if (isBitset()) {
+        uint64_t bit = 1ULL << (low & 63);
+        if (!(bitset[low >> 6] & bit)) return false;
+        bitset[low >> 6] &= ~bit;
+        cardinality--;
+        toArrayIfSparse();
+        return true;
+    }
+    auto it = lower_bound(array.begin(), array.end(), low);
+    if (it == array.end() || *it != low) return false;
+    array.erase(it);
+    cardinality--;
+    return true;
+}
+
+// Converts array form to bitset form
+void RoaringBitmap::Container::toBitset() {
+    bitset.assign(BITSET_WORDS, 0);
+    for (uint16_t low : array) bitset[low >> 6] |= 1ULL << (low & 63);
+    vector<uint16_t>().swap(array);  // Release array memory
+}
+
+// Converts bitset form back to array form when it has become sparse
+void RoaringBitmap::Container::toArrayIfSparse() {
+    if (!isBitset() || cardinality > ARRAY_LIMIT) return;
+    array.clear();
+    array.reserve(cardinality);
+    for (size_t w = 0; w < BITSET_WORDS; w++) {
+        uint64_t word = bitset[w];
+        while (word) {
+            array.push_back(static_cast<uint16_t>(w * 64 + __builtin_ctzll(word)));
+            word &= word - 1;
+        }
+    }
+    vector<uint64_t>().swap(bitset);  // Release bitset memory
+}
+
+// ========== ROARING BITMAP IMPLEMENTATION ========== //
+
+// Returns container for key, or nullptr
+const RoaringBitmap::Container* RoaringBitmap::find(uint16_t key) const {
+    auto it = lower_bound(containers.begin(), containers.end(), key,
+                          [](const Container& c, uint16_t k) { return c.key < k; });
+    return (it != containers.end() && it->key == key) ? &*it : nullptr;
+}
+
+RoaringBitmap::Container* RoaringBitmap::find(uint16_t key) {
+    return const_cast<Container*>(static_cast<const RoaringBitmap*>(this)->find(key));
+}
+
+// Adds an ID
+void RoaringBitmap::add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    auto it = lower_bound(containers.begin(), containers.end(), key,
+                          [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers.end() || it->key != key) {
+        it = containers.insert(it, Container());  // New container keeps keys sorted
+        it->key = key;
+    }
+    it->add(static_cast<uint16_t>(value & 0xFFFF));
+}
+
+// Removes an ID (drops the container once empty)
+void RoaringBitmap::remove(uint32_t value) {
+    Container* container = find(static_cast<uint16_t>(value >> 16));
+    if (!container || !container->remove(static_cast<uint16_t>(value & 0xFFFF))) return;
+    if (container->cardinality == 0) {
+        containers.erase(containers.begin() + (container - containers.data()));
+    }
+}
+
+// Returns true if the ID is present
+bool RoaringBitmap::contains(uint32_t value) const {
+    const Container* container = find(static_cast<uint16_t>(value >> 16));
+    return container && container->contains(static_cast<uint16_t>(value & 0xFFFF));
+}
+
+// Number of IDs stored
+size_t RoaringBitmap::cardinality() const {
+    size_t total = 0;
+    for (const auto& c : containers) total += c.cardinality;
+    return total;
+}
+
+// Appends all IDs in ascending order
+void RoaringBitmap::toVector(vector<int>& out) const {
+    for (const auto& c : containers) {
+        uint32_t high = static_cast<uint32_t>(c.key) << 16;
+        if (c.isBitset()) {
+            for (size_t w = 0; w < BITSET_WORDS; w++) {
+                uint64_t word = c.bitset[w];
+                while (word) {
+                    out.push_back(static_cast<int>(high | (w * 64 + __builtin_ctzll(word))));
+                    word &= word - 1;
+                }
+            }
+        } else {
+            for (uint16_t low : c.array) out.push_back(static_cast<int>(high | low));
+        }
+    }
+}
+
+// Visits IDs from largest to smallest until the visitor returns false
+void RoaringBitmap::visitDescending(const function<bool(uint32_t)>& visit) const {
+    for (auto c = containers.rbegin(); c != containers.rend(); ++c) {
+        uint32_t high = static_cast<uint32_t>(c->key) << 16;
+        if (c->isBitset()) {
+            for (size_t w = BITSET_WORDS; w-- > 0;) {
+                uint64_t word = c->bitset[w];
+                while (word) {
+                    int bit = 63 - __builtin_clzll(word);  // Highest set bit
+                    if (!visit(high | static_cast<uint32_t>(w * 64 + bit))) return;
+                    word &= ~(1ULL << bit);
+                }
+            }
+        } else {
+            for (auto low = c->array.rbegin(); low != c->array.rend(); ++low) {
+                if (!visit(high | *low)) return;
+            }
+        }
+    }
+}
+
+// Heap bytes used by the containers
+size_t RoaringBitmap::memoryUsage() const {
+    size_t bytes = vectorBufferBytes(containers);
+    for (const auto& c : containers) {
+        bytes += vectorBufferBytes(c.array) + vectorBufferBytes(c.bitset);
+    }
+    return bytes;
+}
+
+// Combines two bitmaps container by container
+RoaringBitmap RoaringBitmap::combine(const RoaringBitmap& a, const RoaringBitmap& b, int op) {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() || j < b.containers.size()) {
+        const Container* ca = i < a.containers.size() ? &a.containers[i] : nullptr;
+        const Container* cb = j < b.containers.size() ? &b.containers[j] : nullptr;
+
+        // Key present on one side only
+        if (!cb || (ca && ca->key < cb->key)) {
+            if (op != 0) result.containers.push_back(*ca);  // OR and AND NOT keep a's values
+            i++;
+            continue;
+        }
+        if (!ca || cb->key < ca->key) {
+            if (op == 1) result.containers.push_back(*cb);  // Only OR keeps b's values
+            j++;
+            continue;
+        }
+
+        // Key present on both sides
+        Container out;
+        out.key = ca->key;
+        if (op == 1 && !ca->isBitset() && !cb->isBitset() &&
+            ca->array.size() + cb->array.size() <= ARRAY_LIMIT) {
+            set_union(ca->array.begin(), ca->array.end(), cb->array.begin(), cb->array.end(),
+                      back_inserter(out.array));
+            out.cardinality = static_cast<uint32_t>(out.array.size());
+        } else if (op != 1 && !ca->isBitset()) {
+            // Sparse left side: probe each value in the right container
+            for (uint16_t low : ca->array) {
+                if (cb->contains(low) == (op == 0)) out.array.push_back(low);
+            }
+            out.cardinality = static_cast<uint32_t>(out.array.size());
+        } else {
+            // Dense path: word-wise operation on bitsets
+            Container left = *ca, right = *cb;
+            if (!left.isBitset()) left.toBitset();
+            if (!right.isBitset()) right.toBitset();
+            out.bitset.resize(BITSET_WORDS);
+            for (size_t w = 0; w < BITSET_WORDS; w++) {
+                uint64_t word = op == 0 ? (left.bitset[w] & right.bitset[w])
+                              : op == 1 ? (left.bitset[w] | right.bitset[w])
+                                        : (left.bitset[w] & ~right.bitset[w]);
+                out.bitset[w] = word;
+                out.cardinality += static_cast<uint32_t>(__builtin_popcountll(word));
+            }
+            out.toArrayIfSparse();
+        }
+        if (out.cardinality > 0) result.containers.push_back(move(out));
+        i++;
+        j++;
+    }
+    return result;
+}
+
+// AND
+RoaringBitmap RoaringBitmap::operator&(const RoaringBitmap& other) const { return combine(*this, other, 0); }
+
+// OR
+RoaringBitmap RoaringBitmap::operator|(const RoaringBitmap& other) const { return combine(*this, other, 1); }
+
+// AND NOT
+RoaringBitmap RoaringBitmap::andNot(const RoaringBitmap& other) const { return combine(*this, other, 2); }
+
+// ========== CATEGORY INDEX IMPLEMENTATION ========== //
+
+// Records that an ID has the value
+void CategoryIndex::add(int id, const string& value) {
+    bitmaps[value].add(static_cast<uint32_t>(id));
+}
+
+// Removes an ID from a value
+void CategoryIndex::remove(int id, const string& value) {
+    auto it = bitmaps.find(value);
+    if (it == bitmaps.end()) return;
+    it->second.remove(static_cast<uint32_t>(id));
+    if (it->second.cardinality() == 0) bitmaps.erase(it);  // Drop empty categories
+}
+
+// Moves an ID from one value to another
+void CategoryIndex::update(int id, const string& oldValue, const string& newValue) {
+    if (oldValue == newValue) return;
+    remove(id, oldValue);
+    add(id, newValue);
+}
+
+// Bitmap of IDs having the value
+const RoaringBitmap& CategoryIndex::lookup(const string& value) const {
+    auto it = bitmaps.find(value);
+    return it == bitmaps.end() ? empty : it->second;
+}
+
+// Heap bytes used by all bitmaps
+size_t CategoryIndex::memoryUsage() const {
+    size_t bytes = bitmaps.bucket_count() * sizeof(void*);
+    for (const auto& entry : bitmaps) {
+        bytes += sizeof(entry) + sizeof(void*) + stringHeapBytes(entry.first) + entry.second.memoryUsage();
+    }
+    return bytes;
+}
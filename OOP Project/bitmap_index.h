@@ -0,0 +1,91 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>         // For category values
+#include <vector>         // For container storage
+#include <unordered_map>  // For value -> bitmap lookup
+#include <cstdint>        // For fixed-width types
+#include <functional>     // For visitor callbacks
+using namespace std;
+
+// Compressed bitmap of 32-bit IDs (roaring layout).
+// IDs are split by their high 16 bits into containers; a container stores its
+// low 16 bits as a sorted array while sparse and as a 65536-bit set once dense.
+class RoaringBitmap {
+private:
+    static const size_t ARRAY_LIMIT = 4096;  // Above this an array is larger than a bitset
+    static const size_t BITSET_WORDS = 1024; // 65536 bits
+
+    struct Container {
+        uint16_t key = 0;           // High 16 bits shared by all values
+        uint32_t cardinality = 0;   // Number of values stored
+        vector<uint16_t> array;     // Sorted low bits (sparse form)
+        vector<uint64_t> bitset;    // Bit per low value (dense form)
+
+        bool isBitset() const { return !bitset.empty(); }
+        bool contains(uint16_t low) const;
+        bool add(uint16_t low);      // Returns true if value was new
+        bool remove(uint16_t low);   // Returns true if value was present
+        void toBitset();             // Converts array form to bitset form
+        void toArrayIfSparse();      // Converts bitset form back when small
+    };
+
+    vector<Container> containers;  // Sorted by key
+
+    // Returns container for key, or nullptr
+    const Container* find(uint16_t key) const;
+    Container* find(uint16_t key);
+
+    // Combines two bitmaps word by word (op: 0 = AND, 1 = OR, 2 = AND NOT)
+    static RoaringBitmap combine(const RoaringBitmap& a, const RoaringBitmap& b, int op);
+
+public:
+    // Adds an ID
+    void add(uint32_t value);
+
+    // Removes an ID
+    void remove(uint32_t value);
+
+    // Returns true if the ID is present
+    bool contains(uint32_t value) const;
+
+    // Number of IDs stored
+    size_t cardinality() const;
+
+    // Appends all IDs in ascending order
+    void toVector(vector<int>& out) const;
+
+    // Calls visit for IDs from largest to smallest until it returns false
+    void visitDescending(const function<bool(uint32_t)>& visit) const;
+
+    // Heap bytes used by the containers
+    size_t memoryUsage() const;
+
+    // Set operations
+    RoaringBitmap operator&(const RoaringBitmap& other) const;  // AND
+    RoaringBitmap operator|(const RoaringBitmap& other) const;  // OR
+    RoaringBitmap andNot(const RoaringBitmap& other) const;     // AND NOT
+};
+
+// Bitmap index over one categorical attribute (value -> IDs having it)
+class CategoryIndex {
+private:
+    unordered_map<string, RoaringBitmap> bitmaps;  // One bitmap per distinct value
+    RoaringBitmap empty;                           // Returned for unknown values
+
+public:
+    // Records that an ID has the value
+    void add(int id, const string& value);
+
+    // Removes an ID from a value
+    void remove(int id, const string& value);
+
+    // Moves an ID from one value to another
+    void update(int id, const string& oldValue, const string& newValue);
+
+    // Bitmap of IDs having the value (empty bitmap if none)
+    const RoaringBitmap& lookup(const string& value) const;
+
+    // Heap bytes used by all bitmaps
+    size_t memoryUsage() const;
+};
@@ -0,0 +1,44 @@
+#include "blood_match.h"  // Blood compatibility declarations
+#include <cctype>         // For toupper/isspace
+
+// Canonical names indexed by code
+static const char* const BLOOD_GROUP_NAMES[BLOOD_GROUP_COUNT] = {
+    "O-", "O+", "B-", "B+", "A-", "A+", "AB-", "AB+"
+};
+
+// Precomputed donor masks: donor d is compatible with recipient r when (d & ~r) == 0
+static const uint8_t DONOR_MASKS[BLOOD_GROUP_COUNT] = {
+    0x01,  // O-  <- O-
+    0x03,  // O+  <- O-, O+
+    0x05,  // B-  <- O-, B-
+    0x0F,  // B+  <- O-, O+, B-, B+
+    0x11,  // A-  <- O-, A-
+    0x33,  // A+  <- O-, O+, A-, A+
+    0x55,  // AB- <- all negative groups
+    0xFF   // AB+ <- everyone
+};
+
+// Returns code for blood group text
+int bloodGroupCode(const string& bloodGroup) {
+    string normalized;
+    for (char c : bloodGroup) {
+        if (!isspace(static_cast<unsigned char>(c))) {
+            normalized += static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        }
+    }
+    if (normalized == "0-" || normalized == "0+") normalized[0] = 'O';  // Common typo
+    for (int code = 0; code < BLOOD_GROUP_COUNT; code++) {
+        if (normalized == BLOOD_GROUP_NAMES[code]) return code;
+    }
+    return -1;
+}
+
+// Returns canonical name for a code
+const char* bloodGroupName(int code) {
+    return (code >= 0 && code < BLOOD_GROUP_COUNT) ? BLOOD_GROUP_NAMES[code] : "Unknown";
+}
+
+// Returns donor mask for a recipient
+uint8_t compatibleDonorMask(int recipientCode) {
+    return (recipientCode >= 0 && recipientCode < BLOOD_GROUP_COUNT) ? DONOR_MASKS[recipientCode] : 0;
+}
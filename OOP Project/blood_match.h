@@ -0,0 +1,20 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For blood group text
+#include <cstdint>  // For compatibility masks
+using namespace std;
+
+// Number of ABO/Rh blood groups
+const int BLOOD_GROUP_COUNT = 8;
+
+// Blood group codes are antigen bit sets: bit 2 = A, bit 1 = B, bit 0 = Rh(D).
+// A donor can give to a recipient when the donor has no antigen the recipient lacks.
+// Returns code for text such as "AB-" or "o +" (-1 if not a recognised group)
+int bloodGroupCode(const string& bloodGroup);
+
+// Returns canonical name for a code (e.g. "AB-")
+const char* bloodGroupName(int code);
+
+// Bit d is set when donor group d is compatible with the recipient group
+uint8_t compatibleDonorMask(int recipientCode);
@@ -0,0 +1,178 @@
+#include "bloom_filter.h"  // Bloom filter declarations
+#include "memory.h"        // For footprint helpers
+#include <iostream>        // For reports
+#include <iomanip>         // For formatted figures
+#include <chrono>          // For benchmark timing
+#include <random>          // For generated IDs
+#include <cmath>           // For sizing formulas
+#include <algorithm>       // For max
+
+// ========== HELPERS ========== //
+
+// Spreads key bits over the whole word (splitmix64 finaliser)
+static uint64_t mixKey(uint64_t key) {
+    key += 0x9E3779B97F4A7C15ULL;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+    return key ^ (key >> 31);
+}
+
+// 64-bit FNV-1a hash of a string key
+static uint64_t hashString(const string& key) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// ========== BLOOM FILTER IMPLEMENTATION ========== //
+
+// Constructor records the target; the first layer is created on the first add
+BloomFilter::BloomFilter(double falsePositiveRate, size_t expectedItems)
+    : falsePositiveRate(min(max(falsePositiveRate, 1e-9), 0.5)),  // Keeps sizing formulas finite
+      initialCapacity(max<size_t>(expectedItems, 64)) {}
+
+// Layer i gets capacity initial * 2^i and error rate target / 2^(i+1), so the
+// rates sum to less than the target
+void BloomFilter::addLayer() {
+    size_t index = layers.size();
+    double rate = falsePositiveRate / static_cast<double>(2ULL << min<size_t>(index, 60));
+    Layer layer;
+    layer.capacity = initialCapacity << min<size_t>(index, 40);
+    double ln2 = log(2.0);
+    uint64_t bits = static_cast<uint64_t>(ceil(-static_cast<double>(layer.capacity) * log(rate) / (ln2 * ln2)));
+    layer.bits.assign((bits + 63) / 64, 0);
+    layer.bitCount = layer.bits.size() * 64;
+    layer.hashes = max(1, static_cast<int>(round(-log2(rate))));
+    layers.push_back(move(layer));
+}
+
+// Adds a key to the newest layer, starting one when it is full
+void BloomFilter::add(uint64_t key) {
+    if (layers.empty() || layers.back().items >= layers.back().capacity) addLayer();
+    Layer& layer = layers.back();
+    uint64_t hash = mixKey(key);
+    uint64_t h1 = hash, h2 = (hash >> 32) | 1;  // Double hashing: probe i at h1 + i * h2
+    for (int i = 0; i < layer.hashes; i++) {
+        uint64_t bit = (h1 + static_cast<uint64_t>(i) * h2) % layer.bitCount;
+        layer.bits[bit >> 6] |= 1ULL << (bit & 63);
+    }
+    layer.items++;
+}
+
+void BloomFilter::add(const string& key) { add(hashString(key)); }
+
+// True if every probe of some layer is set
+bool BloomFilter::mightContain(uint64_t key) const {
+    lookups++;
+    uint64_t hash = mixKey(key);
+    uint64_t h1 = hash, h2 = (hash >> 32) | 1;
+    for (const auto& layer : layers) {
+        bool all = true;
+        for (int i = 0; i < layer.hashes && all; i++) {
+            uint64_t bit = (h1 + static_cast<uint64_t>(i) * h2) % layer.bitCount;
+            all = (layer.bits[bit >> 6] >> (bit & 63)) & 1;
+        }
+        if (all) return true;
+    }
+    rejected++;
+    return false;
+}
+
+bool BloomFilter::mightContain(const string& key) const { return mightContain(hashString(key)); }
+
+// Records that a "maybe" answer turned out to be absent
+void BloomFilter::reportFalsePositive() { falsePositives++; }
+
+// Removes every key
+void BloomFilter::clear() {
+    vector<Layer>().swap(layers);
+    lookups = rejected = falsePositives = 0;
+}
+
+// Keys added
+size_t BloomFilter::itemCount() const {
+    size_t total = 0;
+    for (const auto& layer : layers) total += layer.items;
+    return total;
+}
+
+// Configured target rate
+double BloomFilter::getFalsePositiveRate() const { return falsePositiveRate; }
+
+// Share of absent-key lookups that were not rejected
+double BloomFilter::observedFalsePositiveRate() const {
+    size_t absent = rejected + falsePositives;
+    return absent ? static_cast<double>(falsePositives) / absent : 0.0;
+}
+
+// Membership tests
+size_t BloomFilter::lookupCount() const { return lookups; }
+
+// Tests answered "absent"
+size_t BloomFilter::rejectedCount() const { return rejected; }
+
+// Heap bytes used by the layers
+size_t BloomFilter::memoryUsage() const {
+    size_t bytes = vectorBufferBytes(layers);
+    for (const auto& layer : layers) bytes += vectorBufferBytes(layer.bits);
+    return bytes;
+}
+
+// Prints one report line: keys, memory, lookups, rejections and error rates
+void BloomFilter::displayRow(const string& label) const {
+    cout << left << setw(12) << label << right << setw(10) << itemCount() << setw(12) << memoryUsage()
+         << setw(10) << lookups << setw(10) << rejected << setw(10) << falsePositives
+         << fixed << setprecision(3) << setw(10) << observedFalsePositiveRate() * 100 << "%"
+         << setw(9) << falsePositiveRate * 100 << "%\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6) << left;
+}
+
+// ========== BENCHMARK ========== //
+
+// Compares linear-scan misses with and without a filter on generated IDs
+void runBloomFilterBenchmark(size_t items, double falsePositiveRate) {
+    mt19937 generator(2024);
+    vector<int> ids(items);
+    for (auto& id : ids) id = static_cast<int>(generator() & 0x3FFFFFFF) | 1;  // Stored IDs are odd
+
+    BloomFilter filter(falsePositiveRate, items);
+    auto start = chrono::steady_clock::now();
+    for (int id : ids) filter.add(static_cast<uint64_t>(id));
+    double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Mistyped IDs: every probe is even, so absent
+    size_t probes = max<size_t>(1000, min<size_t>(2000000, 200000000 / max<size_t>(items, 1)));
+    vector<int> misses(probes);
+    for (auto& id : misses) id = static_cast<int>(generator() & 0x3FFFFFFE);
+
+    size_t found = 0;
+    start = chrono::steady_clock::now();
+    for (int id : misses) found += find(ids.begin(), ids.end(), id) != ids.end();
+    double scanSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int id : misses) {
+        if (!filter.mightContain(static_cast<uint64_t>(id))) continue;
+        if (find(ids.begin(), ids.end(), id) == ids.end()) filter.reportFalsePositive();
+        else found++;
+    }
+    double filteredSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "\n" << items << " IDs, filter built in " << buildSeconds * 1000 << " ms ("
+         << filter.memoryUsage() << " bytes, " << static_cast<double>(filter.memoryUsage()) * 8 / max<size_t>(items, 1)
+         << " bits per ID)\n";
+    cout << probes << " lookups of absent IDs:\n";
+    cout << "  linear scan:        " << scanSeconds * 1e6 / probes << " us per lookup\n";
+    cout << "  filter, then scan:  " << filteredSeconds * 1e6 / probes << " us per lookup ("
+         << scanSeconds / max(filteredSeconds, 1e-9) << "x faster)\n";
+    cout << "\n" << left << setw(12) << "Filter" << right << setw(10) << "Keys" << setw(12) << "Bytes"
+         << setw(10) << "Lookups" << setw(10) << "Rejected" << setw(10) << "False+" << setw(11) << "Observed"
+         << setw(10) << "Target" << "\n";
+    filter.displayRow("benchmark");
+    cout << right;
+    if (found) cout << "WARNING: " << found << " absent IDs were found!\n";
+}
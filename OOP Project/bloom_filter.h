@@ -0,0 +1,66 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For string keys and labels
+#include <vector>   // For bit storage
+#include <cstdint>  // For fixed-width types
+using namespace std;
+
+// Scalable Bloom filter answering "definitely absent" without touching storage.
+// Keys are added on insert and never removed. Once a layer holds its capacity a
+// new layer twice as large with half the error rate is started, so the overall
+// false-positive rate stays below the configured target however many keys arrive.
+class BloomFilter {
+private:
+    struct Layer {
+        vector<uint64_t> bits;  // Bit array
+        uint64_t bitCount = 0;  // Usable bits
+        int hashes = 0;         // Probes per key
+        size_t capacity = 0;    // Keys before the next layer is started
+        size_t items = 0;       // Keys added to this layer
+    };
+
+    vector<Layer> layers;            // Oldest (smallest) first
+    double falsePositiveRate;        // Target for the whole filter
+    size_t initialCapacity;          // Keys in the first layer
+
+    // Statistics
+    mutable size_t lookups = 0;   // Membership tests
+    mutable size_t rejected = 0;  // Tests answered "absent"
+    size_t falsePositives = 0;    // "Maybe" answers the caller found to be wrong
+
+    // Starts a new layer sized for the next doubling of keys
+    void addLayer();
+
+public:
+    // Target false-positive rate (e.g. 0.01) and keys expected before the first growth
+    explicit BloomFilter(double falsePositiveRate = 0.01, size_t expectedItems = 1024);
+
+    // Adds a key
+    void add(uint64_t key);
+    void add(const string& key);
+
+    // False means the key was never added; true means it probably was
+    bool mightContain(uint64_t key) const;
+    bool mightContain(const string& key) const;
+
+    // Records that a "maybe" answer turned out to be absent
+    void reportFalsePositive();
+
+    // Removes every key (keeps the configured rate)
+    void clear();
+
+    // Accessor methods
+    size_t itemCount() const;
+    double getFalsePositiveRate() const;
+    double observedFalsePositiveRate() const;  // Over lookups of absent keys
+    size_t lookupCount() const;
+    size_t rejectedCount() const;
+    size_t memoryUsage() const;
+
+    // Prints one report line
+    void displayRow(const string& label) const;
+};
+
+// Compares linear-scan misses with and without a filter on generated IDs
+void runBloomFilterBenchmark(size_t items, double falsePositiveRate);
@@ -0,0 +1,315 @@
+#include "checkpoint.h"   // Checkpoint store declarations
+#include "compression.h"  // For file compression
+#include "varint.h"       // For record framing
+#include <iostream>       // For reports
+#include <iomanip>        // For formatted figures
+#include <fstream>        // For checkpoint files
+#include <filesystem>     // For directory management
+#include <chrono>         // For checkpoint timing
+#include <algorithm>      // For sorting generations
+#include <cstdlib>        // For strtoul
+#include <cstring>        // For memcmp
+
+namespace fs = std::filesystem;
+
+// Every checkpoint starts with this tag and format version, so stray or truncated files are rejected
+static const char CHECKPOINT_MAGIC[4] = { 'H', 'C', 'K', 'P' };
+static const uint8_t CHECKPOINT_VERSION = 3;  // 2: statuses stored as codes; 3: dates packed
+
+// ========== HELPERS ========== //
+
+// 32-bit FNV-1a checksum of the uncompressed records
+static uint32_t recordChecksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Appends one record as [table][varint slot][length-prefixed state]
+static void encodeRecord(vector<uint8_t>& raw, uint8_t table, uint32_t slot, const vector<uint8_t>& state) {
+    raw.push_back(table);
+    writeVarint(raw, slot);
+    writeVarint(raw, state.size());
+    raw.insert(raw.end(), state.begin(), state.end());
+}
+
+// Combined image key of a record
+static uint64_t imageKey(uint8_t table, uint32_t slot) { return (static_cast<uint64_t>(table) << 32) | slot; }
+
+// ========== CHECKPOINT STORE IMPLEMENTATION ========== //
+
+// File name of a base or delta
+string CheckpointStore::pathOf(uint32_t generation, bool base) const {
+    return directory + "/checkpoint_" + to_string(generation) + (base ? ".base" : ".delta");
+}
+
+// Opens the directory; the newest base and the deltas after it are current,
+// anything older is left over from an interrupted compaction and is removed
+bool CheckpointStore::open(const string& directoryPath) {
+    close();
+    error_code error;
+    fs::create_directories(directoryPath, error);
+    if (!fs::is_directory(directoryPath, error)) return false;
+    directory = directoryPath;
+    active = true;
+    baseGeneration = 0;
+    deltas.clear();
+    nextGeneration = 1;
+    baseWrites = deltaWrites = compactions = 0;
+    recordsWritten = 0;
+    bytesWritten = compactionBytes = 0;
+    lastRecords = 0;
+    lastBytes = 0;
+    lastSeconds = 0;
+
+    vector<uint32_t> bases, found;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        string name = it->path().filename().string();
+        if (name.rfind("checkpoint_", 0) != 0) continue;
+        string extension = it->path().extension().string();
+        if (extension != ".base" && extension != ".delta") continue;
+        uint32_t generation = static_cast<uint32_t>(strtoul(name.c_str() + 11, nullptr, 10));
+        if (!generation) continue;
+        (extension == ".base" ? bases : found).push_back(generation);
+        nextGeneration = max(nextGeneration, generation + 1);
+    }
+    if (!bases.empty()) baseGeneration = *max_element(bases.begin(), bases.end());
+    for (uint32_t generation : bases) {
+        if (generation != baseGeneration) fs::remove(pathOf(generation, true), error);
+    }
+    sort(found.begin(), found.end());
+    for (uint32_t generation : found) {
+        if (generation > baseGeneration) deltas.push_back(generation);
+        else fs::remove(pathOf(generation, false), error);
+    }
+    return true;
+}
+
+// Stops using the directory (files are kept)
+void CheckpointStore::close() {
+    active = false;
+    baseGeneration = 0;
+    deltas.clear();
+}
+
+// Deletes every checkpoint file, keeping the directory open
+void CheckpointStore::reset() {
+    if (!active) return;
+    error_code error;
+    if (baseGeneration) fs::remove(pathOf(baseGeneration, true), error);
+    for (uint32_t generation : deltas) fs::remove(pathOf(generation, false), error);
+    baseGeneration = 0;
+    deltas.clear();
+}
+
+// Writes [magic][version][varint count][varint raw length][checksum][compressed records]
+// to a temporary file, then renames it into place
+uint64_t CheckpointStore::writeFile(uint32_t generation, bool base, const vector<uint8_t>& raw, size_t count) {
+    vector<uint8_t> bytes(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof(CHECKPOINT_MAGIC));
+    bytes.push_back(CHECKPOINT_VERSION);
+    writeVarint(bytes, count);
+    writeVarint(bytes, raw.size());
+    uint32_t checksum = recordChecksum(raw.data(), raw.size());
+    for (int i = 0; i < 4; i++) bytes.push_back(static_cast<uint8_t>(checksum >> (8 * i)));
+    lzCompress(reinterpret_cast<const char*>(raw.data()), raw.size(), bytes);
+
+    string path = pathOf(generation, base);
+    {
+        ofstream file(path + ".tmp", ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+        file.close();
+        if (!file) return 0;
+    }
+    error_code error;
+    fs::rename(path + ".tmp", path, error);
+    return error ? 0 : bytes.size();
+}
+
+// Decompresses one file, checks it and applies its records to the image
+bool CheckpointStore::readFile(uint32_t generation, bool base, CheckpointImage& image, uint64_t& fileBytes) const {
+    ifstream file(pathOf(generation, base), ios::binary | ios::ate);
+    if (!file) return false;
+    vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+    if (!file || bytes.size() < sizeof(CHECKPOINT_MAGIC) + 1 ||
+        memcmp(bytes.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+        bytes[sizeof(CHECKPOINT_MAGIC)] != CHECKPOINT_VERSION) {
+        return false;
+    }
+    fileBytes += bytes.size();
+
+    size_t pos = sizeof(CHECKPOINT_MAGIC) + 1;
+    size_t count = static_cast<size_t>(readVarint(bytes, pos));
+    size_t rawSize = static_cast<size_t>(readVarint(bytes, pos));
+    if (pos + 4 > bytes.size()) return false;
+    uint32_t stored = 0;
+    for (int i = 0; i < 4; i++) stored |= static_cast<uint32_t>(bytes[pos++]) << (8 * i);
+    string raw;
+    raw.reserve(rawSize);
+    if (!lzDecompress(bytes.data() + pos, bytes.size() - pos, raw) || raw.size() != rawSize ||
+        recordChecksum(reinterpret_cast<const uint8_t*>(raw.data()), raw.size()) != stored) {
+        return false;
+    }
+
+    vector<uint8_t> records(raw.begin(), raw.end());
+    pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t table = records[pos++];
+        uint32_t slot = static_cast<uint32_t>(readVarint(records, pos));
+        size_t length = static_cast<size_t>(readVarint(records, pos));
+        image[imageKey(table, slot)].assign(records.begin() + static_cast<ptrdiff_t>(pos),
+                                           records.begin() + static_cast<ptrdiff_t>(pos + length));
+        pos += length;
+    }
+    return true;
+}
+
+// Writes a base holding the image and drops every older file
+bool CheckpointStore::replaceBase(const CheckpointImage& image, uint64_t& fileBytes) {
+    vector<uint8_t> raw;
+    for (const auto& entry : image) {
+        encodeRecord(raw, static_cast<uint8_t>(entry.first >> 32), static_cast<uint32_t>(entry.first), entry.second);
+    }
+    uint32_t generation = nextGeneration++;
+    fileBytes = writeFile(generation, true, raw, image.size());
+    if (!fileBytes) return false;
+    uint32_t oldBase = baseGeneration;
+    vector<uint32_t> oldDeltas;
+    oldDeltas.swap(deltas);
+    baseGeneration = generation;
+    error_code error;  // The new base is in place, so the old files can go
+    if (oldBase) fs::remove(pathOf(oldBase, true), error);
+    for (uint32_t old : oldDeltas) fs::remove(pathOf(old, false), error);
+    return true;
+}
+
+// Writes every object as a new base
+bool CheckpointStore::writeBase(const vector<CheckpointRecord>& records) {
+    if (!active) return false;
+    auto start = chrono::steady_clock::now();
+    CheckpointImage image;
+    for (const auto& record : records) image[imageKey(record.table, record.slot)] = record.state;
+    uint64_t fileBytes = 0;
+    if (!replaceBase(image, fileBytes)) return false;
+    baseWrites++;
+    recordsWritten += records.size();
+    bytesWritten += fileBytes;
+    lastRecords = records.size();
+    lastBytes = fileBytes;
+    lastSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// Writes changed objects as a delta (a base is written instead if there is none yet)
+bool CheckpointStore::writeDelta(const vector<CheckpointRecord>& records) {
+    if (!active) return false;
+    if (!baseGeneration) return writeBase(records);
+    auto start = chrono::steady_clock::now();
+    vector<uint8_t> raw;
+    for (const auto& record : records) encodeRecord(raw, record.table, record.slot, record.state);
+    uint32_t generation = nextGeneration++;
+    uint64_t fileBytes = writeFile(generation, false, raw, records.size());
+    if (!fileBytes) return false;
+    deltas.push_back(generation);
+    deltaWrites++;
+    recordsWritten += records.size();
+    bytesWritten += fileBytes;
+    lastRecords = records.size();
+    lastBytes = fileBytes;
+    lastSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// Merges the base and every delta in order
+bool CheckpointStore::load(CheckpointImage& image) const {
+    if (!active || !baseGeneration) return false;
+    uint64_t fileBytes = 0;
+    if (!readFile(baseGeneration, true, image, fileBytes)) return false;
+    for (uint32_t generation : deltas) {
+        if (!readFile(generation, false, image, fileBytes)) return false;
+    }
+    return true;
+}
+
+// Merges the deltas into a new base
+bool CheckpointStore::compact() {
+    if (!active || !baseGeneration) return false;
+    if (deltas.empty()) return true;  // Already a single file
+    CheckpointImage image;
+    uint64_t readBytes = 0, writtenBytes = 0;
+    if (!readFile(baseGeneration, true, image, readBytes)) return false;
+    for (uint32_t generation : deltas) {
+        if (!readFile(generation, false, image, readBytes)) return false;
+    }
+    if (!replaceBase(image, writtenBytes)) return false;
+    compactions++;
+    compactionBytes += readBytes + writtenBytes;
+    return true;
+}
+
+// True between open and close
+bool CheckpointStore::isOpen() const { return active; }
+
+// True once a full checkpoint exists
+bool CheckpointStore::hasBase() const { return baseGeneration != 0; }
+
+// Folder holding the checkpoint files
+const string& CheckpointStore::getDirectory() const { return directory; }
+
+// Deltas written since the base
+size_t CheckpointStore::deltaCount() const { return deltas.size(); }
+
+// Bytes in the current base
+uint64_t CheckpointStore::baseBytesOnDisk() const {
+    if (!active || !baseGeneration) return 0;
+    error_code error;
+    uint64_t size = fs::file_size(pathOf(baseGeneration, true), error);
+    return error ? 0 : size;
+}
+
+// Bytes in the deltas after the base
+uint64_t CheckpointStore::deltaBytesOnDisk() const {
+    if (!active) return 0;
+    error_code error;
+    uint64_t total = 0;
+    for (uint32_t generation : deltas) {
+        uint64_t size = fs::file_size(pathOf(generation, false), error);
+        if (!error) total += size;
+    }
+    return total;
+}
+
+// Bytes in the current base and deltas
+uint64_t CheckpointStore::bytesOnDisk() const { return baseBytesOnDisk() + deltaBytesOnDisk(); }
+
+// Displays files, write counts and I/O figures
+void CheckpointStore::displayReport() const {
+    cout << "Directory:          " << directory << "/\n";
+    cout << "Files:              " << (baseGeneration ? 1 : 0) << " base + " << deltas.size() << " deltas ("
+         << bytesOnDisk() << " bytes)\n";
+    cout << "Written:            " << baseWrites << " full, " << deltaWrites << " delta; "
+         << recordsWritten << " objects, " << bytesWritten << " bytes\n";
+    cout << fixed << setprecision(2);
+    if (baseWrites + deltaWrites) {
+        cout << "Last checkpoint:    " << lastRecords << " objects, " << lastBytes << " bytes in "
+             << lastSeconds * 1000 << " ms\n";
+    }
+    cout << "Compactions:        " << compactions << " (" << compactionBytes << " bytes read and written)\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Objects in the last checkpoint
+size_t CheckpointStore::lastRecordCount() const { return lastRecords; }
+
+// File bytes of the last checkpoint
+uint64_t CheckpointStore::lastByteCount() const { return lastBytes; }
+
+// Time taken by the last checkpoint
+double CheckpointStore::lastDuration() const { return lastSeconds; }
+
+uint64_t CheckpointStore::compactionByteCount() const { return compactionBytes; }
@@ -0,0 +1,103 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For directory and file names
+#include <vector>   // For encoded records
+#include <map>      // For merged images
+#include <cstdint>  // For fixed-width types
+using namespace std;
+
+// One saved object: the table it belongs to, its position in that table and
+// its encoded state
+struct CheckpointRecord {
+    uint8_t table;          // Kind of object (chosen by the caller)
+    uint32_t slot;          // Position within the table
+    vector<uint8_t> state;  // Encoded object
+};
+
+// Merged checkpoint contents keyed by (table << 32 | slot), so iteration
+// visits tables in order and each table in slot order
+typedef map<uint64_t, vector<uint8_t>> CheckpointImage;
+
+// Directory of checkpoint files: one base holding every object, followed by
+// deltas holding only objects changed since the previous file. Loading applies
+// the base and then each delta in order (later states replace earlier ones).
+// Compaction merges them into a new base. Files are written under a temporary
+// name and renamed, so a crash never leaves a half-written checkpoint behind.
+class CheckpointStore {
+private:
+    string directory;               // Folder holding the checkpoint files
+    bool active = false;            // True between open and close
+    uint32_t baseGeneration = 0;    // Current base file (0 = none)
+    vector<uint32_t> deltas;        // Delta files after the base, oldest first
+    uint32_t nextGeneration = 1;    // Number of the next file written
+
+    // Statistics since opening
+    size_t baseWrites = 0;          // Full checkpoints written
+    size_t deltaWrites = 0;         // Delta checkpoints written
+    size_t compactions = 0;         // Bases produced by merging deltas
+    size_t recordsWritten = 0;      // Objects written by checkpoints
+    uint64_t bytesWritten = 0;      // File bytes written by checkpoints
+    uint64_t compactionBytes = 0;   // File bytes read and written by compaction
+    size_t lastRecords = 0;         // Objects in the last checkpoint
+    uint64_t lastBytes = 0;         // File bytes of the last checkpoint
+    double lastSeconds = 0;         // Time taken by the last checkpoint
+
+    // File name of a base or delta
+    string pathOf(uint32_t generation, bool base) const;
+
+    // Writes encoded records as one file; returns its size (0 on failure)
+    uint64_t writeFile(uint32_t generation, bool base, const vector<uint8_t>& raw, size_t count);
+
+    // Applies one file's records to an image; returns false if it is missing or damaged
+    bool readFile(uint32_t generation, bool base, CheckpointImage& image, uint64_t& fileBytes) const;
+
+    // Writes a base holding the image and drops every older file
+    bool replaceBase(const CheckpointImage& image, uint64_t& fileBytes);
+
+public:
+    CheckpointStore() = default;
+    CheckpointStore(const CheckpointStore&) = delete;             // Owns its files
+    CheckpointStore& operator=(const CheckpointStore&) = delete;
+
+    // Opens a directory (creating it if needed) and finds the checkpoints already there
+    bool open(const string& directoryPath);
+
+    // Stops using the directory (files are kept)
+    void close();
+
+    // Deletes every checkpoint file in the directory
+    void reset();
+
+    // Writes every object as a new base, replacing older files
+    bool writeBase(const vector<CheckpointRecord>& records);
+
+    // Writes changed objects as a delta after the current base
+    bool writeDelta(const vector<CheckpointRecord>& records);
+
+    // Merges the base and every delta; returns false if none exists or a file is damaged
+    bool load(CheckpointImage& image) const;
+
+    // Merges the deltas into a new base
+    bool compact();
+
+    // Accessor methods
+    bool isOpen() const;
+    bool hasBase() const;
+    const string& getDirectory() const;
+    size_t deltaCount() const;
+    uint64_t baseBytesOnDisk() const;
+    uint64_t deltaBytesOnDisk() const;
+    uint64_t bytesOnDisk() const;
+
+    // Displays files, write counts and I/O figures
+    void displayReport() const;
+
+    // Figures for the most recent checkpoint
+    size_t lastRecordCount() const;
+    uint64_t lastByteCount() const;
+    double lastDuration() const;
+
+    // File bytes read and written by every compaction since opening
+    uint64_t compactionByteCount() const;
+};
@@ -0,0 +1,187 @@
+#include "hospital.h"  // Includes the main hospital system header
+#include "workload.h"  // For generated patients and a quiet console
+#include <iomanip>     // For formatted figures
+#include <chrono>      // For compaction and restore timing
+#include <filesystem>  // For removing the benchmark directory
+#include <algorithm>   // For max
+
+// ========== BENCHMARK ========== //
+
+// Sums that must survive a save and restore unchanged
+struct CheckpointTotals {
+    long long stock = 0;      // Units over all medicines
+    double billed = 0;        // Total of all bills
+    size_t records = 0;       // Medical records over all patients
+    size_t conditions = 0;    // Known conditions over all patients
+    size_t contactHash = 0;   // Hash of every patient's contact number
+};
+
+// Reads the totals through the public lookups
+static CheckpointTotals totalsOf(HospitalSystem& hospital, size_t patients, const vector<int>& medicineIds) {
+    CheckpointTotals totals;
+    for (int id : medicineIds) {
+        Medicine* medicine;
+        hospital.findMedicine(id, medicine);
+        if (medicine) totals.stock += medicine->getQuantity();
+    }
+    for (size_t i = 0; i < patients; i++) {
+        int id = 100000 + static_cast<int>(i);
+        Patient* patient;
+        hospital.findPatient(id, patient);
+        Billing* bill;
+        hospital.findPatientBill(id, bill);
+        if (bill) totals.billed += bill->getTotalAmount();
+        if (!patient) continue;
+        totals.records += patient->getMedicalRecords().size();
+        totals.conditions += patient->getDiseases().size();
+        totals.contactHash = totals.contactHash * 31 + hash<string_view>()(patient->getContactNumber());
+    }
+    return totals;
+}
+
+// Builds a hospital, saves a full base, then alternates a burst of typical
+// changes with a delta save. Compares the I/O with saving everything each time,
+// then restores the result into a new system and checks it.
+void runCheckpointBenchmark(size_t patients, size_t changesPerSave, size_t saves) {
+    const string directory = "checkpoint_benchmark";
+    const int doctors = 20, medicineCount = 50, roomCount = 100;
+    static const char* diagnoses[] = { "Hypertension", "Type 2 diabetes", "Asthma", "Migraine" };
+    static const char* plans[] = { "Lifestyle advice and review in three months",
+                                   "Start metformin 500mg twice daily, recheck HbA1c",
+                                   "Inhaled corticosteroid, spacer technique reviewed" };
+    PopulationBuilder people(2024);
+    auto pick = [&people](size_t n) { return people.pick(n); };
+    patients = max<size_t>(patients, 1);
+
+    cout << "\nGenerating " << patients << " patients with appointments, records and bills...\n";
+    HospitalSystem hospital;
+    vector<int> medicineIds;
+    vector<Billing*> bills;
+    {
+        ConsoleSilencer quiet;
+        people.addDoctors(hospital, doctors);
+        for (Medicine* medicine : people.addMedicines(hospital, medicineCount, 100000)) {
+            medicineIds.push_back(medicine->getId());
+        }
+        for (int i = 0; i < roomCount; i++) hospital.addRoom(hospital.newRoom(i % 10 ? "General" : "ICU"));
+        for (size_t i = 0; i < patients; i++) {
+            int id = 100000 + static_cast<int>(i);
+            Patient* patient = hospital.newPatient(people.patient(id, 1));
+            hospital.addPatient(patient);
+            int doctorId = 1 + static_cast<int>(pick(doctors));
+            hospital.scheduleAppointment(patient, doctorId, "01/0" + to_string(1 + pick(9)) + "/2025 10:00");
+            hospital.addMedicalRecord(patient, doctorId, diagnoses[pick(4)], plans[pick(3)]);
+            Billing* bill;
+            hospital.createBill(id, bill);
+            hospital.addServiceToBill(bill, "Registration", 20);
+            bills.push_back(bill);
+        }
+    }
+
+    if (!hospital.enableCheckpoints(directory, 1000000)) {  // Saves below are explicit
+        cout << "Error: could not create the checkpoint directory.\n";
+        return;
+    }
+    const CheckpointStore& store = hospital.getCheckpointStore();
+    auto start = chrono::steady_clock::now();
+    size_t fullRecords = store.lastRecordCount();
+    uint64_t fullBytes = store.lastByteCount();
+    double fullSeconds = store.lastDuration();
+
+    // Typical activity between saves touches a small share of the objects
+    uint64_t deltaBytes = 0;
+    size_t deltaRecords = 0;
+    double deltaSeconds = 0;
+    for (size_t s = 0; s < saves; s++) {
+        ConsoleSilencer quiet;
+        for (size_t c = 0; c < changesPerSave; c++) {
+            Patient* patient;
+            hospital.findPatient(100000 + static_cast<int>(pick(patients)), patient);
+            switch (pick(6)) {
+                case 0: {
+                    Medicine* medicine;
+                    hospital.findMedicine(medicineIds[pick(medicineIds.size())], medicine);
+                    hospital.updateStock(medicine, static_cast<int>(pick(20)) - 10);
+                    break;
+                }
+                case 1:
+                    hospital.addServiceToBill(bills[pick(bills.size())], "Consultation", 25.0 + pick(100));
+                    break;
+                case 2:
+                    hospital.updateContactInfo(patient, people.address(), people.phone());
+                    break;
+                case 3:
+                    hospital.addDisease(patient, diagnoses[pick(4)]);
+                    break;
+                case 4:
+                    hospital.addMedicalRecord(patient, 1 + static_cast<int>(pick(doctors)), diagnoses[pick(4)],
+                                              plans[pick(3)]);
+                    break;
+                default: {
+                    Doctor* doctor;
+                    hospital.findDoctor(1 + static_cast<int>(pick(doctors)), doctor);
+                    hospital.addAvailableSlot(doctor, "Monday " + to_string(8 + pick(9)) + ":00");
+                    break;
+                }
+            }
+        }
+        quiet.restore();
+        if (!hospital.saveCheckpoint()) {
+            cout << "Error: checkpoint " << s + 1 << " could not be written.\n";
+            return;
+        }
+        // Compaction leaves the figures of the delta it followed
+        deltaBytes += store.lastByteCount();
+        deltaRecords += store.lastRecordCount();
+        deltaSeconds += store.lastDuration();
+    }
+    uint64_t compactionIo = store.compactionByteCount();  // Merges triggered by the saves themselves
+    uint64_t filesBeforeCompaction = store.bytesOnDisk();
+    start = chrono::steady_clock::now();
+    hospital.compactCheckpoints();
+    double compactSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    CheckpointTotals expected = totalsOf(hospital, patients, medicineIds);
+
+    // The same saves written in full each time (measured once more at the end)
+    hospital.saveCheckpoint(true);
+    fullRecords = (fullRecords + store.lastRecordCount()) / 2;
+    fullBytes = (fullBytes + store.lastByteCount()) / 2;
+    fullSeconds = (fullSeconds + store.lastDuration()) / 2;
+
+    HospitalSystem restored;
+    ConsoleSilencer quiet;
+    start = chrono::steady_clock::now();
+    bool ok = restored.restoreCheckpoint(directory, 1000000);
+    double restoreSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    quiet.restore();
+    CheckpointTotals actual = ok ? totalsOf(restored, patients, medicineIds) : CheckpointTotals();
+    restored.disableCheckpoints();
+
+    size_t n = max<size_t>(saves, 1);
+    uint64_t fullIo = fullBytes * saves;
+    uint64_t deltaIo = deltaBytes + compactionIo;
+    cout << fixed << setprecision(2);
+    cout << "\nFull checkpoint:   " << fullRecords << " objects, " << fullBytes << " bytes, "
+         << fullSeconds * 1000 << " ms\n";
+    cout << "Delta checkpoint:  " << deltaRecords / n << " objects, " << deltaBytes / n << " bytes, "
+         << deltaSeconds * 1000 / n << " ms (average after " << changesPerSave << " changes)\n";
+    cout << "Total I/O:         " << saves << " saves write " << fullIo << " bytes in full vs " << deltaIo
+         << " as deltas and their compactions (" << static_cast<double>(fullIo) / max<uint64_t>(deltaIo, 1)
+         << "x less)\n";
+    cout << "Final compaction:  " << filesBeforeCompaction << " bytes of files merged into "
+         << store.baseBytesOnDisk() << " in " << compactSeconds * 1000 << " ms\n";
+    cout << "Restore:           " << restoreSeconds * 1000 << " ms\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+    if (!ok || actual.stock != expected.stock || actual.billed != expected.billed ||
+        actual.records != expected.records || actual.conditions != expected.conditions ||
+        actual.contactHash != expected.contactHash) {
+        cout << "WARNING: the restored system does not match the saved one!\n";
+    } else {
+        cout << "Restored system matches (stock, bills, records, conditions, contacts).\n";
+    }
+
+    hospital.disableCheckpoints();
+    error_code error;
+    filesystem::remove_all(directory, error);
+}
@@ -0,0 +1,163 @@
+#include "cold_text.h"   // Cold text store declarations
+#include "compression.h" // For block codec
+#include "memory.h"      // For footprint helpers
+#include <iostream>      // For reports
+#include <iomanip>       // For formatted figures
+#include <chrono>        // For access latency
+#include <random>        // For generated notes
+
+// ========== COLD TEXT STORE IMPLEMENTATION ========== //
+
+// Stores a blob and returns its location
+ColdTextRef ColdTextStore::store(const string& blob) {
+    if (openIndex != UINT32_MAX && openBlock.size() + blob.size() > BLOCK_SIZE) seal();
+    if (openIndex == UINT32_MAX) {
+        openIndex = static_cast<uint32_t>(blocks.size());
+        blocks.emplace_back();
+    }
+    ColdTextRef ref;
+    ref.block = openIndex;
+    ref.offset = static_cast<uint32_t>(openBlock.size());
+    ref.length = static_cast<uint32_t>(blob.size());
+    openBlock += blob;
+    blocks[openIndex].liveBytes += ref.length;
+    return ref;
+}
+
+// Compresses the partially filled block
+void ColdTextStore::seal() {
+    if (openIndex == UINT32_MAX) return;
+    Block& block = blocks[openIndex];
+    block.rawSize = static_cast<uint32_t>(openBlock.size());
+    if (block.liveBytes > 0) {
+        lzCompress(openBlock.data(), openBlock.size(), block.compressed);
+        block.compressed.shrink_to_fit();
+    }
+    string().swap(openBlock);  // Releases the raw bytes
+    openIndex = UINT32_MAX;
+}
+
+// Returns the uncompressed contents of a sealed block, decompressing on a cache miss
+const string& ColdTextStore::blockContents(uint32_t index) const {
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        if (it->first != index) continue;
+        cacheHits++;
+        cache.splice(cache.begin(), cache, it);  // Most recently used first
+        return cache.front().second;
+    }
+    const Block& block = blocks[index];
+    string contents;
+    contents.reserve(block.rawSize);
+    lzDecompress(block.compressed.data(), block.compressed.size(), contents);
+    cache.emplace_front(index, move(contents));
+    if (cache.size() > CACHE_BLOCKS) cache.pop_back();
+    return cache.front().second;
+}
+
+// Reads a blob back
+string ColdTextStore::load(const ColdTextRef& ref) const {
+    auto start = chrono::steady_clock::now();
+    string blob = ref.block == openIndex ? openBlock.substr(ref.offset, ref.length)
+                                         : blockContents(ref.block).substr(ref.offset, ref.length);
+    reads++;
+    readSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return blob;
+}
+
+// Marks a blob as thawed; frees the block once nothing in it is live
+void ColdTextStore::release(const ColdTextRef& ref) {
+    if (!ref.isValid() || ref.block >= blocks.size()) return;
+    Block& block = blocks[ref.block];
+    block.liveBytes -= ref.length < block.liveBytes ? ref.length : block.liveBytes;
+    if (block.liveBytes > 0 || ref.block == openIndex) return;
+    vector<uint8_t>().swap(block.compressed);
+    cache.remove_if([&](const pair<uint32_t, string>& entry) { return entry.first == ref.block; });
+}
+
+// Uncompressed bytes still stored
+size_t ColdTextStore::liveBytes() const {
+    size_t total = 0;
+    for (const auto& block : blocks) total += block.liveBytes;
+    return total;
+}
+
+// Resident bytes of sealed blocks
+size_t ColdTextStore::compressedBytes() const {
+    size_t total = 0;
+    for (const auto& block : blocks) total += block.compressed.capacity();
+    return total;
+}
+
+// All heap bytes used by the store
+size_t ColdTextStore::memoryUsage() const {
+    size_t bytes = vectorBufferBytes(blocks) + compressedBytes() + stringHeapBytes(openBlock);
+    for (const auto& entry : cache) bytes += sizeof(entry) + 2 * sizeof(void*) + stringHeapBytes(entry.second);
+    return bytes;
+}
+
+// Displays compression ratio and access latency
+void ColdTextStore::displayReport() const {
+    size_t live = liveBytes();
+    size_t resident = memoryUsage();
+    cout << "\n=== COLD CLINICAL TEXT ===\n";
+    cout << "Text stored:        " << live << " bytes\n";
+    cout << "Resident (store):   " << resident << " bytes";
+    if (resident) cout << " (" << fixed << setprecision(2) << static_cast<double>(live) / resident << "x)";
+    cout << "\n";
+    cout << "Blocks:             " << blocks.size() << " (" << CACHE_BLOCKS << " cached decompressed)\n";
+    cout << "Reads:              " << reads << " (" << cacheHits << " served from cache)\n";
+    if (reads) {
+        cout << "Average access:     " << fixed << setprecision(2) << readSeconds * 1e6 / reads << " us\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// ========== BENCHMARK ========== //
+
+// Compresses generated clinical notes and reports memory reduction and read latency
+void runColdTextBenchmark(size_t records) {
+    static const char* findings[] = { "Patient reports mild chest pain radiating to the left arm. ",
+                                      "Blood pressure ", "Heart rate ", "Temperature ", "Chest X-ray shows ",
+                                      "no acute abnormality. ", "consolidation in the right lower lobe. ",
+                                      "Continue current medication. ", "Follow up in ", "Prescribed ",
+                                      "amoxicillin ", "paracetamol ", "metformin ", "twice daily for ",
+                                      "Full blood count within normal limits. ", "HbA1c ", "Advised rest and fluids. " };
+    mt19937 generator(2024);
+    auto pick = [&generator](size_t n) { return static_cast<size_t>(generator() % n); };
+    cout << "\nGenerating clinical text for " << records << " records...\n";
+    vector<string> notes(records);
+    size_t heapBefore = 0, textBytes = 0;
+    for (auto& note : notes) {
+        size_t sentences = 4 + pick(10);
+        for (size_t s = 0; s < sentences; s++) {
+            note += findings[pick(17)];
+            if (pick(3) == 0) note += to_string(60 + pick(120)) + (pick(2) ? "/" + to_string(40 + pick(60)) : "") + ". ";
+            if (pick(4) == 0) note += to_string(1 + pick(14)) + " days. ";
+        }
+        heapBefore += stringHeapBytes(note);
+        textBytes += note.size();
+    }
+
+    ColdTextStore store;
+    vector<ColdTextRef> refs;
+    refs.reserve(records);
+    auto start = chrono::steady_clock::now();
+    for (const auto& note : notes) refs.push_back(store.store(note));
+    store.seal();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t heapAfter = store.memoryUsage() + refs.size() * sizeof(ColdTextRef);
+    cout << "Text: " << textBytes << " bytes, resident before: " << heapBefore << " bytes, after: "
+         << heapAfter << " bytes (" << static_cast<double>(heapBefore) / heapAfter << "x smaller)\n";
+    cout << "Compressed at " << textBytes / seconds / 1e6 << " MB/s\n";
+
+    // Random reads miss the cache almost always; sequential reads mostly hit it
+    size_t mismatches = 0;
+    for (size_t i = 0; i < 2000 && records; i++) {
+        size_t row = pick(records);
+        mismatches += store.load(refs[row]) != notes[row];
+    }
+    for (size_t i = 0; i < 2000 && i < records; i++) mismatches += store.load(refs[i]) != notes[i];
+    store.displayReport();
+    if (mismatches) cout << "WARNING: " << mismatches << " blobs did not round-trip!\n";
+}
@@ -0,0 +1,70 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For text blobs
+#include <vector>   // For block storage
+#include <list>     // For decompressed block cache
+#include <cstdint>  // For fixed-width types
+using namespace std;
+
+// Location of one compressed text blob
+struct ColdTextRef {
+    uint32_t block = UINT32_MAX;  // Block holding the blob
+    uint32_t offset = 0;          // Offset inside the uncompressed block
+    uint32_t length = 0;          // Blob length in bytes
+
+    bool isValid() const { return block != UINT32_MAX; }
+};
+
+// Block-compressed storage for clinical text that has not been used recently.
+// Blobs are packed into 64 KB blocks, so repeated phrases across many records
+// compress together; a block is decompressed whole on access and the most
+// recently used blocks stay cached.
+class ColdTextStore {
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;  // Uncompressed bytes per block
+    static const size_t CACHE_BLOCKS = 4;        // Decompressed blocks kept
+
+    struct Block {
+        vector<uint8_t> compressed;  // Sealed contents (empty while open or once dead)
+        uint32_t rawSize = 0;        // Uncompressed size
+        uint32_t liveBytes = 0;      // Bytes of blobs not yet thawed
+    };
+
+    vector<Block> blocks;                      // All blocks, index = ColdTextRef::block
+    string openBlock;                          // Uncompressed bytes of the block being filled
+    uint32_t openIndex = UINT32_MAX;           // Index of the open block
+    mutable list<pair<uint32_t, string>> cache; // Decompressed blocks, most recent first
+
+    // Access statistics
+    mutable size_t reads = 0;          // Blobs read
+    mutable size_t cacheHits = 0;      // Reads served without decompressing
+    mutable double readSeconds = 0;    // Total read latency
+
+    // Returns the uncompressed contents of a sealed block
+    const string& blockContents(uint32_t index) const;
+
+public:
+    // Stores a blob and returns its location
+    ColdTextRef store(const string& blob);
+
+    // Compresses the partially filled block
+    void seal();
+
+    // Reads a blob back
+    string load(const ColdTextRef& ref) const;
+
+    // Marks a blob as no longer stored (it was thawed); frees blocks once empty
+    void release(const ColdTextRef& ref);
+
+    // Accessor methods
+    size_t liveBytes() const;        // Uncompressed bytes still stored
+    size_t compressedBytes() const;  // Resident bytes of sealed blocks
+    size_t memoryUsage() const;      // All heap bytes, including cache and open block
+
+    // Displays compression ratio and access latency
+    void displayReport() const;
+};
+
+// Compresses generated clinical notes and reports memory reduction and read latency
+void runColdTextBenchmark(size_t records);
@@ -0,0 +1,193 @@
+#include "columnar.h"  // Columnar store declarations
+#include "hospital.h"  // For Patient accessors
+#include "memory.h"    // For footprint helpers
+#include "simd_filter.h" // For vectorised predicate kernels
+#include <cstdio>        // For sscanf
+
+// Converts "DD/MM/YYYY" to YYYYMMDD
+int dateToKey(const string& date) {
+    int day = 0, month = 0, year = 0;
+    if (sscanf(date.c_str(), "%d/%d/%d", &day, &month, &year) != 3) return 0;
+    return year * 10000 + month * 100 + day;
+}
+
+// Narrows a selection to rows whose value is in [lo, hi]
+static void selectRange(SelectionBitmap& selection, SelectionBitmap& scratch,
+                        const vector<int32_t>& column, int32_t lo, int32_t hi) {
+    filterRangeI32(column.data(), column.size(), lo, hi, scratch.data());
+    bitmapAnd(selection.data(), scratch.data(), selection.size());
+}
+
+// Narrows a selection to rows whose code equals code
+static void selectEquals(SelectionBitmap& selection, SelectionBitmap& scratch,
+                         const vector<uint16_t>& column, uint16_t code) {
+    filterEqualsU16(column.data(), column.size(), code, scratch.data());
+    bitmapAnd(selection.data(), scratch.data(), selection.size());
+}
+
+// Converts an optional bound (-1 = none) to a kernel bound
+static int32_t lowerBound(int value) { return value < 0 ? INT32_MIN : value; }
+static int32_t upperBound(int value) { return value < 0 ? INT32_MAX : value; }
+
+// ========== DICTIONARY IMPLEMENTATION ========== //
+
+// Returns code for value, adding it if new
+uint16_t Dictionary::encode(const string& value) {
+    auto it = codes.find(value);
+    if (it != codes.end()) return it->second;  // Already known
+    uint16_t code = static_cast<uint16_t>(values.size());
+    values.push_back(value);
+    codes[value] = code;
+    return code;
+}
+
+// Returns code for value, or -1 if unknown
+int Dictionary::lookup(const string& value) const {
+    auto it = codes.find(value);
+    return it == codes.end() ? -1 : it->second;
+}
+
+// Returns string for a code
+const string& Dictionary::decode(uint16_t code) const { return values[code]; }
+
+// Number of distinct values
+size_t Dictionary::size() const { return values.size(); }
+
+// Heap bytes used by the dictionary (strings stored twice: vector and map keys)
+size_t Dictionary::memoryUsage() const {
+    return 2 * stringVectorHeapBytes(values) + codes.bucket_count() * sizeof(void*) +
+           codes.size() * (sizeof(string) + sizeof(uint16_t) + sizeof(void*));
+}
+
+// ========== PATIENT COLUMNS IMPLEMENTATION ========== //
+
+// Adds a patient as a new row
+void PatientColumns::append(const Patient& patient) {
+    if (rowOf.count(patient.getId())) {  // Already mirrored, just refresh
+        update(patient);
+        return;
+    }
+    rowOf[patient.getId()] = ids.size();
+    ids.push_back(patient.getId());
+    ages.push_back(patient.getAge());
+    doctorIds.push_back(patient.getAssignedDoctorId());
+    genders.push_back(genderDict.encode(patient.getGender()));
+    bloodGroups.push_back(bloodGroupDict.encode(patient.getBloodGroup()));
+}
+
+// Rewrites the row of an existing patient
+void PatientColumns::update(const Patient& patient) {
+    auto it = rowOf.find(patient.getId());
+    if (it == rowOf.end()) return;  // Not mirrored
+    size_t row = it->second;
+    ages[row] = patient.getAge();
+    doctorIds[row] = patient.getAssignedDoctorId();
+    genders[row] = genderDict.encode(patient.getGender());
+    bloodGroups[row] = bloodGroupDict.encode(patient.getBloodGroup());
+}
+
+// Appends IDs of all patients matching the filter
+void PatientColumns::query(const PatientFilter& filter, vector<int>& matchingIds) const {
+    // Translate categorical criteria to codes once; unknown values match nothing
+    int bloodCode = -1, genderCode = -1;
+    if (!filter.bloodGroup.empty()) {
+        bloodCode = bloodGroupDict.lookup(filter.bloodGroup);
+        if (bloodCode < 0) return;
+    }
+    if (!filter.gender.empty()) {
+        genderCode = genderDict.lookup(filter.gender);
+        if (genderCode < 0) return;
+    }
+
+    // Start with every row selected, then intersect one predicate bitmap at a time
+    const size_t rows = ids.size();
+    SelectionBitmap selection(bitmapWords(rows), ~0ULL);
+    SelectionBitmap scratch(bitmapWords(rows));
+    if (filter.minAge >= 0 || filter.maxAge >= 0) {
+        selectRange(selection, scratch, ages, lowerBound(filter.minAge), upperBound(filter.maxAge));
+    }
+    if (filter.minId >= 0 || filter.maxId >= 0) {
+        selectRange(selection, scratch, ids, lowerBound(filter.minId), upperBound(filter.maxId));
+    }
+    if (filter.doctorId >= 0) {
+        selectRange(selection, scratch, doctorIds, filter.doctorId, filter.doctorId);
+    }
+    if (bloodCode >= 0) selectEquals(selection, scratch, bloodGroups, bloodCode);
+    if (genderCode >= 0) selectEquals(selection, scratch, genders, genderCode);
+    collectSelected(selection.data(), rows, ids.data(), matchingIds);
+}
+
+// Number of rows
+size_t PatientColumns::size() const { return ids.size(); }
+
+// Heap bytes used by all columns and dictionaries
+size_t PatientColumns::memoryUsage() const {
+    return vectorBufferBytes(ids) + vectorBufferBytes(ages) + vectorBufferBytes(doctorIds) +
+           vectorBufferBytes(genders) + vectorBufferBytes(bloodGroups) +
+           genderDict.memoryUsage() + bloodGroupDict.memoryUsage() +
+           rowOf.bucket_count() * sizeof(void*) + rowOf.size() * (sizeof(int) + sizeof(size_t) + sizeof(void*));
+}
+
+// ========== STAFF COLUMNS IMPLEMENTATION ========== //
+
+// Adds a staff member as a new row
+void StaffColumns::append(const Staff& staff) {
+    if (rowOf.count(staff.getId())) {  // Already mirrored, just refresh
+        update(staff);
+        return;
+    }
+    rowOf[staff.getId()] = ids.size();
+    ids.push_back(staff.getId());
+    ages.push_back(staff.getAge());
+    joinDates.push_back(dateToKey(staff.getJoinDate()));
+    departments.push_back(departmentDict.encode(staff.getDepartment()));
+    genders.push_back(genderDict.encode(staff.getGender()));
+}
+
+// Rewrites the row of an existing staff member
+void StaffColumns::update(const Staff& staff) {
+    auto it = rowOf.find(staff.getId());
+    if (it == rowOf.end()) return;  // Not mirrored
+    size_t row = it->second;
+    ages[row] = staff.getAge();
+    joinDates[row] = dateToKey(staff.getJoinDate());
+    departments[row] = departmentDict.encode(staff.getDepartment());
+    genders[row] = genderDict.encode(staff.getGender());
+}
+
+// Appends IDs of all staff matching the filter
+void StaffColumns::query(const StaffFilter& filter, vector<int>& matchingIds) const {
+    int departmentCode = -1, genderCode = -1;
+    if (!filter.department.empty()) {
+        departmentCode = departmentDict.lookup(filter.department);
+        if (departmentCode < 0) return;
+    }
+    if (!filter.gender.empty()) {
+        genderCode = genderDict.lookup(filter.gender);
+        if (genderCode < 0) return;
+    }
+
+    const size_t rows = ids.size();
+    SelectionBitmap selection(bitmapWords(rows), ~0ULL);
+    SelectionBitmap scratch(bitmapWords(rows));
+    if (filter.minAge >= 0 || filter.maxAge >= 0) {
+        selectRange(selection, scratch, ages, lowerBound(filter.minAge), upperBound(filter.maxAge));
+    }
+    if (filter.joinedFrom >= 0 || filter.joinedTo >= 0) {
+        selectRange(selection, scratch, joinDates, lowerBound(filter.joinedFrom), upperBound(filter.joinedTo));
+    }
+    if (departmentCode >= 0) selectEquals(selection, scratch, departments, departmentCode);
+    if (genderCode >= 0) selectEquals(selection, scratch, genders, genderCode);
+    collectSelected(selection.data(), rows, ids.data(), matchingIds);
+}
+
+// Number of rows
+size_t StaffColumns::size() const { return ids.size(); }
+
+// Heap bytes used by all columns and dictionaries
+size_t StaffColumns::memoryUsage() const {
+    return vectorBufferBytes(ids) + vectorBufferBytes(ages) + vectorBufferBytes(joinDates) +
+           vectorBufferBytes(departments) + vectorBufferBytes(genders) +
+           departmentDict.memoryUsage() + genderDict.memoryUsage() +
+           rowOf.bucket_count() * sizeof(void*) + rowOf.size() * (sizeof(int) + sizeof(size_t) + sizeof(void*));
+}
@@ -0,0 +1,118 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>         // For string operations
+#include <vector>         // For column storage
+#include <unordered_map>  // For dictionary and row lookup
+#include <cstdint>        // For fixed-width column types
+using namespace std;
+
+class Patient;  // Forward declarations (defined in hospital.h)
+class Staff;
+
+// Dictionary encoding for categorical values (e.g. blood group, gender).
+// Each distinct string gets a small integer code in order of first appearance.
+class Dictionary {
+private:
+    vector<string> values;                  // Code -> string
+    unordered_map<string, uint16_t> codes;  // String -> code
+
+public:
+    // Returns code for value, adding it if new
+    uint16_t encode(const string& value);
+
+    // Returns code for value, or -1 if the value has never been seen
+    int lookup(const string& value) const;
+
+    // Returns string for a code
+    const string& decode(uint16_t code) const;
+
+    // Number of distinct values
+    size_t size() const;
+
+    // Heap bytes used by the dictionary
+    size_t memoryUsage() const;
+};
+
+// Criteria for population queries; unset fields match everything
+struct PatientFilter {
+    string bloodGroup;     // Exact blood group ("" = any)
+    string gender;         // Exact gender ("" = any)
+    int minAge = -1;       // Inclusive lower bound (-1 = none)
+    int maxAge = -1;       // Inclusive upper bound (-1 = none)
+    int doctorId = -1;     // Assigned doctor (-1 = any)
+    int minId = -1;        // Inclusive lower ID bound (-1 = none)
+    int maxId = -1;        // Inclusive upper ID bound (-1 = none)
+};
+
+// Criteria for staff queries; unset fields match everything
+struct StaffFilter {
+    string department;     // Exact department ("" = any)
+    string gender;         // Exact gender ("" = any)
+    int minAge = -1;       // Inclusive lower bound (-1 = none)
+    int maxAge = -1;       // Inclusive upper bound (-1 = none)
+    int joinedFrom = -1;   // Earliest join date as YYYYMMDD (-1 = none)
+    int joinedTo = -1;     // Latest join date as YYYYMMDD (-1 = none)
+};
+
+// Converts "DD/MM/YYYY" to YYYYMMDD (0 if the date cannot be parsed)
+int dateToKey(const string& date);
+
+// Struct-of-arrays mirror of Patient attributes used for analytic scans.
+// Row i in every column describes the same patient.
+class PatientColumns {
+private:
+    vector<int32_t> ids;           // Patient IDs
+    vector<int32_t> ages;          // Ages in years
+    vector<int32_t> doctorIds;     // Assigned doctor IDs
+    vector<uint16_t> genders;      // Dictionary-encoded gender
+    vector<uint16_t> bloodGroups;  // Dictionary-encoded blood group
+    Dictionary genderDict;         // Gender dictionary
+    Dictionary bloodGroupDict;     // Blood group dictionary
+    unordered_map<int, size_t> rowOf;  // Patient ID -> row
+
+public:
+    // Adds a patient as a new row (or refreshes its row if already present)
+    void append(const Patient& patient);
+
+    // Rewrites the row of an existing patient after its attributes changed
+    void update(const Patient& patient);
+
+    // Appends IDs of all patients matching the filter
+    void query(const PatientFilter& filter, vector<int>& matchingIds) const;
+
+    // Number of rows
+    size_t size() const;
+
+    // Heap bytes used by all columns and dictionaries
+    size_t memoryUsage() const;
+};
+
+// Struct-of-arrays mirror of Staff attributes used for analytic scans
+class StaffColumns {
+private:
+    vector<int32_t> ids;           // Staff IDs
+    vector<int32_t> ages;          // Ages in years
+    vector<int32_t> joinDates;     // Join dates as YYYYMMDD
+    vector<uint16_t> departments;  // Dictionary-encoded department
+    vector<uint16_t> genders;      // Dictionary-encoded gender
+    Dictionary departmentDict;     // Department dictionary
+    Dictionary genderDict;         // Gender dictionary
+    unordered_map<int, size_t> rowOf;  // Staff ID -> row
+
+public:
+    // Adds a staff member as a new row (or refreshes its row if already present)
+    void append(const Staff& staff);
+
+    // Rewrites the row of an existing staff member after its attributes changed
+    void update(const Staff& staff);
+
+    // Appends IDs of all staff matching the filter
+    void query(const StaffFilter& filter, vector<int>& matchingIds) const;
+
+    // Number of rows
+    size_t size() const;
+
+    // Heap bytes used by all columns and dictionaries
+    size_t memoryUsage() const;
+};
@@ -0,0 +1,84 @@
+#include "command_log.h"  // Command history declarations
+#include <iostream>       // For history listings
+#include <algorithm>      // For max
+
+// ========== COMMAND LOG IMPLEMENTATION ========== //
+
+// Creates an empty history (at least one command is always kept)
+CommandLog::CommandLog(size_t capacity) : capacity(max<size_t>(capacity, 1)) {}
+
+// Keeps an executed command; a new change makes the undone ones unreachable
+void CommandLog::record(unique_ptr<Command> command) {
+    undone.clear();
+    done.push_back(move(command));
+    recorded++;
+    if (done.size() > capacity) {
+        done.pop_front();
+        dropped++;
+    }
+}
+
+// Most recently executed command
+Command* CommandLog::nextUndo() const { return done.empty() ? nullptr : done.back().get(); }
+
+// Most recently undone command
+Command* CommandLog::nextRedo() const { return undone.empty() ? nullptr : undone.back().get(); }
+
+// The next command to undo has been undone
+void CommandLog::markUndone() {
+    if (done.empty()) return;
+    undone.push_back(move(done.back()));
+    done.pop_back();
+    undos++;
+}
+
+// The next command to redo has been executed again
+void CommandLog::markRedone() {
+    if (undone.empty()) return;
+    done.push_back(move(undone.back()));
+    undone.pop_back();
+    redos++;
+}
+
+// Forgets every command (used when the entities they point to are released)
+void CommandLog::clear() {
+    done.clear();
+    undone.clear();
+}
+
+// Changes how many commands are kept
+void CommandLog::setCapacity(size_t newCapacity) {
+    capacity = max<size_t>(newCapacity, 1);
+    while (done.size() > capacity) {
+        done.pop_front();
+        dropped++;
+    }
+}
+
+size_t CommandLog::getCapacity() const { return capacity; }
+
+size_t CommandLog::undoCount() const { return done.size(); }
+
+size_t CommandLog::redoCount() const { return undone.size(); }
+
+// Lists the newest commands on each side, most recent first
+void CommandLog::displayHistory(size_t limit) const {
+    cout << "\nCan undo (" << done.size() << " of at most " << capacity << "):\n";
+    if (done.empty()) cout << "  (nothing)\n";
+    for (size_t i = 0; i < done.size() && i < limit; i++) {
+        const Command* command = done[done.size() - 1 - i].get();
+        cout << "  " << i + 1 << ". " << command->describe() << (command->isReversible() ? "" : "  [permanent]")
+             << "\n";
+    }
+    if (done.size() > limit) cout << "  ... and " << done.size() - limit << " older\n";
+
+    cout << "Can redo (" << undone.size() << "):\n";
+    if (undone.empty()) cout << "  (nothing)\n";
+    for (size_t i = 0; i < undone.size() && i < limit; i++) {
+        cout << "  " << i + 1 << ". " << undone[undone.size() - 1 - i]->describe() << "\n";
+    }
+    if (undone.size() > limit) cout << "  ... and " << undone.size() - limit << " more\n";
+
+    cout << "Since start: " << recorded << " changes, " << undos << " undone, " << redos << " redone, "
+         << dropped << " dropped at capacity\n";
+}
@@ -0,0 +1,75 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For descriptions
+#include <vector>   // For the redo stack
+#include <deque>    // For the bounded history
+#include <memory>   // For command ownership
+using namespace std;
+
+class HospitalSystem;  // Commands act on the hospital (hospital.h includes this header)
+
+// One change made from the menus. A command keeps only what it needs to make
+// the change again or reverse it (pointers to the pooled entities involved and
+// the values it replaced), never a copy of the entities themselves.
+class Command {
+public:
+    virtual ~Command() = default;
+
+    // Makes the change; false if it could not be made (nothing is recorded)
+    virtual bool execute(HospitalSystem& hospital) = 0;
+
+    // Reverses a change made by execute
+    virtual void undo(HospitalSystem& hospital) = 0;
+
+    // False for changes that cannot be taken back; undo stops at them
+    virtual bool isReversible() const { return true; }
+
+    // One line for the history list
+    virtual string describe() const = 0;
+};
+
+// Bounded undo/redo history. Executed commands are kept newest last; once the
+// capacity is reached the oldest is dropped. Undoing moves a command to the
+// redo stack and recording a new one clears that stack, so every step is O(1).
+class CommandLog {
+private:
+    deque<unique_ptr<Command>> done;     // Commands that can be undone, oldest first
+    vector<unique_ptr<Command>> undone;  // Commands that can be redone, most recently undone last
+    size_t capacity;                     // Most commands kept for undo
+
+    // Statistics
+    size_t recorded = 0;  // Commands executed
+    size_t undos = 0;     // Commands undone
+    size_t redos = 0;     // Commands redone
+    size_t dropped = 0;   // Oldest commands discarded at capacity
+
+public:
+    // Most changes that can be undone
+    explicit CommandLog(size_t capacity = 100);
+
+    // Keeps an executed command and discards anything that could be redone
+    void record(unique_ptr<Command> command);
+
+    // Next command to undo or redo (nullptr if none)
+    Command* nextUndo() const;
+    Command* nextRedo() const;
+
+    // Moves the next command between the two sides once it has been undone or redone
+    void markUndone();
+    void markRedone();
+
+    // Forgets every command
+    void clear();
+
+    // Changes how many commands are kept, dropping the oldest if needed
+    void setCapacity(size_t newCapacity);
+
+    // Accessor methods
+    size_t getCapacity() const;
+    size_t undoCount() const;
+    size_t redoCount() const;
+
+    // Lists the newest commands (up to limit) on each side and the totals
+    void displayHistory(size_t limit) const;
+};
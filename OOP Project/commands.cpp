@@ -0,0 +1,349 @@
+#include "commands.h"  // Menu command declarations
+#include <sstream>     // For descriptions with amounts
+#include <iomanip>     // For formatted amounts
+
+// ========== HELPERS ========== //
+
+// Dollar amount with cents, for descriptions
+static string money(double amount) {
+    ostringstream text;
+    text << "$" << fixed << setprecision(2) << amount;
+    return text.str();
+}
+
+// ========== REGISTRATIONS ========== //
+
+RegisterCommand::RegisterCommand(Patient* patient)
+    : description("Register patient #" + to_string(patient->getId()) + " " + patient->getName()),
+      action([patient](HospitalSystem& hospital) { hospital.addPatient(patient); }) {}
+
+RegisterCommand::RegisterCommand(Doctor* doctor)
+    : description("Register doctor #" + to_string(doctor->getId()) + " " + doctor->getName()),
+      action([doctor](HospitalSystem& hospital) { hospital.addDoctor(doctor); }) {}
+
+RegisterCommand::RegisterCommand(Nurse* nurse)
+    : description("Register nurse #" + to_string(nurse->getId()) + " " + nurse->getName()),
+      action([nurse](HospitalSystem& hospital) { hospital.addNurse(nurse); }) {}
+
+RegisterCommand::RegisterCommand(Medicine* medicine)
+    : description("Add medicine #" + to_string(medicine->getId()) + " " + medicine->getName()),
+      action([medicine](HospitalSystem& hospital) { hospital.addMedicine(medicine); }) {}
+
+RegisterCommand::RegisterCommand(Room* room)
+    : description("Add " + room->getType() + " room #" + to_string(room->getId())),
+      action([room](HospitalSystem& hospital) { hospital.addRoom(room); }) {}
+
+bool RegisterCommand::execute(HospitalSystem& hospital) {
+    action(hospital);
+    return true;
+}
+
+// Never called: undo stops at permanent commands
+void RegisterCommand::undo(HospitalSystem&) {}
+
+bool RegisterCommand::isReversible() const { return false; }
+
+string RegisterCommand::describe() const { return description; }
+
+CreateBillCommand::CreateBillCommand(int patientId) : patientId(patientId) {}
+
+bool CreateBillCommand::execute(HospitalSystem& hospital) {
+    Billing* bill;
+    hospital.createBill(patientId, bill);
+    return true;
+}
+
+// Never called: undo stops at permanent commands
+void CreateBillCommand::undo(HospitalSystem&) {}
+
+bool CreateBillCommand::isReversible() const { return false; }
+
+string CreateBillCommand::describe() const { return "Open bill for patient #" + to_string(patientId); }
+
+// ========== PEOPLE ========== //
+
+UpdateContactCommand::UpdateContactCommand(Person* person, const string& address, const string& contact)
+    : person(person), newAddress(address), newContact(contact),
+      oldAddress(person->getAddress()), oldContact(person->getContactNumber()) {}
+
+// The number is stored in a fixed-size field, so a malformed one is turned away here
+bool UpdateContactCommand::execute(HospitalSystem& hospital) {
+    if (!Person::isValidContactNumber(newContact)) {
+        cout << "\nInvalid contact number: use at least 3 digits, with + - ( ) . x allowed, up to 22 characters.\n";  // Error message
+        return false;
+    }
+    hospital.updateContactInfo(person, newAddress, newContact);
+    return true;
+}
+
+void UpdateContactCommand::undo(HospitalSystem& hospital) {
+    hospital.updateContactInfo(person, oldAddress, oldContact);
+}
+
+string UpdateContactCommand::describe() const {
+    return "Contact of #" + to_string(person->getId()) + ": " + oldContact + " -> " + newContact;
+}
+
+UpdateBloodGroupCommand::UpdateBloodGroupCommand(Patient* patient, const string& bloodGroup)
+    : patient(patient), newBloodGroup(bloodGroup), oldBloodGroup(patient->getBloodGroup()) {}
+
+bool UpdateBloodGroupCommand::execute(HospitalSystem& hospital) {
+    if (!Patient::isValidBloodGroup(newBloodGroup)) {
+        cout << "\nUnrecognised blood group: " << newBloodGroup << "\n";  // Error message
+        return false;
+    }
+    hospital.updateBloodGroup(patient, newBloodGroup);
+    return true;
+}
+
+void UpdateBloodGroupCommand::undo(HospitalSystem& hospital) { hospital.updateBloodGroup(patient, oldBloodGroup); }
+
+string UpdateBloodGroupCommand::describe() const {
+    return "Blood group of patient #" + to_string(patient->getId()) + ": " + oldBloodGroup + " -> " + newBloodGroup;
+}
+
+AddDiseaseCommand::AddDiseaseCommand(Patient* patient, const string& disease) : patient(patient), disease(disease) {}
+
+bool AddDiseaseCommand::execute(HospitalSystem& hospital) {
+    hospital.addDisease(patient, disease);
+    return true;
+}
+
+void AddDiseaseCommand::undo(HospitalSystem& hospital) { hospital.removeDisease(patient, disease); }
+
+string AddDiseaseCommand::describe() const {
+    return "Condition \"" + disease + "\" for patient #" + to_string(patient->getId());
+}
+
+// ========== APPOINTMENTS AND RECORDS ========== //
+
+ScheduleAppointmentCommand::ScheduleAppointmentCommand(Patient* patient, int doctorId, const string& dateTime)
+    : patient(patient), doctorId(doctorId), dateTime(dateTime) {}
+
+// Redo books under the original ID without moving the counter back
+bool ScheduleAppointmentCommand::execute(HospitalSystem& hospital) {
+    if (!apptId) {
+        apptId = hospital.scheduleAppointment(patient, doctorId, dateTime);
+        return apptId != 0;  // An invalid date books nothing
+    }
+    int next = Appointment::getNextId();
+    Appointment::setNextId(apptId);
+    hospital.scheduleAppointment(patient, doctorId, dateTime);
+    Appointment::setNextId(next);
+    return true;
+}
+
+void ScheduleAppointmentCommand::undo(HospitalSystem& hospital) { hospital.removeAppointment(patient, apptId); }
+
+string ScheduleAppointmentCommand::describe() const {
+    return "Appointment #" + to_string(apptId) + " for patient #" + to_string(patient->getId()) + " with doctor #" +
+           to_string(doctorId) + " at " + dateTime;
+}
+
+AddSlotCommand::AddSlotCommand(Doctor* doctor, const string& slot) : doctor(doctor), slot(slot) {}
+
+bool AddSlotCommand::execute(HospitalSystem& hospital) {
+    hospital.addAvailableSlot(doctor, slot);
+    return true;
+}
+
+void AddSlotCommand::undo(HospitalSystem& hospital) { hospital.removeAvailableSlot(doctor, slot); }
+
+string AddSlotCommand::describe() const { return "Slot \"" + slot + "\" for doctor #" + to_string(doctor->getId()); }
+
+CompleteAppointmentCommand::CompleteAppointmentCommand(Doctor* doctor, int apptId, const string& notes)
+    : doctor(doctor), apptId(apptId), notes(notes) {}
+
+bool CompleteAppointmentCommand::execute(HospitalSystem& hospital) {
+    Appointment* appt;
+    doctor->getAppointment(apptId, appt);
+    if (!appt || appt->getStatus() != AppointmentStatus::Pending) {
+        cout << "\nAppointment not found or not pending!\n";  // Error message
+        return false;
+    }
+    hospital.completeAppointment(doctor, apptId, notes);
+    return true;
+}
+
+void CompleteAppointmentCommand::undo(HospitalSystem& hospital) { hospital.reopenAppointment(doctor, apptId); }
+
+string CompleteAppointmentCommand::describe() const {
+    return "Complete appointment #" + to_string(apptId) + " (doctor #" + to_string(doctor->getId()) + ")";
+}
+
+AddMedicalRecordCommand::AddMedicalRecordCommand(Patient* patient, int doctorId, const string& diagnosis,
+                                                 const string& plan)
+    : patient(patient), doctorId(doctorId), diagnosis(diagnosis), plan(plan) {}
+
+// Redo creates the record under the original ID without moving the counter back
+bool AddMedicalRecordCommand::execute(HospitalSystem& hospital) {
+    if (!recordId) {
+        recordId = MedicalRecord::getNextId();  // The ID the new record receives
+        hospital.addMedicalRecord(patient, doctorId, diagnosis, plan);
+        return true;
+    }
+    int next = MedicalRecord::getNextId();
+    MedicalRecord::setNextId(recordId);
+    hospital.addMedicalRecord(patient, doctorId, diagnosis, plan);
+    MedicalRecord::setNextId(next);
+    return true;
+}
+
+void AddMedicalRecordCommand::undo(HospitalSystem& hospital) { hospital.removeMedicalRecord(patient, recordId); }
+
+string AddMedicalRecordCommand::describe() const {
+    return "Medical record #" + to_string(recordId) + " for patient #" + to_string(patient->getId()) + ": " +
+           diagnosis;
+}
+
+AddTestResultCommand::AddTestResultCommand(Patient* patient, int recordId, const string& result)
+    : patient(patient), recordId(recordId), result(result) {}
+
+bool AddTestResultCommand::execute(HospitalSystem& hospital) {
+    const MedicalRecord* record;
+    patient->findMedicalRecord(recordId, record);
+    if (!record) {
+        cout << "\nMedical record not found!\n";  // Error message
+        return false;
+    }
+    hospital.addTestResult(patient, recordId, result);
+    return true;
+}
+
+void AddTestResultCommand::undo(HospitalSystem& hospital) { hospital.removeTestResult(patient, recordId); }
+
+string AddTestResultCommand::describe() const {
+    return "Test result for record #" + to_string(recordId) + ": " + result;
+}
+
+UpdateTreatmentPlanCommand::UpdateTreatmentPlanCommand(Patient* patient, int recordId, const string& plan)
+    : patient(patient), recordId(recordId), plan(plan) {}
+
+bool UpdateTreatmentPlanCommand::execute(HospitalSystem& hospital) {
+    const MedicalRecord* record;
+    patient->findMedicalRecord(recordId, record);
+    if (!record) {
+        cout << "\nMedical record not found!\n";  // Error message
+        return false;
+    }
+    hospital.updateTreatmentPlan(patient, recordId, plan);
+    return true;
+}
+
+void UpdateTreatmentPlanCommand::undo(HospitalSystem& hospital) { hospital.revertTreatmentPlan(patient, recordId); }
+
+string UpdateTreatmentPlanCommand::describe() const {
+    return "Treatment plan for record #" + to_string(recordId) + ": " + plan;
+}
+
+// ========== ROOMS AND INVENTORY ========== //
+
+AssignRoomCommand::AssignRoomCommand(Patient* patient, Room* room) : patient(patient), room(room) {}
+
+// A second room would leave the first one occupied with nobody to discharge
+bool AssignRoomCommand::execute(HospitalSystem& hospital) {
+    if (patient->getRoomId() != -1) {
+        cout << "\nPatient is already in Room #" << patient->getRoomId() << "; discharge them first.\n";
+        return false;
+    }
+    if (room->getStatus() != RoomStatus::Vacant) {
+        cout << "\nRoom is already occupied!\n";  // Error message
+        return false;
+    }
+    hospital.assignRoom(patient, room);
+    return true;
+}
+
+void AssignRoomCommand::undo(HospitalSystem& hospital) { hospital.dischargePatient(patient); }
+
+string AssignRoomCommand::describe() const {
+    return "Admit patient #" + to_string(patient->getId()) + " to " + room->getType() + " room #" +
+           to_string(room->getId());
+}
+
+DischargeCommand::DischargeCommand(Patient* patient) : patient(patient) {}
+
+bool DischargeCommand::execute(HospitalSystem& hospital) {
+    if (patient->getRoomId() == -1) {
+        cout << "\nPatient is not assigned to any room!\n";  // Error message
+        return false;
+    }
+    hospital.findRoom(patient->getRoomId(), room);
+    hospital.dischargePatient(patient);
+    return true;
+}
+
+void DischargeCommand::undo(HospitalSystem& hospital) {
+    if (room) hospital.assignRoom(patient, room);
+}
+
+string DischargeCommand::describe() const {
+    return "Discharge patient #" + to_string(patient->getId()) + (room ? " from room #" + to_string(room->getId()) : "");
+}
+
+UpdateStockCommand::UpdateStockCommand(Medicine* medicine, int quantity) : medicine(medicine), quantity(quantity) {}
+
+bool UpdateStockCommand::execute(HospitalSystem& hospital) {
+    hospital.updateStock(medicine, quantity);
+    return true;
+}
+
+void UpdateStockCommand::undo(HospitalSystem& hospital) { hospital.updateStock(medicine, -quantity); }
+
+string UpdateStockCommand::describe() const {
+    return "Stock of " + medicine->getName() + " (#" + to_string(medicine->getId()) + ") " +
+           (quantity >= 0 ? "+" : "") + to_string(quantity);
+}
+
+// ========== BILLING ========== //
+
+AddServiceCommand::AddServiceCommand(Billing* bill, const string& service, double cost)
+    : bill(bill), service(service), cost(cost) {}
+
+bool AddServiceCommand::execute(HospitalSystem& hospital) {
+    hospital.addServiceToBill(bill, service, cost);
+    return true;
+}
+
+void AddServiceCommand::undo(HospitalSystem& hospital) { hospital.removeServiceFromBill(bill, service, cost); }
+
+string AddServiceCommand::describe() const {
+    return "Charge \"" + service + "\" (" + money(cost) + ") to bill #" + to_string(bill->getId()) + " (patient #" +
+           to_string(bill->getPatientId()) + ")";
+}
+
+AddMedicineToBillCommand::AddMedicineToBillCommand(Billing* bill, Medicine* medicine, int quantity)
+    : bill(bill), medicine(medicine), quantity(quantity) {}
+
+bool AddMedicineToBillCommand::execute(HospitalSystem& hospital) {
+    hospital.addMedicineToBill(bill, medicine, quantity);
+    return true;
+}
+
+void AddMedicineToBillCommand::undo(HospitalSystem& hospital) {
+    hospital.removeMedicineFromBill(bill, medicine, quantity);
+}
+
+string AddMedicineToBillCommand::describe() const {
+    return "Charge " + to_string(quantity) + " x " + medicine->getName() + " to bill #" + to_string(bill->getId()) +
+           " (patient #" + to_string(bill->getPatientId()) + ")";
+}
+
+ProcessPaymentCommand::ProcessPaymentCommand(Billing* bill, double amount) : bill(bill), amount(amount) {}
+
+// An insufficient payment changes nothing, so it is not recorded
+bool ProcessPaymentCommand::execute(HospitalSystem& hospital) {
+    if (bill->getPaymentStatus() != PaymentStatus::Unpaid) {
+        cout << "\nBill #" << bill->getId() << " is already paid!\n";  // Error message
+        return false;
+    }
+    hospital.processPayment(bill, amount);
+    return bill->getPaymentStatus() == PaymentStatus::Paid;
+}
+
+void ProcessPaymentCommand::undo(HospitalSystem& hospital) { hospital.refundPayment(bill); }
+
+string ProcessPaymentCommand::describe() const {
+    return "Payment of " + money(amount) + " settling bill #" + to_string(bill->getId()) + " (patient #" +
+           to_string(bill->getPatientId()) + ")";
+}
@@ -0,0 +1,275 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+#include "hospital.h"  // Commands act on the hospital and its pooled entities
+#include <functional>  // For registration actions
+
+// Every change the menus make, as a command for HospitalSystem::execute.
+// Each one holds pointers to the entities involved (pool slots never move)
+// and the values it replaced, and makes and reverses its change through the
+// same HospitalSystem operations the menus used before, so indexes, report
+// snapshots, checkpoints and the standby's log follow undo and redo too.
+
+// ========== REGISTRATIONS (PERMANENT) ========== //
+
+// Registers a new patient, doctor, nurse, medicine or room. New entities are
+// in every index and on the standby, so registration cannot be undone.
+class RegisterCommand : public Command {
+private:
+    string description;                       // What was registered
+    function<void(HospitalSystem&)> action;   // The matching addX call
+
+public:
+    explicit RegisterCommand(Patient* patient);
+    explicit RegisterCommand(Doctor* doctor);
+    explicit RegisterCommand(Nurse* nurse);
+    explicit RegisterCommand(Medicine* medicine);
+    explicit RegisterCommand(Room* room);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    bool isReversible() const override;
+    string describe() const override;
+};
+
+// Opens a new bill for a patient (permanent, like registrations)
+class CreateBillCommand : public Command {
+private:
+    int patientId;  // Patient billed
+
+public:
+    explicit CreateBillCommand(int patientId);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    bool isReversible() const override;
+    string describe() const override;
+};
+
+// ========== PEOPLE ========== //
+
+// Changes a person's address and contact number
+class UpdateContactCommand : public Command {
+private:
+    Person* person;                  // Patient, doctor or nurse
+    string newAddress, newContact;   // Values set
+    string oldAddress, oldContact;   // Values replaced (read when the command is created)
+
+public:
+    UpdateContactCommand(Person* person, const string& address, const string& contact);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Corrects a patient's blood group
+class UpdateBloodGroupCommand : public Command {
+private:
+    Patient* patient;
+    string newBloodGroup;  // Value set
+    string oldBloodGroup;  // Value replaced
+
+public:
+    UpdateBloodGroupCommand(Patient* patient, const string& bloodGroup);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Adds a known condition to a patient
+class AddDiseaseCommand : public Command {
+private:
+    Patient* patient;
+    string disease;
+
+public:
+    AddDiseaseCommand(Patient* patient, const string& disease);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// ========== APPOINTMENTS AND RECORDS ========== //
+
+// Books an appointment; redo books it again under the same ID
+class ScheduleAppointmentCommand : public Command {
+private:
+    Patient* patient;
+    int doctorId;
+    string dateTime;
+    int apptId = 0;  // Assigned when first executed
+
+public:
+    ScheduleAppointmentCommand(Patient* patient, int doctorId, const string& dateTime);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Opens an appointment slot for a doctor
+class AddSlotCommand : public Command {
+private:
+    Doctor* doctor;
+    string slot;
+
+public:
+    AddSlotCommand(Doctor* doctor, const string& slot);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Completes a pending appointment with diagnosis notes
+class CompleteAppointmentCommand : public Command {
+private:
+    Doctor* doctor;
+    int apptId;
+    string notes;
+
+public:
+    CompleteAppointmentCommand(Doctor* doctor, int apptId, const string& notes);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Creates a medical record; redo creates it again under the same ID
+class AddMedicalRecordCommand : public Command {
+private:
+    Patient* patient;
+    int doctorId;
+    string diagnosis, plan;
+    int recordId = 0;  // Assigned when first executed
+
+public:
+    AddMedicalRecordCommand(Patient* patient, int doctorId, const string& diagnosis, const string& plan);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Adds a test result to a record
+class AddTestResultCommand : public Command {
+private:
+    Patient* patient;
+    int recordId;
+    string result;
+
+public:
+    AddTestResultCommand(Patient* patient, int recordId, const string& result);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Replaces a record's treatment plan (undo drops the revision from the plan history)
+class UpdateTreatmentPlanCommand : public Command {
+private:
+    Patient* patient;
+    int recordId;
+    string plan;
+
+public:
+    UpdateTreatmentPlanCommand(Patient* patient, int recordId, const string& plan);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// ========== ROOMS AND INVENTORY ========== //
+
+// Admits a patient who is not in a room to a vacant room
+class AssignRoomCommand : public Command {
+private:
+    Patient* patient;
+    Room* room;
+
+public:
+    AssignRoomCommand(Patient* patient, Room* room);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Discharges a patient from their room
+class DischargeCommand : public Command {
+private:
+    Patient* patient;
+    Room* room = nullptr;  // Room left (found when first executed)
+
+public:
+    explicit DischargeCommand(Patient* patient);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Adds or deducts stock (undo applies the opposite amount)
+class UpdateStockCommand : public Command {
+private:
+    Medicine* medicine;
+    int quantity;  // Positive to add, negative to deduct
+
+public:
+    UpdateStockCommand(Medicine* medicine, int quantity);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// ========== BILLING ========== //
+
+// Charges a service to a bill
+class AddServiceCommand : public Command {
+private:
+    Billing* bill;
+    string service;
+    double cost;
+
+public:
+    AddServiceCommand(Billing* bill, const string& service, double cost);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Charges dispensed medicine to a bill and deducts the stock
+class AddMedicineToBillCommand : public Command {
+private:
+    Billing* bill;
+    Medicine* medicine;
+    int quantity;
+
+public:
+    AddMedicineToBillCommand(Billing* bill, Medicine* medicine, int quantity);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
+
+// Takes a payment; only a payment that settles the bill is recorded
+class ProcessPaymentCommand : public Command {
+private:
+    Billing* bill;
+    double amount;
+
+public:
+    ProcessPaymentCommand(Billing* bill, double amount);
+
+    bool execute(HospitalSystem& hospital) override;
+    void undo(HospitalSystem& hospital) override;
+    string describe() const override;
+};
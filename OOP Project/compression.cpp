@@ -0,0 +1,100 @@
+#include "compression.h"  // Codec declarations
+#include <cstring>        // For memcpy
+
+static const int HASH_BITS = 14;           // 16K-entry match finder
+static const size_t MIN_MATCH = 4;         // Shortest match worth encoding
+static const size_t MAX_OFFSET = 65535;    // Window reachable by 2-byte offsets
+
+// Reads 4 bytes without alignment requirements
+static uint32_t load32(const char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Writes a length that did not fit its token nibble
+static void writeLength(vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+// Writes literals, then the match if there is one
+static void writeSequence(vector<uint8_t>& out, const char* literals, size_t literalCount,
+                          size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((literalCount < 15 ? literalCount : 15) << 4 |
+                                         (matchCode < 15 ? matchCode : 15));
+    out.push_back(token);
+    if (literalCount >= 15) writeLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (!matchLength) return;  // Final sequence
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) writeLength(out, matchCode - 15);
+}
+
+// Appends the compressed form of data to out
+void lzCompress(const char* data, size_t size, vector<uint8_t>& out) {
+    vector<int32_t> table(1u << HASH_BITS, -1);  // Hash of 4 bytes -> last position
+    size_t anchor = 0, i = 0;
+    while (i + MIN_MATCH <= size) {
+        uint32_t sequence = load32(data + i);
+        uint32_t slot = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        int32_t candidate = table[slot];
+        table[slot] = static_cast<int32_t>(i);
+        if (candidate < 0 || i - candidate > MAX_OFFSET || load32(data + candidate) != sequence) {
+            i++;
+            continue;
+        }
+        size_t length = MIN_MATCH;
+        while (i + length < size && data[candidate + length] == data[i + length]) length++;
+        writeSequence(out, data + anchor, i - anchor, i - candidate, length);
+        i += length;
+        anchor = i;
+    }
+    writeSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+// Reads a length continuation; returns false past the end of input
+static bool readLength(const uint8_t* data, size_t size, size_t& pos, size_t& length) {
+    uint8_t byte;
+    do {
+        if (pos >= size) return false;
+        byte = data[pos++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// Decompresses a block into out
+bool lzDecompress(const uint8_t* data, size_t size, string& out) {
+    size_t start = out.size();  // Matches may not reach before this block's output
+    size_t pos = 0;
+    while (pos < size) {
+        uint8_t token = data[pos++];
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(data, size, pos, literalCount)) return false;
+        if (literalCount > size - pos) return false;
+        out.append(reinterpret_cast<const char*>(data + pos), literalCount);
+        pos += literalCount;
+        if (pos == size) return true;  // Final sequence
+
+        if (size - pos < 2) return false;
+        size_t offset = data[pos] | static_cast<size_t>(data[pos + 1]) << 8;
+        pos += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(data, size, pos, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > out.size() - start) return false;
+        size_t from = out.size() - offset;
+        if (offset >= matchLength) {
+            out.append(out, from, matchLength);  // Source fully written already
+        } else {
+            for (size_t k = 0; k < matchLength; k++) out.push_back(out[from + k]);  // Overlaps itself
+        }
+    }
+    return true;
+}
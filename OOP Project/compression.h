@@ -0,0 +1,18 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For decompressed output
+#include <vector>   // For compressed bytes
+#include <cstdint>  // For fixed-width types
+using namespace std;
+
+// Fast LZ77 block codec (LZ4-style sequences, 64 KB window).
+// Each sequence is a token byte (high nibble = literal count, low nibble =
+// match length - 4; 15 means more length bytes follow), the literals, then a
+// 2-byte match offset. The final sequence carries literals only.
+
+// Appends the compressed form of data to out
+void lzCompress(const char* data, size_t size, vector<uint8_t>& out);
+
+// Decompresses a block into out (appending); returns false if the block is corrupt
+bool lzDecompress(const uint8_t* data, size_t size, string& out);
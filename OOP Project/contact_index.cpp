@@ -0,0 +1,87 @@
+#include "contact_index.h"  // Contact index declarations
+#include "memory.h"         // For footprint helpers
+#include <algorithm>        // For find
+#include <cctype>           // For character classification
+
+// Normalizes a phone number to its digits
+string normalizePhone(string_view phone) {
+    string digits;
+    for (char c : phone) {
+        if (isdigit(static_cast<unsigned char>(c))) digits += c;
+    }
+    if (digits.size() > 10) digits.erase(0, digits.size() - 10);  // Drops country/trunk prefix
+    return digits;
+}
+
+// Normalizes an address for exact lookup
+string normalizeAddress(const string& address) {
+    static const unordered_map<string, string> abbreviations = {
+        { "street", "st" }, { "avenue", "ave" }, { "road", "rd" }, { "drive", "dr" },
+        { "boulevard", "blvd" }, { "lane", "ln" }, { "court", "ct" }, { "place", "pl" },
+        { "apartment", "apt" }, { "north", "n" }, { "south", "s" }, { "east", "e" }, { "west", "w" }
+    };
+    string result, word;
+    for (size_t i = 0; i <= address.size(); i++) {
+        unsigned char c = i < address.size() ? static_cast<unsigned char>(address[i]) : ' ';
+        if (isalnum(c)) {
+            word += static_cast<char>(tolower(c));
+        } else if (c != '.' && c != '\'' && !word.empty()) {  // "St." and "O'Neil" stay one word
+            auto abbreviation = abbreviations.find(word);
+            if (!result.empty()) result += ' ';
+            result += abbreviation == abbreviations.end() ? word : abbreviation->second;
+            word.clear();
+        }
+    }
+    return result;
+}
+
+// Removes a person from one key's list
+void ContactIndex::removeEntry(unordered_map<string, vector<Person*>>& index, const string& key, Person* person) {
+    auto it = index.find(key);
+    if (it == index.end()) return;
+    vector<Person*>& people = it->second;
+    people.erase(remove(people.begin(), people.end(), person), people.end());
+    if (people.empty()) index.erase(it);  // Drops unused keys
+}
+
+// Indexes a person's current contact details
+void ContactIndex::add(Person* person, string_view phone, const string& address) {
+    string phoneKey = normalizePhone(phone);
+    string addressKey = normalizeAddress(address);
+    if (!phoneKey.empty()) byPhone[phoneKey].push_back(person);
+    if (!addressKey.empty()) byAddress[addressKey].push_back(person);
+}
+
+// Moves a person from old contact details to new ones
+void ContactIndex::update(Person* person, string_view oldPhone, const string& oldAddress,
+                          string_view newPhone, const string& newAddress) {
+    removeEntry(byPhone, normalizePhone(oldPhone), person);
+    removeEntry(byAddress, normalizeAddress(oldAddress), person);
+    add(person, newPhone, newAddress);
+}
+
+// People registered under the phone number
+const vector<Person*>& ContactIndex::findByPhone(const string& phone) const {
+    static const vector<Person*> none;
+    auto it = byPhone.find(normalizePhone(phone));
+    return it == byPhone.end() ? none : it->second;
+}
+
+// People registered at the address
+const vector<Person*>& ContactIndex::findByAddress(const string& address) const {
+    static const vector<Person*> none;
+    auto it = byAddress.find(normalizeAddress(address));
+    return it == byAddress.end() ? none : it->second;
+}
+
+// Heap bytes used by the index
+size_t ContactIndex::memoryUsage() const {
+    size_t bytes = (byPhone.bucket_count() + byAddress.bucket_count()) * sizeof(void*);
+    for (const auto* index : { &byPhone, &byAddress }) {
+        for (const auto& entry : *index) {
+            bytes += sizeof(entry) + sizeof(void*) + stringHeapBytes(entry.first) +
+                     vectorBufferBytes(entry.second);
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,43 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>         // For keys
+#include <string_view>    // For phone numbers held outside a string
+#include <vector>         // For people sharing a key
+#include <unordered_map>  // For key -> people lookup
+using namespace std;
+
+class Person;  // Indexed entries point at registered persons
+
+// Normalizes a phone number to its digits ("(555) 123-4567" -> "5551234567").
+// Numbers longer than 10 digits keep the last 10, dropping country/trunk prefixes.
+string normalizePhone(string_view phone);
+
+// Normalizes an address: lowercase words, punctuation dropped, common street
+// suffixes abbreviated ("123 Main Street." -> "123 main st")
+string normalizeAddress(const string& address);
+
+// Reverse index from normalized phone number and address to the people using them
+class ContactIndex {
+private:
+    unordered_map<string, vector<Person*>> byPhone;    // Normalized phone -> people
+    unordered_map<string, vector<Person*>> byAddress;  // Normalized address -> people
+
+    // Removes a person from one key's list
+    static void removeEntry(unordered_map<string, vector<Person*>>& index, const string& key, Person* person);
+
+public:
+    // Indexes a person's current contact details
+    void add(Person* person, string_view phone, const string& address);
+
+    // Moves a person from old contact details to new ones
+    void update(Person* person, string_view oldPhone, const string& oldAddress,
+                string_view newPhone, const string& newAddress);
+
+    // People registered under the phone number / address (single hash probe)
+    const vector<Person*>& findByPhone(const string& phone) const;
+    const vector<Person*>& findByAddress(const string& address) const;
+
+    // Heap bytes used by the index
+    size_t memoryUsage() const;
+};
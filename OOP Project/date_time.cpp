@@ -0,0 +1,95 @@
+#include "date_time.h"  // Packed date declarations
+#include <ctime>        // For the current local time
+#include <cstdio>       // For snprintf
+
+// ========== PACKED DATE AND TIME ========== //
+
+static const uint32_t MINUTES_PER_DAY = 24 * 60;
+
+// Days from 01/01/1970 to a date in the proleptic Gregorian calendar (years from 1970)
+static uint32_t daysFromCivil(uint32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;  // Years start in March, so the leap day ends the year
+    uint32_t era = year / 400;
+    uint32_t yearOfEra = year - era * 400;
+    uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;  // 719468 days from 01/03/0000 to 01/01/1970
+}
+
+// Date of a day number from daysFromCivil
+static void civilFromDays(uint32_t days, uint32_t& year, uint32_t& month, uint32_t& day) {
+    uint32_t shifted = days + 719468;
+    uint32_t era = shifted / 146097;
+    uint32_t dayOfEra = shifted - era * 146097;
+    uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    uint32_t monthIndex = (5 * dayOfYear + 2) / 153;  // March = 0
+    day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+// Reads 1 to maxDigits digits at pos; false if there are none
+static bool readNumber(string_view text, size_t& pos, size_t maxDigits, uint32_t& value) {
+    size_t start = pos;
+    value = 0;
+    while (pos < text.size() && pos - start < maxDigits && text[pos] >= '0' && text[pos] <= '9') {
+        value = value * 10 + static_cast<uint32_t>(text[pos++] - '0');
+    }
+    return pos > start;
+}
+
+PackedDateTime packDateTime(string_view text) {
+    static const uint32_t monthDays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    size_t pos = 0;
+    uint32_t day, month, year, hour = 0, minute = 0;
+    if (!readNumber(text, pos, 2, day) || pos >= text.size() || text[pos++] != '/' ||
+        !readNumber(text, pos, 2, month) || pos >= text.size() || text[pos++] != '/') {
+        return NO_DATE_TIME;
+    }
+    size_t yearStart = pos;
+    if (!readNumber(text, pos, 4, year) || pos - yearStart != 4) return NO_DATE_TIME;
+    if (pos < text.size()) {  // Optional time
+        if (text[pos++] != ' ' || !readNumber(text, pos, 2, hour) || pos >= text.size() || text[pos++] != ':') {
+            return NO_DATE_TIME;
+        }
+        size_t minuteStart = pos;
+        if (!readNumber(text, pos, 2, minute) || pos - minuteStart != 2 || pos != text.size()) return NO_DATE_TIME;
+    }
+    if (year < 1970 || month < 1 || month > 12 || hour > 23 || minute > 59) return NO_DATE_TIME;
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day < 1 || day > monthDays[month - 1] + (month == 2 && leap)) return NO_DATE_TIME;
+    return daysFromCivil(year, month, day) * MINUTES_PER_DAY + hour * 60 + minute;  // Midnight of 01/01/1970 is NO_DATE_TIME
+}
+
+bool isValidDateTime(string_view text) { return packDateTime(text) != NO_DATE_TIME; }
+
+string formatDateTime(PackedDateTime when) {
+    if (when == NO_DATE_TIME) return "Not recorded";
+    uint32_t minutes = when % MINUTES_PER_DAY;
+    char time[16];
+    snprintf(time, sizeof(time), " %02u:%02u", minutes / 60, minutes % 60);
+    return formatDate(when) + time;
+}
+
+string formatDate(PackedDateTime when) {
+    if (when == NO_DATE_TIME) return "Not recorded";
+    uint32_t year, month, day;
+    civilFromDays(when / MINUTES_PER_DAY, year, month, day);
+    char date[32];  // Room for any year the compiler can imagine
+    snprintf(date, sizeof(date), "%02u/%02u/%04u", day, month, year);
+    return date;
+}
+
+PackedDateTime currentDateTime() {
+    time_t now = time(nullptr);
+    tm local;
+    #ifdef _WIN32
+        localtime_s(&local, &now);  // Windows argument order
+    #else
+        localtime_r(&now, &local);
+    #endif
+    uint32_t days = daysFromCivil(static_cast<uint32_t>(local.tm_year + 1900), static_cast<uint32_t>(local.tm_mon + 1),
+                                  static_cast<uint32_t>(local.tm_mday));
+    return days * MINUTES_PER_DAY + static_cast<uint32_t>(local.tm_hour * 60 + local.tm_min);
+}
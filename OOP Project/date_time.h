@@ -0,0 +1,31 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>       // For formatted dates
+#include <string_view>  // For parsing without copies
+#include <cstdint>      // For fixed-width types
+using namespace std;
+
+// Date and time as minutes since 01/01/1970 00:00, as entered (no time zone).
+// Four bytes per field instead of a string or an intern-table entry, which
+// would keep every distinct timestamp for the life of the program. Covers
+// 01/01/1970 00:01 to the end of 9999.
+typedef uint32_t PackedDateTime;
+
+// Missing or unreadable date (older files held free text such as "Current Date")
+const PackedDateTime NO_DATE_TIME = 0;
+
+// Packs "DD/MM/YYYY HH:MM" or "DD/MM/YYYY" (midnight); NO_DATE_TIME if not a real date and time
+PackedDateTime packDateTime(string_view text);
+
+// True if text is a real date in one of the forms packDateTime accepts
+bool isValidDateTime(string_view text);
+
+// "DD/MM/YYYY HH:MM" ("Not recorded" for NO_DATE_TIME)
+string formatDateTime(PackedDateTime when);
+
+// "DD/MM/YYYY" ("Not recorded" for NO_DATE_TIME)
+string formatDate(PackedDateTime when);
+
+// Local date and time now
+PackedDateTime currentDateTime();
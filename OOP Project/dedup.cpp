@@ -0,0 +1,335 @@
+#include "dedup.h"          // Duplicate detection declarations
+#include "contact_index.h"  // For phone and address normalization
+#include "blood_match.h"    // For blood group codes
+#include "memory.h"         // For footprint helpers
+#include <algorithm>        // For sorting and unique
+#include <atomic>           // For work distribution between threads
+#include <thread>           // For the parallel pass
+#include <functional>       // For hash
+#include <cctype>           // For character classification
+#include <cstdlib>          // For abs
+#include <ctime>            // For current year
+#include <iostream>         // For benchmark output
+#include <chrono>           // For benchmark timing
+#include <random>           // For generated patients
+
+// ========== FINGERPRINTS ========== //
+
+// Current calendar year (birth years are derived from age)
+static int currentYear() {
+    static const int year = [] {
+        time_t now = time(nullptr);
+        return localtime(&now)->tm_year + 1900;
+    }();
+    return year;
+}
+
+// American Soundex code of a word
+string soundex(const string& word) {
+    static const char codes[] = "01230120022455012623010202";  // a..z
+    string code;
+    char last = 0;
+    for (char c : word) {
+        if (!isalpha(static_cast<unsigned char>(c))) continue;
+        char lower = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        char digit = codes[lower - 'a'];
+        if (code.empty()) {
+            code += static_cast<char>(toupper(lower));
+        } else if (digit != '0' && digit != last) {
+            code += digit;
+            if (code.size() == 4) break;
+        }
+        if (lower != 'h' && lower != 'w') last = digit;  // H and W do not separate equal codes
+    }
+    if (!code.empty()) code.resize(4, '0');
+    return code;
+}
+
+// Builds a fingerprint from registration details
+PatientFingerprint makeFingerprint(const string& name, int age, const string& gender,
+                                   string_view phone, const string& address, const string& bloodGroup) {
+    static const char* titles[] = { "mr", "mrs", "ms", "miss", "dr", "prof" };
+    PatientFingerprint print;
+    vector<string> words;
+    string word;
+    for (size_t i = 0; i <= name.size(); i++) {
+        unsigned char c = i < name.size() ? static_cast<unsigned char>(name[i]) : ' ';
+        if (isalpha(c)) {
+            word += static_cast<char>(tolower(c));
+        } else if (!word.empty() && c != '\'' && c != '-') {  // "O'Neil" and "Smith-Jones" stay one word
+            if (find(begin(titles), end(titles), word) == end(titles)) words.push_back(word);
+            word.clear();
+        }
+    }
+    for (const auto& w : words) print.name += (print.name.empty() ? "" : " ") + w;
+    if (!words.empty()) {
+        print.firstSound = soundex(words.front());
+        print.lastSound = soundex(words.back());
+    }
+    print.birthYear = currentYear() - age;
+    char g = gender.empty() ? '?' : static_cast<char>(toupper(static_cast<unsigned char>(gender[0])));
+    print.gender = (g == 'M' || g == 'F') ? g : '?';
+    print.phone = normalizePhone(phone);
+    print.address = normalizeAddress(address);
+    print.bloodGroup = bloodGroupCode(bloodGroup);
+    return print;
+}
+
+// ========== SIMILARITY ========== //
+
+// Typo-distance similarity of two names (first 64 characters compared).
+// Names more than a quarter of their length apart score 0 without finishing
+// the distance, so only a diagonal band of the table is computed.
+double nameSimilarity(const string& a, const string& b) {
+    int n = static_cast<int>(min<size_t>(a.size(), 64));
+    int m = static_cast<int>(min<size_t>(b.size(), 64));
+    if (n == 0 || m == 0) return n == m ? 1.0 : 0.0;
+    int limit = max(n, m) / 4;  // Most typos still considered similar
+    if (abs(n - m) > limit) return 0.0;
+
+    // Optimal string alignment distance: insertions, deletions, substitutions
+    // and adjacent transpositions each count as one typo
+    const int FAR = limit + 1;  // Stands for any distance beyond the limit
+    int rows[3][66];            // Two rows back, previous row, current row
+    for (auto& row : rows) fill(begin(row), end(row), FAR);
+    int* older = rows[0];
+    int* previous = rows[1];
+    int* current = rows[2];
+    for (int j = 0; j <= min(m, limit); j++) previous[j] = j;
+    for (int i = 1; i <= n; i++) {
+        int from = max(1, i - limit), to = min(m, i + limit);
+        current[0] = i <= limit ? i : FAR;
+        current[from - 1] = from > 1 ? FAR : current[0];
+        int rowBest = current[0];
+        for (int j = from; j <= to; j++) {
+            int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            int best = min(previous[j - 1] + cost, min(previous[j], current[j - 1]) + 1);
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                best = min(best, older[j - 2] + 1);
+            }
+            current[j] = min(best, FAR);
+            rowBest = min(rowBest, current[j]);
+        }
+        current[to + 1] = FAR;  // Next row reads one past this band
+        if (rowBest > limit) return 0.0;
+        int* recycled = older;
+        older = previous;
+        previous = current;
+        current = recycled;
+    }
+    return previous[m] > limit ? 0.0 : 1.0 - static_cast<double>(previous[m]) / max(n, m);
+}
+
+// Duplicate likelihood of two fingerprints
+double duplicateScore(const PatientFingerprint& a, const PatientFingerprint& b) {
+    double similarity = nameSimilarity(a.name, b.name);
+    if (similarity < 0.75) return 0.0;  // Different names are never the same patient
+
+    // A name within a typo or two plus age and gender reaches the threshold;
+    // contact details corroborate weaker name matches
+    double score = 0.60 * similarity;
+    if (abs(a.birthYear - b.birthYear) <= 1) score += 0.20;
+    if (!a.phone.empty() && a.phone == b.phone) score += 0.15;
+    if (!a.address.empty() && a.address == b.address) score += 0.10;
+    if (a.gender != '?' && a.gender == b.gender) score += 0.05;
+    if (a.bloodGroup >= 0 && b.bloodGroup >= 0 && a.bloodGroup != b.bloodGroup) score -= 0.20;
+    return min(score, 1.0);
+}
+
+// ========== DETECTOR ========== //
+
+// Blocking keys a fingerprint is stored under.
+// The name key is stored for the birth year and the following one, so
+// patients whose derived birth years differ by one still share a key.
+void DuplicateDetector::storedKeys(const PatientFingerprint& print, vector<uint64_t>& keys) {
+    hash<string> hasher;
+    if (!print.lastSound.empty()) {
+        string prefix = "N|" + print.lastSound + print.firstSound.substr(0, 1) + "|";
+        keys.push_back(hasher(prefix + to_string(print.birthYear)));
+        keys.push_back(hasher(prefix + to_string(print.birthYear + 1)));
+    }
+    if (print.phone.size() >= 7) keys.push_back(hasher("P|" + print.phone));  // Too short to identify anyone
+}
+
+// Blocking keys a fingerprint is looked up under
+void DuplicateDetector::probeKeys(const PatientFingerprint& print, vector<uint64_t>& keys) {
+    storedKeys(print, keys);  // Stored years x, x+1 meet probed years y, y+1 whenever |x - y| <= 1
+}
+
+// Indexes (or re-indexes) the patient at row
+void DuplicateDetector::add(uint32_t row, const PatientFingerprint& print) {
+    if (row < present.size() && present[row]) remove(row);
+    if (row >= fingerprints.size()) {
+        fingerprints.resize(row + 1);
+        present.resize(row + 1, false);
+    }
+    fingerprints[row] = print;
+    present[row] = true;
+    vector<uint64_t> keys;
+    storedKeys(print, keys);
+    for (uint64_t key : keys) blocks[key].push_back(row);
+}
+
+// Removes the patient at row
+void DuplicateDetector::remove(uint32_t row) {
+    if (row >= present.size() || !present[row]) return;
+    vector<uint64_t> keys;
+    storedKeys(fingerprints[row], keys);
+    for (uint64_t key : keys) {
+        auto it = blocks.find(key);
+        if (it == blocks.end()) continue;
+        vector<uint32_t>& rows = it->second;
+        rows.erase(std::remove(rows.begin(), rows.end(), row), rows.end());
+        if (rows.empty()) blocks.erase(it);
+    }
+    present[row] = false;
+    fingerprints[row] = PatientFingerprint();
+}
+
+// Probable duplicates of a patient, best first
+void DuplicateDetector::findMatches(const PatientFingerprint& print, uint32_t excludeRow,
+                                    vector<DuplicateMatch>& matches) const {
+    vector<uint64_t> keys;
+    probeKeys(print, keys);
+    vector<uint32_t> candidates;
+    for (uint64_t key : keys) {
+        auto it = blocks.find(key);
+        if (it == blocks.end()) continue;
+        const vector<uint32_t>& rows = it->second;
+        size_t from = rows.size() > BLOCK_PROBE_LIMIT ? rows.size() - BLOCK_PROBE_LIMIT : 0;  // Bounds latency
+        candidates.insert(candidates.end(), rows.begin() + from, rows.end());
+    }
+    sort(candidates.begin(), candidates.end());
+    candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (uint32_t row : candidates) {
+        if (row == excludeRow) continue;
+        double score = duplicateScore(print, fingerprints[row]);
+        if (score >= THRESHOLD) matches.push_back({ row, score });
+    }
+    sort(matches.begin(), matches.end(),
+         [](const DuplicateMatch& a, const DuplicateMatch& b) { return a.score > b.score; });
+}
+
+// All probable duplicate pairs, blocks split across worker threads
+void DuplicateDetector::findAllPairs(unsigned threads, vector<DuplicatePair>& pairs) const {
+    vector<const vector<uint32_t>*> work;
+    for (const auto& entry : blocks) {
+        if (entry.second.size() > 1) work.push_back(&entry.second);
+    }
+    if (threads == 0) threads = 1;
+
+    atomic<size_t> nextBlock(0);
+    vector<vector<DuplicatePair>> found(threads);
+    auto worker = [&](unsigned id) {
+        vector<DuplicatePair>& out = found[id];
+        for (size_t b = nextBlock++; b < work.size(); b = nextBlock++) {
+            const vector<uint32_t>& rows = *work[b];
+            for (size_t i = 0; i < rows.size(); i++) {
+                // Oversized blocks (very common names, shared switchboard numbers)
+                // only compare rows registered close together
+                size_t end = min(rows.size(), i + 1 + PAIR_WINDOW);
+                for (size_t j = i + 1; j < end; j++) {
+                    double score = duplicateScore(fingerprints[rows[i]], fingerprints[rows[j]]);
+                    if (score < THRESHOLD) continue;
+                    uint32_t a = min(rows[i], rows[j]), c = max(rows[i], rows[j]);
+                    out.push_back({ a, c, score });
+                }
+            }
+        }
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);  // Calling thread works too
+    for (auto& t : pool) t.join();
+
+    // Pairs sharing several keys are found once per block
+    for (auto& part : found) pairs.insert(pairs.end(), part.begin(), part.end());
+    sort(pairs.begin(), pairs.end(), [](const DuplicatePair& a, const DuplicatePair& b) {
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+    pairs.erase(unique(pairs.begin(), pairs.end(), [](const DuplicatePair& a, const DuplicatePair& b) {
+        return a.first == b.first && a.second == b.second;
+    }), pairs.end());
+}
+
+// Number of indexed patients
+size_t DuplicateDetector::size() const {
+    return static_cast<size_t>(count(present.begin(), present.end(), true));
+}
+
+// Heap bytes used by the detector
+size_t DuplicateDetector::memoryUsage() const {
+    size_t bytes = blocks.bucket_count() * sizeof(void*) + vectorBufferBytes(fingerprints) + present.capacity() / 8;
+    for (const auto& entry : blocks) {
+        bytes += sizeof(entry) + sizeof(void*) + vectorBufferBytes(entry.second);
+    }
+    for (const auto& print : fingerprints) {
+        bytes += stringHeapBytes(print.name) + stringHeapBytes(print.phone) + stringHeapBytes(print.address);
+    }
+    return bytes;
+}
+
+// ========== BENCHMARK ========== //
+
+// Times a parallel pass and registration checks over generated patients
+void runDeduplicationBenchmark(size_t patients, unsigned threads) {
+    static const char* firstNames[] = { "John", "Sarah", "Ahmed", "Maria", "Wei", "Fatima", "James", "Olga",
+                                        "Carlos", "Aisha", "Peter", "Yuki", "David", "Leila", "Omar", "Grace" };
+    static const char* syllables[] = { "sm", "ith", "son", "ber", "ka", "mal", "ov", "ez", "lin", "ham",
+                                       "ton", "ri", "ck", "stein", "ba", "ra", "der", "wo", "li", "an" };
+    cout << "\nGenerating " << patients << " patients (about 5% re-registered with typos)...\n";
+    DuplicateDetector detector;
+    vector<PatientFingerprint> prints;
+    prints.reserve(patients);
+    vector<pair<uint32_t, uint32_t>> planted;  // (original, duplicate)
+    mt19937 generator(777);  // Fixed seed keeps runs comparable
+    auto next = [&generator]() { return static_cast<uint32_t>(generator()); };
+    for (size_t i = 0; i < patients; i++) {
+        if (i > 0 && next() % 20 == 0) {
+            uint32_t original = next() % i;
+            PatientFingerprint copy = prints[original];
+            copy.name[next() % copy.name.size()] = "aeiouy"[next() % 6];  // Typo
+            if (next() % 2) copy.birthYear += 1;                          // Birthday passed
+            if (next() % 3 == 0) copy.phone.clear();                      // Number not given
+            copy.lastSound = soundex(copy.name.substr(copy.name.rfind(' ') + 1));
+            copy.firstSound = soundex(copy.name.substr(0, copy.name.find(' ')));
+            planted.push_back({ original, static_cast<uint32_t>(i) });
+            prints.push_back(copy);
+        } else {
+            string name = firstNames[next() % 16];
+            name += ' ';
+            for (int s = 0; s < 4; s++) name += syllables[next() % 20];
+            prints.push_back(makeFingerprint(name, 1 + next() % 90, next() % 2 ? "Male" : "Female",
+                                             to_string(2000000000u + next() % 1000000000u), "", ""));
+        }
+        detector.add(static_cast<uint32_t>(i), prints.back());
+    }
+
+    for (unsigned t : { 1u, threads }) {
+        vector<DuplicatePair> pairs;
+        auto start = chrono::steady_clock::now();
+        detector.findAllPairs(t, pairs);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        size_t recovered = 0;
+        for (const auto& p : planted) {
+            DuplicatePair key = { p.first, p.second, 0 };
+            recovered += binary_search(pairs.begin(), pairs.end(), key, [](const DuplicatePair& a, const DuplicatePair& b) {
+                return a.first != b.first ? a.first < b.first : a.second < b.second;
+            });
+        }
+        cout << "Full pass, " << t << " thread(s): " << seconds << " s, " << pairs.size() << " pairs, "
+             << recovered << "/" << planted.size() << " planted duplicates found\n";
+        if (t == threads) break;
+    }
+
+    const size_t checks = 1000;
+    vector<DuplicateMatch> matches;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < checks; i++) {
+        matches.clear();
+        detector.findMatches(prints[next() % patients], UINT32_MAX, matches);
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Registration check: " << ms / checks << " ms average\n";
+}
@@ -0,0 +1,92 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>         // For normalized fields
+#include <string_view>    // For phone numbers held outside a string
+#include <vector>         // For rows and results
+#include <unordered_map>  // For blocking key -> rows
+#include <cstdint>        // For fixed-width types
+using namespace std;
+
+// Normalized identifying fields of one patient
+struct PatientFingerprint {
+    string name;          // Lowercase name words without titles ("john smith")
+    string firstSound;    // Soundex of first name
+    string lastSound;     // Soundex of last name
+    int birthYear = 0;    // Derived from age
+    char gender = '?';    // 'M', 'F' or '?'
+    string phone;         // Normalized phone number
+    string address;       // Normalized address
+    int bloodGroup = -1;  // Blood group code, -1 if unknown
+};
+
+// Builds a fingerprint from registration details
+PatientFingerprint makeFingerprint(const string& name, int age, const string& gender,
+                                   string_view phone, const string& address, const string& bloodGroup);
+
+// American Soundex code of a word ("Smyth" -> "S530")
+string soundex(const string& word);
+
+// Name similarity from typo (edit) distance: 1 - edits / longer length
+double nameSimilarity(const string& a, const string& b);
+
+// Duplicate likelihood of two fingerprints (0..1)
+double duplicateScore(const PatientFingerprint& a, const PatientFingerprint& b);
+
+// Probable duplicate of a given patient
+struct DuplicateMatch {
+    uint32_t row;  // Row of the existing patient
+    double score;  // Duplicate likelihood
+};
+
+// Probable duplicate pair found by a full pass
+struct DuplicatePair {
+    uint32_t first, second;  // Rows, first < second
+    double score;            // Duplicate likelihood
+};
+
+// Finds probable duplicate patients.
+// Only patients sharing a blocking key are compared: phonetic surname + first
+// initial + birth year (neighbouring years are probed to allow for birthdays),
+// or phone number. Keys are hashed to 64 bits; a collision only adds a
+// candidate that scoring rejects.
+class DuplicateDetector {
+private:
+    static const size_t BLOCK_PROBE_LIMIT = 256;  // Most recent rows checked per block at registration
+    static const size_t PAIR_WINDOW = 64;         // Neighbours compared per row in oversized blocks
+
+    unordered_map<uint64_t, vector<uint32_t>> blocks;  // Blocking key -> rows in insertion order
+    vector<PatientFingerprint> fingerprints;           // Row -> fingerprint
+    vector<bool> present;                              // Row -> indexed
+
+    // Blocking keys a fingerprint is stored under
+    static void storedKeys(const PatientFingerprint& print, vector<uint64_t>& keys);
+
+    // Blocking keys a fingerprint is looked up under (includes neighbouring birth years)
+    static void probeKeys(const PatientFingerprint& print, vector<uint64_t>& keys);
+
+public:
+    // Score at or above which two patients are reported
+    static constexpr double THRESHOLD = 0.75;
+
+    // Indexes (or re-indexes) the patient at row
+    void add(uint32_t row, const PatientFingerprint& print);
+
+    // Removes the patient at row
+    void remove(uint32_t row);
+
+    // Probable duplicates of a new or existing patient, best first (skips excludeRow)
+    void findMatches(const PatientFingerprint& print, uint32_t excludeRow, vector<DuplicateMatch>& matches) const;
+
+    // All probable duplicate pairs, blocks split across worker threads
+    void findAllPairs(unsigned threads, vector<DuplicatePair>& pairs) const;
+
+    // Number of indexed patients
+    size_t size() const;
+
+    // Heap bytes used by the detector
+    size_t memoryUsage() const;
+};
+
+// Times a parallel pass and registration checks over generated patients
+void runDeduplicationBenchmark(size_t patients, unsigned threads);
@@ -0,0 +1,114 @@
+#include "hospital.h"  // Includes the main hospital system header
+#include "workload.h"  // For generated patients and a quiet console
+#include <iomanip>     // For the results table
+
+// ========== BYTES PER PATIENT ========== //
+
+// Budget for one patient with a typical history, indexes included. 10 million
+// such patients then need 10M x 2 KB = 20 GB, which leaves most of a 64 GB
+// server for the rest of the system. Conditions, drug names and dosages are
+// references into the intern table, so repeated text is not counted per
+// patient; dates are packed into four bytes each.
+static const size_t PATIENT_BYTE_BUDGET = 2048;
+
+// History depths measured: a new patient, a typical one (budgeted) and a chronic one
+static const size_t FOOTPRINT_DEPTHS[] = { 0, 4, 16 };
+static const size_t BUDGETED_DEPTH = 4;
+
+// Builds a hospital with generated patients of the given history depth and
+// measures it with the memory report. Each visit books an appointment; every
+// second visit adds a two-drug prescription and every third a medical record
+// with a test result. Each patient has two long-term conditions. Visits start
+// on a random day in the last five years and follow every 2 to 16 weeks, in
+// quarter-hour clinic slots. The intern table is shared by the whole program,
+// so its size before the build is returned in earlierInternBytes for the
+// caller to take off.
+static MemoryReport measureDepth(size_t patients, size_t visits, size_t& earlierInternBytes) {
+    static const char* conditions[] = { "Hypertension", "Type 2 diabetes", "Asthma", "Hypothyroidism",
+                                        "Osteoarthritis", "Migraine", "Chronic kidney disease", "Anaemia" };
+    static const char* drugs[] = { "Metformin 500mg", "Amlodipine 5mg", "Salbutamol inhaler", "Levothyroxine 50mcg",
+                                   "Paracetamol 500mg", "Atorvastatin 20mg" };
+    static const char* dosages[] = { "Once daily", "Twice daily", "Two puffs as needed", "Once daily before breakfast" };
+    PopulationBuilder people(2024);
+    const PackedDateTime firstDay = packDateTime("01/01/2021");
+    const uint32_t minutesPerDay = 24 * 60;
+
+    earlierInternBytes = internTable().memoryUsage();
+    HospitalSystem hospital;
+    people.addDoctors(hospital, 20);
+    for (size_t i = 0; i < patients; i++) {
+        Patient* patient = hospital.newPatient(people.patient(100000 + static_cast<int>(i),
+                                                              1 + static_cast<int>(people.pick(20))));
+        hospital.addPatient(patient);
+        for (int c = 0; c < 2; c++) hospital.addDisease(patient, conditions[people.pick(8)]);
+        uint32_t day = static_cast<uint32_t>(people.pick(5 * 365));
+        for (size_t visit = 0; visit < visits; visit++) {
+            int doctorId = 1 + static_cast<int>(people.pick(20));
+            uint32_t slot = 8 * 60 + 15 * static_cast<uint32_t>(people.pick(36));  // 08:00 to 16:45
+            string when = formatDateTime(firstDay + day * minutesPerDay + slot);
+            day += 14 + static_cast<uint32_t>(people.pick(99));
+            hospital.scheduleAppointment(patient, doctorId, when);
+            if (visit % 2 == 1) {
+                patient->addPrescription(doctorId, when);
+                Prescription* prescription;
+                patient->getPrescription(Prescription::getNextId() - 1, prescription);
+                for (int d = 0; d < 2; d++) {
+                    prescription->addMedication(drugs[people.pick(6)], dosages[people.pick(4)]);
+                }
+                patient->markCollectionsChanged();
+            }
+            if (visit % 3 == 2) {
+                hospital.addMedicalRecord(patient, doctorId, conditions[people.pick(8)],
+                                          "Continue current medication; review in three months");
+                hospital.addTestResult(patient, MedicalRecord::getNextId() - 1, "HbA1c 6.8%, creatinine normal");
+            }
+        }
+    }
+    MemoryReport report;
+    hospital.collectMemoryUsage(report);
+    return report;
+}
+
+// Reports bytes per patient at several history depths and checks the typical
+// depth against the budget; true if it fits
+bool runFootprintBenchmark(size_t patients) {
+    patients = max<size_t>(patients, 1);
+    cout << "\nMeasuring " << patients << " generated patients per history depth...\n";
+    vector<MemoryReport> reports;
+    vector<size_t> earlierInternBytes(size(FOOTPRINT_DEPTHS));
+    {
+        ConsoleSilencer quiet;
+        for (size_t i = 0; i < size(FOOTPRINT_DEPTHS); i++) {
+            reports.push_back(measureDepth(patients, FOOTPRINT_DEPTHS[i], earlierInternBytes[i]));
+        }
+    }
+
+    bool passed = true;
+    cout << "\n" << setw(7) << "Visits" << setw(10) << "Profile" << setw(14) << "Appointments" << setw(15)
+         << "Prescriptions" << setw(10) << "Records" << setw(10) << "Total" << setw(12) << "10M (GB)"
+         << setw(8) << "Budget" << "\n";
+    for (size_t i = 0; i < reports.size(); i++) {
+        const MemoryReport& report = reports[i];
+        auto perPatient = [&](Subsystem subsystem) {
+            size_t bytes = report.byteCount(subsystem);
+            if (subsystem == Subsystem::Persons) bytes -= earlierInternBytes[i];  // Counted under the run that added it
+            return bytes / patients;
+        };
+        size_t total = perPatient(Subsystem::Persons) + perPatient(Subsystem::Appointments) +
+                       perPatient(Subsystem::Prescriptions) + perPatient(Subsystem::Records);
+        bool budgeted = FOOTPRINT_DEPTHS[i] == BUDGETED_DEPTH;
+        if (budgeted && total > PATIENT_BYTE_BUDGET) passed = false;
+        cout << setw(7) << FOOTPRINT_DEPTHS[i] << setw(10) << perPatient(Subsystem::Persons) << setw(14)
+             << perPatient(Subsystem::Appointments) << setw(15) << perPatient(Subsystem::Prescriptions) << setw(10)
+             << perPatient(Subsystem::Records) << setw(10) << total << fixed << setprecision(1) << setw(12)
+             << total * 1e7 / 1e9 << setw(8) << (budgeted ? (total <= PATIENT_BYTE_BUDGET ? "PASS" : "FAIL") : "-")
+             << "\n";
+        cout.unsetf(ios::floatfield);
+        cout << setprecision(6);
+    }
+    cout << "\nBytes per patient, indexes included (billing and inventory are not per patient).\n";
+    cout << "Shared text is counted once, by the depth that first added it to the intern table.\n";
+    cout << (passed ? "A typical patient fits the budget of " : "FAILED: a typical patient exceeds the budget of ")
+         << PATIENT_BYTE_BUDGET << " bytes.\n";
+    return passed;
+}
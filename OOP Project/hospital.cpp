@@ -1,20 +1,212 @@
 #include "hospital.h"  // Includes the main hospital system header file containing class declarations
+#include <algorithm>   // For sorting ranked results
+#include <iomanip>     // For the lookup filter report
+#include "varint.h"    // For checkpoint counters
 
 // HospitalSystem implementation
 
+// Identifying fields of a patient for duplicate detection
+static PatientFingerprint fingerprintOf(const Patient* patient) {
+    return makeFingerprint(patient->getName(), patient->getAge(), patient->getGender(),
+                           patient->getContactNumber(), patient->getAddress(), patient->getBloodGroup());
+}
+
+// Records where the object in a pool slot sits in its registry (its checkpoint position)
+static void rememberPosition(vector<uint32_t>& positions, uint32_t slot, size_t position) {
+    if (positions.size() <= slot) positions.resize(slot + 1);
+    positions[slot] = static_cast<uint32_t>(position);
+}
+
+// Returns stable handle for a pooled patient
+PoolHandle HospitalSystem::handleOf(const Patient* patient) const {
+    return patientPool.handleOf(patient);
+}
+
+// Resolves a patient handle (nullptr if the patient was released)
+Patient* HospitalSystem::getPatient(PoolHandle handle) const {
+    return patientPool.get(handle);
+}
+
+// Releases every entity in one step
+void HospitalSystem::releaseAll() {
+    persons.clear();    // Registries hold non-owning pointers
+    medicines.clear();
+    rooms.clear();
+    bills.clear();
+    patientColumns = PatientColumns();  // Mirrors refer to released persons
+    staffColumns = StaffColumns();
+    allPersonIds = RoaringBitmap();     // Indexes refer to released persons
+    bloodGroupIndex = CategoryIndex();
+    genderIndex = CategoryIndex();
+    departmentIndex = CategoryIndex();
+    for (auto& bitmap : donorsByBloodGroup) bitmap = RoaringBitmap();
+    clinicalText = TextIndex();
+    nameIndex = NameIndex();
+    contactIndex = ContactIndex();
+    duplicateDetector = DuplicateDetector();
+    coldText = ColdTextStore();  // Entities holding references are gone too
+    patientTier.close();         // Segment files are discarded with their patients
+    patientFilter.clear();       // Filters refer to released entities
+    doctorFilter.clear();
+    nurseFilter.clear();
+    medicineFilter.clear();
+    billFilter.clear();
+    medicineVersions.clear();    // Snapshot rows are copies of released entities
+    roomVersions.clear();
+    billVersions.clear();
+    commandLog.clear();          // Commands point to released entities
+    changedObjects.clear();      // Positions refer to released entities
+    patientPositions.clear();
+    doctorPositions.clear();
+    nursePositions.clear();
+    medicinePositions.clear();
+    roomPositions.clear();
+    billPositions.clear();
+    columnarEnabled = false;
+    patientPool.clear();  // Each pool frees its chunks at once
+    doctorPool.clear();
+    nursePool.clear();
+    medicinePool.clear();
+    roomPool.clear();
+    billPool.clear();
+}
+
 // Adds a patient to the system
 void HospitalSystem::addPatient(Patient* patient) {
     persons.push_back(patient);  // Stores patient pointer in the persons vector
+    rememberPosition(patientPositions, patientPool.handleOf(patient).index, persons.size() - 1);
+    noteChanged(patient);  // Profile and collections both go into the next save
+    noteCollectionsChanged(patient);
+    indexPerson(patient);  // Updates categorical bitmap indexes
+    patientFilter.add(static_cast<uint64_t>(patient->getId()));
+    duplicateDetector.add(patientPool.handleOf(patient).index, fingerprintOf(patient));
+    if (patientTier.isEnabled()) {
+        patientTier.attach(patient);  // New patients start resident
+    }
+    if (columnarEnabled) {
+        patientColumns.append(*patient);  // Keeps columnar mirror in sync
+    }
+    Mutation mutation(MutationType::RegisterPatient);
+    mutation.addInt(patient->getId()).addText(patient->getName()).addInt(patient->getAge())
+            .addText(patient->getGender()).addText(patient->getAddress()).addText(patient->getContactNumber())
+            .addText(patient->getBloodGroup()).addInt(patient->getAssignedDoctorId());
+    const vector<InternedString>& diseases = patient->getDiseases();
+    mutation.addInt(static_cast<int64_t>(diseases.size()));
+    for (const auto& disease : diseases) mutation.addText(disease.str());
+    ship(mutation);
 }
 
 // Adds a doctor to the system
 void HospitalSystem::addDoctor(Doctor* doctor) {
     persons.push_back(doctor);  // Stores doctor pointer in the persons vector
+    rememberPosition(doctorPositions, doctorPool.handleOf(doctor).index, persons.size() - 1);
+    noteChanged(doctor);
+    indexPerson(doctor);  // Updates categorical bitmap indexes
+    doctorFilter.add(static_cast<uint64_t>(doctor->getId()));
+    if (columnarEnabled) {
+        staffColumns.append(*doctor);  // Keeps columnar mirror in sync
+    }
+    ship(Mutation(MutationType::RegisterDoctor)
+             .addInt(doctor->getId()).addText(doctor->getName()).addInt(doctor->getAge())
+             .addText(doctor->getGender()).addText(doctor->getAddress()).addText(doctor->getContactNumber())
+             .addDouble(doctor->getSalary()).addText(doctor->getDepartment()).addText(doctor->getJoinDate())
+             .addText(doctor->getSpecialization()).addText(doctor->getLicenseNumber()));
 }
 
 // Adds a nurse to the system
 void HospitalSystem::addNurse(Nurse* nurse) {
     persons.push_back(nurse);  // Stores nurse pointer in the persons vector
+    rememberPosition(nursePositions, nursePool.handleOf(nurse).index, persons.size() - 1);
+    noteChanged(nurse);
+    indexPerson(nurse);  // Updates categorical bitmap indexes
+    nurseFilter.add(static_cast<uint64_t>(nurse->getId()));
+    if (columnarEnabled) {
+        staffColumns.append(*nurse);  // Keeps columnar mirror in sync
+    }
+    ship(Mutation(MutationType::RegisterNurse)
+             .addInt(nurse->getId()).addText(nurse->getName()).addInt(nurse->getAge())
+             .addText(nurse->getGender()).addText(nurse->getAddress()).addText(nurse->getContactNumber())
+             .addDouble(nurse->getSalary()).addText(nurse->getDepartment()).addText(nurse->getJoinDate())
+             .addText(nurse->getShiftTime()).addText(nurse->getQualification()));
+}
+
+// Adds a newly registered person to the categorical indexes
+void HospitalSystem::indexPerson(Person* person) {
+    allPersonIds.add(static_cast<uint32_t>(person->getId()));
+    nameIndex.add(static_cast<uint32_t>(persons.size() - 1), person->getName());  // Position of this person
+    contactIndex.add(person, person->getContactNumber(), person->getAddress());
+    genderIndex.add(person->getId(), person->getGender());
+    if (Patient* patient = dynamic_cast<Patient*>(person)) {
+        bloodGroupIndex.add(patient->getId(), patient->getBloodGroup());
+        int code = bloodGroupCode(patient->getBloodGroup());
+        if (code >= 0) {
+            donorsByBloodGroup[code].add(static_cast<uint32_t>(persons.size() - 1));  // Position of this patient
+        }
+    } else if (Staff* staff = dynamic_cast<Staff*>(person)) {
+        departmentIndex.add(staff->getId(), staff->getDepartment());
+    }
+}
+
+// Typo-tolerant name lookup over all registered persons
+void HospitalSystem::searchByName(const string& query, size_t maxResults,
+                                  vector<pair<Person*, double>>& matches) const {
+    vector<NameMatch> found;
+    nameIndex.search(query, maxResults, found);
+    for (const auto& match : found) {
+        matches.push_back({ persons[match.row], match.score });
+    }
+}
+
+// Updates a person's contact details and the reverse indexes
+void HospitalSystem::updateContactInfo(Person* person, const string& newAddress, const string& newContact) {
+    string oldAddress = person->getAddress();
+    string oldContact(person->getContactNumber());
+    person->updateContactInfo(newAddress, newContact);
+    contactIndex.update(person, oldContact, oldAddress, newContact, newAddress);
+    char kind = 'D';  // Lets the standby resolve the ID the way the menus did
+    if (Patient* patient = dynamic_cast<Patient*>(person)) {
+        duplicateDetector.add(patientPool.handleOf(patient).index, fingerprintOf(patient));
+        kind = 'P';
+    } else if (dynamic_cast<Nurse*>(person)) {
+        kind = 'N';
+    }
+    noteChanged(person);
+    ship(Mutation(MutationType::UpdateContactInfo).addInt(kind).addInt(person->getId())
+             .addText(newAddress).addText(newContact));
+}
+
+// People registered under a phone number (any formatting)
+const vector<Person*>& HospitalSystem::findByPhone(const string& phone) const {
+    return contactIndex.findByPhone(phone);
+}
+
+// People registered at an address (case, punctuation and street suffix insensitive)
+const vector<Person*>& HospitalSystem::findByAddress(const string& address) const {
+    return contactIndex.findByAddress(address);
+}
+
+// Probable earlier registrations of a patient, best first
+void HospitalSystem::checkDuplicates(const Patient* patient, vector<pair<Patient*, double>>& matches) const {
+    vector<DuplicateMatch> found;
+    duplicateDetector.findMatches(fingerprintOf(patient), patientPool.handleOf(patient).index, found);
+    for (const auto& match : found) {
+        matches.push_back({ patientPool.at(match.row), match.score });
+    }
+}
+
+// All probable duplicate patient pairs
+void HospitalSystem::findDuplicatePatients(unsigned threads, vector<DuplicatePair>& pairs) const {
+    duplicateDetector.findAllPairs(threads, pairs);
+}
+
+// Resolves a detector row to its patient
+Patient* HospitalSystem::patientForRow(uint32_t row) const {
+    return patientPool.at(row);
+}
+
+// Frees a patient that was created but never registered
+void HospitalSystem::discardPatient(Patient* patient) {
+    patientPool.destroy(patient);
 }
 
 // Displays all registered persons (patients, doctors, nurses)
@@ -32,84 +224,102 @@ void HospitalSystem::displayAllPersons() const {
 
 // Finds a patient by ID using dynamic casting
 void HospitalSystem::findPatient(int id, Patient*& patient) {
+    patient = nullptr;  // Returns null if not found
+    if (!patientFilter.mightContain(static_cast<uint64_t>(id))) return;  // No such patient was registered
     for (auto& person : persons) {
         if (person->getId() == id) {  // Checks ID match
             patient = dynamic_cast<Patient*>(person);  // Safe downcasting
             return;
         }
     }
-    patient = nullptr;  // Returns null if not found
+    patientFilter.reportFalsePositive();
 }
 
 // Finds a doctor by ID using dynamic casting
 void HospitalSystem::findDoctor(int id, Doctor*& doctor) {
+    doctor = nullptr;  // Returns null if not found
+    if (!doctorFilter.mightContain(static_cast<uint64_t>(id))) return;  // No such doctor was registered
     for (auto& person : persons) {
         if (person->getId() == id) {  // Checks ID match
             doctor = dynamic_cast<Doctor*>(person);  // Safe downcasting
             return;
         }
     }
-    doctor = nullptr;  // Returns null if not found
+    doctorFilter.reportFalsePositive();
 }
 
 // Finds a nurse by ID using dynamic casting
 void HospitalSystem::findNurse(int id, Nurse*& nurse) {
+    nurse = nullptr;  // Returns null if not found
+    if (!nurseFilter.mightContain(static_cast<uint64_t>(id))) return;  // No such nurse was registered
     for (auto& person : persons) {
         if (person->getId() == id) {  // Checks ID match
             nurse = dynamic_cast<Nurse*>(person);  // Safe downcasting
             return;
         }
     }
-    nurse = nullptr;  // Returns null if not found
+    nurseFilter.reportFalsePositive();
 }
 
 // Adds medicine to inventory
 void HospitalSystem::addMedicine(Medicine* medicine) {
     medicines.push_back(medicine);  // Stores medicine in inventory
+    rememberPosition(medicinePositions, medicinePool.handleOf(medicine).index, medicines.size() - 1);
+    noteChanged(medicine);
+    medicineFilter.add(static_cast<uint64_t>(medicine->getId()));
+    medicine->setVersions(&medicineVersions, medicineVersions.insert(*medicine));
+    ship(Mutation(MutationType::AddMedicine).addInt(medicine->getId()).addText(medicine->getName())
+             .addDouble(medicine->getPrice()).addInt(medicine->getQuantity()).addText(medicine->getExpiryDate()));
     cout << "\nMedicine added successfully!\n";  // Confirmation message
 }
 
-// Displays all medicines in inventory
+// Displays all medicines in inventory as of one point in time
 void HospitalSystem::displayAllMedicines() const {
     displayHeader("MEDICINE INVENTORY");  // Formatted header
-    if (medicines.empty()) {
-        cout << "No medicines in inventory.\n";  // Empty case handling
-        return;
-    }
-    for (const auto& med : medicines) {
-        med->displayDetails();  // Shows medicine details
+    ReadSnapshot snapshot(snapshotEpochs);  // Stock changes made meanwhile are not mixed in
+    size_t shown = 0;
+    medicineVersions.forEachAt(snapshot.getTimestamp(), [&shown](const Medicine& med) {
+        med.displayDetails();  // Shows medicine details
         cout << "------------------------\n";  // Separator
-    }
+        shown++;
+    });
+    if (!shown) cout << "No medicines in inventory.\n";  // Empty case handling
 }
 
 // Finds medicine by ID
 void HospitalSystem::findMedicine(int id, Medicine*& med) {
+    med = nullptr;  // Returns null if not found
+    if (!medicineFilter.mightContain(static_cast<uint64_t>(id))) return;  // Not in the inventory
     for (auto& m : medicines) {
         if (m->getId() == id) {  // Checks ID match
             med = m;  // Returns found medicine
             return;
         }
     }
-    med = nullptr;  // Returns null if not found
+    medicineFilter.reportFalsePositive();
 }
 
 // Adds a room to the system
 void HospitalSystem::addRoom(Room* room) {
     rooms.push_back(room);  // Stores room in system
+    rememberPosition(roomPositions, roomPool.handleOf(room).index, rooms.size() - 1);
+    noteChanged(room);
+    room->setVersions(&roomVersions, roomVersions.insert(*room));
+    ship(Mutation(MutationType::AddRoom).addInt(room->getId()).addText(room->getType()));
     cout << "\nRoom added successfully!\n";  // Confirmation message
 }
 
-// Displays all rooms and their status
+// Displays all rooms and their status as of one point in time
 void HospitalSystem::displayAllRooms() const {
     displayHeader("ROOM STATUS");  // Formatted header
-    if (rooms.empty()) {
-        cout << "No rooms available.\n";  // Empty case handling
-        return;
-    }
-    for (const auto& room : rooms) {
-        room->displayDetails();  // Shows room details
+    ReadSnapshot snapshot(snapshotEpochs);  // Admissions made meanwhile are not mixed in
+    size_t shown = 0;
+    roomVersions.forEachAt(snapshot.getTimestamp(), [&shown](const Room& room) {
+        room.displayDetails();  // Shows room details
         cout << "------------------------\n";  // Separator
-    }
+        shown++;
+    });
+    if (!shown) cout << "No rooms available.\n";  // Empty case handling
 }
 
 // Finds room by ID
@@ -124,43 +334,1177 @@ void HospitalSystem::findRoom(int id, Room*& room) {
 }
 
 // Finds first available room of specified type
-void HospitalSystem::findAvailableRoom(const string& type, Room*& room) {
+void HospitalSystem::findAvailableRoom(string_view type, Room*& room) {
+    room = nullptr;  // Returns null if none available
+    const string* wanted = internTable().find(type);  // Types are interned, so one address per type
+    if (!wanted) return;  // No room has ever had this type
     for (auto& r : rooms) {
-        if (r->getType() == type && r->getStatus() == "Vacant") {  // Checks type and status
+        if (&r->getType() == wanted && r->getStatus() == RoomStatus::Vacant) {  // Checks type and status
             room = r;  // Returns available room
             return;
         }
     }
-    room = nullptr;  // Returns null if none available
 }
 
 // Creates a new bill for a patient
 void HospitalSystem::createBill(int patientId, Billing*& bill) {
-    bill = new Billing(patientId);  // Creates new bill instance
+    bill = billPool.create(patientId);  // Creates new bill in the billing pool
     bills.push_back(bill);  // Adds to billing records
+    rememberPosition(billPositions, billPool.handleOf(bill).index, bills.size() - 1);
+    noteChanged(bill);
+    billFilter.add(static_cast<uint64_t>(patientId));
+    bill->setVersions(&billVersions, billVersions.insert(*bill));
+    ship(Mutation(MutationType::CreateBill).addInt(bill->getId()).addInt(patientId));
     cout << "\nNew bill created for patient " << patientId << "\n";  // Confirmation
 }
 
-// Displays all billing records
+// Displays all billing records as of one point in time
 void HospitalSystem::displayAllBills() const {
     displayHeader("BILLING RECORDS");  // Formatted header
-    if (bills.empty()) {
-        cout << "No billing records.\n";  // Empty case handling
-        return;
-    }
-    for (const auto& bill : bills) {
-        bill->displayBill();  // Shows detailed bill
+    ReadSnapshot snapshot(snapshotEpochs);  // Charges and payments made meanwhile are not mixed in
+    size_t shown = 0;
+    billVersions.forEachAt(snapshot.getTimestamp(), [&shown](const Billing& bill) {
+        bill.displayBill();  // Shows detailed bill
         cout << "------------------------\n";  // Separator
-    }
+        shown++;
+    });
+    if (!shown) cout << "No billing records.\n";  // Empty case handling
 }
 
 // Finds unpaid bill for a patient
 void HospitalSystem::findPatientBill(int patientId, Billing*& bill) {
+    bill = nullptr;  // Returns null if not found
+    if (!billFilter.mightContain(static_cast<uint64_t>(patientId))) return;  // Patient was never billed
+    bool billed = false;
     for (auto& b : bills) {
-        if (b->getPatientId() == patientId && b->getPaymentStatus() == "Unpaid") {  // Checks patient ID and status
+        if (b->getPatientId() != patientId) continue;
+        billed = true;
+        if (b->getPaymentStatus() == PaymentStatus::Unpaid) {  // Checks status
             bill = b;  // Returns unpaid bill
             return;
         }
     }
-    bill = nullptr;  // Returns null if not found
-}
\ No newline at end of file
+    if (!billed) billFilter.reportFalsePositive();  // Paid bills are a true match
+}
+
+// Builds the columnar mirrors from all registered persons
+void HospitalSystem::enableColumnarStore() {
+    if (columnarEnabled) return;  // Already built
+    for (const auto& person : persons) {
+        if (Patient* patient = dynamic_cast<Patient*>(person)) {
+            patientColumns.append(*patient);
+        } else if (Staff* staff = dynamic_cast<Staff*>(person)) {
+            staffColumns.append(*staff);
+        }
+    }
+    columnarEnabled = true;
+}
+
+// Returns true once the columnar mirror is built
+bool HospitalSystem::isColumnarEnabled() const { return columnarEnabled; }
+
+// Finds IDs of all patients matching the filter using the columnar mirror
+void HospitalSystem::queryPatients(const PatientFilter& filter, vector<int>& patientIds) {
+    enableColumnarStore();  // Built on first use
+    patientColumns.query(filter, patientIds);
+}
+
+// Finds IDs of all staff matching the filter using the columnar mirror
+void HospitalSystem::queryStaff(const StaffFilter& filter, vector<int>& staffIds) {
+    enableColumnarStore();  // Built on first use
+    staffColumns.query(filter, staffIds);
+}
+
+// Corrects a patient's blood group and keeps indexes in sync
+void HospitalSystem::updateBloodGroup(Patient* patient, const string& newBloodGroup) {
+    bloodGroupIndex.update(patient->getId(), patient->getBloodGroup(), newBloodGroup);
+
+    // Move the patient's registration position between donor bitmaps (rare, so a scan is acceptable)
+    for (size_t pos = 0; pos < persons.size(); pos++) {
+        if (persons[pos] != patient) continue;
+        int oldCode = bloodGroupCode(patient->getBloodGroup());
+        int newCode = bloodGroupCode(newBloodGroup);
+        if (oldCode >= 0) donorsByBloodGroup[oldCode].remove(static_cast<uint32_t>(pos));
+        if (newCode >= 0) donorsByBloodGroup[newCode].add(static_cast<uint32_t>(pos));
+        break;
+    }
+    patient->setBloodGroup(newBloodGroup);
+    patientColumns.update(*patient);  // No-op unless mirrored
+    duplicateDetector.add(patientPool.handleOf(patient).index, fingerprintOf(patient));
+    noteChanged(patient);
+    ship(Mutation(MutationType::UpdateBloodGroup).addInt(patient->getId()).addText(newBloodGroup));
+    cout << "\nBlood group updated to " << newBloodGroup << "\n";  // Confirmation
+}
+
+// Moves a staff member to another department and keeps indexes in sync
+void HospitalSystem::transferDepartment(Staff* staff, const string& newDepartment) {
+    departmentIndex.update(staff->getId(), staff->getDepartment(), newDepartment);
+    staff->setDepartment(newDepartment);
+    staffColumns.update(*staff);  // No-op unless mirrored
+    noteChanged(staff);
+    ship(Mutation(MutationType::TransferDepartment).addInt(dynamic_cast<Nurse*>(staff) ? 'N' : 'D')
+             .addInt(staff->getId()).addText(newDepartment));
+    cout << "\nTransferred to " << newDepartment << " department\n";  // Confirmation
+}
+
+// Evaluates an attribute expression such as
+// "blood=AB- AND gender=Female AND NOT dept=Cardiology" left to right.
+// Fields: blood, gender, dept. Returns false if the expression is malformed.
+bool HospitalSystem::queryCategories(const string& expression, vector<int>& personIds) const {
+    // Split into words; consecutive non-keyword words form one term (values may contain spaces)
+    vector<string> words;
+    string word;
+    for (char c : expression + " ") {
+        if (c == ' ') {
+            if (!word.empty()) words.push_back(word);
+            word.clear();
+        } else {
+            word += c;
+        }
+    }
+
+    RoaringBitmap result;
+    string pendingOp = "";  // Operator joining the next term to the result ("" before first term)
+    bool negate = false;
+    size_t i = 0;
+    while (i < words.size()) {
+        if (words[i] == "AND" || words[i] == "OR") {
+            if (pendingOp == "TERM" && !negate) {
+                pendingOp = words[i++];
+                continue;
+            }
+            return false;  // Operator without a preceding term, or right after NOT
+        }
+        if (words[i] == "NOT") {
+            negate = !negate;
+            i++;
+            continue;
+        }
+
+        // Collect the term "field=value with spaces"
+        string term = words[i++];
+        while (i < words.size() && words[i] != "AND" && words[i] != "OR" && words[i] != "NOT") {
+            term += " " + words[i++];
+        }
+        size_t eq = term.find('=');
+        if (eq == string::npos) return false;
+        string field = term.substr(0, eq), value = term.substr(eq + 1);
+
+        const RoaringBitmap* bitmap;
+        if (field == "blood") bitmap = &bloodGroupIndex.lookup(value);
+        else if (field == "gender") bitmap = &genderIndex.lookup(value);
+        else if (field == "dept") bitmap = &departmentIndex.lookup(value);
+        else return false;  // Unknown field
+
+        RoaringBitmap operand = negate ? allPersonIds.andNot(*bitmap) : *bitmap;
+        if (pendingOp == "") result = operand;
+        else if (pendingOp == "AND") result = result & operand;
+        else if (pendingOp == "OR") result = result | operand;
+        else return false;  // Two terms without an operator
+        pendingOp = "TERM";  // Expect an operator next
+        negate = false;
+    }
+    if (pendingOp != "TERM" || negate) return false;  // Empty, or a dangling operator or NOT
+    result.toVector(personIds);
+    return true;
+}
+
+// Finds patients whose blood can be given to the recipient.
+// Walks each compatible group's bitmap from the newest registration backwards and
+// stops after maxResults candidates, so cost does not grow with population size.
+void HospitalSystem::findCompatibleDonors(const Patient* recipient, size_t maxResults,
+                                          vector<Patient*>& donors) const {
+    uint8_t mask = compatibleDonorMask(bloodGroupCode(recipient->getBloodGroup()));
+    vector<pair<uint32_t, Patient*>> available, admitted;  // (registration position, patient)
+
+    for (int group = 0; group < BLOOD_GROUP_COUNT; group++) {
+        if (!(mask & (1 << group))) continue;
+        size_t taken = 0;
+        donorsByBloodGroup[group].visitDescending([&](uint32_t pos) {
+            Patient* candidate = static_cast<Patient*>(persons[pos]);  // Only patients are in these bitmaps
+            if (candidate == recipient) return true;
+            if (candidate->getRoomId() == -1) {
+                available.emplace_back(pos, candidate);
+                taken++;
+            } else if (admitted.size() < maxResults) {
+                admitted.emplace_back(pos, candidate);  // Fallback if too few are available
+            }
+            return taken < maxResults;
+        });
+    }
+
+    // Newest first within each availability tier
+    auto newestFirst = [](const pair<uint32_t, Patient*>& a, const pair<uint32_t, Patient*>& b) {
+        return a.first > b.first;
+    };
+    sort(available.begin(), available.end(), newestFirst);
+    sort(admitted.begin(), admitted.end(), newestFirst);
+    for (const auto& tier : { &available, &admitted }) {
+        for (const auto& entry : *tier) {
+            if (donors.size() >= maxResults) return;
+            donors.push_back(entry.second);
+        }
+    }
+}
+
+// Re-indexes the text of one medical record
+void HospitalSystem::indexRecord(const MedicalRecord& record) {
+    vector<string> fields;
+    record.collectText(fields);
+    clinicalText.indexText(record.getPatientId(), TextSourceKind::Record, record.getId(), fields);
+}
+
+// Re-indexes the condition list of one patient
+void HospitalSystem::indexDiseases(const Patient* patient) {
+    vector<string> names;
+    patient->collectDiseases(names);
+    clinicalText.indexText(patient->getId(), TextSourceKind::Diseases, patient->getId(), names);
+}
+
+// Adds a condition to a patient and re-indexes the condition list
+void HospitalSystem::addDisease(Patient* patient, const string& disease) {
+    patient->addDisease(disease);
+    indexDiseases(patient);
+    noteChanged(patient);
+    ship(Mutation(MutationType::AddDisease).addInt(patient->getId()).addText(disease));
+}
+
+// Creates a medical record and indexes it
+void HospitalSystem::addMedicalRecord(Patient* patient, int doctorId, const string& diagnosis, const string& plan) {
+    int recordId = patient->addMedicalRecord(doctorId, diagnosis, plan);
+    const MedicalRecord* record;
+    patient->findMedicalRecord(recordId, record);
+    if (record) indexRecord(*record);
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::AddMedicalRecord).addInt(recordId).addInt(patient->getId()).addInt(doctorId)
+             .addText(diagnosis).addText(plan));
+}
+
+// Adds a test result to a record and re-indexes it
+void HospitalSystem::addTestResult(Patient* patient, int recordId, const string& result) {
+    MedicalRecord* record;
+    patient->getMedicalRecord(recordId, record);
+    if (!record) {
+        cout << "\nMedical record not found!\n";  // Error message
+        return;
+    }
+    record->addTestResult(result);
+    patient->markCollectionsChanged();
+    indexRecord(*record);
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::AddTestResult).addInt(patient->getId()).addInt(recordId).addText(result));
+}
+
+// Replaces a record's treatment plan and re-indexes it
+void HospitalSystem::updateTreatmentPlan(Patient* patient, int recordId, const string& newPlan) {
+    MedicalRecord* record;
+    patient->getMedicalRecord(recordId, record);
+    if (!record) {
+        cout << "\nMedical record not found!\n";  // Error message
+        return;
+    }
+    record->updateTreatmentPlan(newPlan);
+    patient->markCollectionsChanged();
+    indexRecord(*record);
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::UpdateTreatmentPlan).addInt(patient->getId()).addInt(recordId).addText(newPlan));
+}
+
+// Completes a doctor's appointment and indexes the diagnosis notes
+void HospitalSystem::completeAppointment(Doctor* doctor, int apptId, const string& notes) {
+    if (!doctor->completeAppointment(apptId, notes)) return;  // Not pending: nothing changed
+    Appointment* appt;
+    doctor->getAppointment(apptId, appt);
+    clinicalText.indexText(appt->getPatientId(), TextSourceKind::Appointment, apptId, { appt->getDiagnosisNotes() });
+    noteChanged(doctor);
+    ship(Mutation(MutationType::CompleteAppointment).addInt(doctor->getId()).addInt(apptId).addText(notes));
+}
+
+// Books an appointment for a patient
+int HospitalSystem::scheduleAppointment(Patient* patient, int doctorId, const string& dateTime) {
+    int apptId = patient->scheduleAppointment(doctorId, dateTime);
+    if (!apptId) return 0;  // Rejected date: nothing to save or ship
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::ScheduleAppointment).addInt(apptId).addInt(patient->getId()).addInt(doctorId)
+             .addText(dateTime));
+    return apptId;
+}
+
+// Opens an appointment slot for a doctor
+void HospitalSystem::addAvailableSlot(Doctor* doctor, const string& slot) {
+    doctor->addAvailableSlot(slot);
+    noteChanged(doctor);
+    ship(Mutation(MutationType::AddAvailableSlot).addInt(doctor->getId()).addText(slot));
+}
+
+// Admits a patient to a room
+void HospitalSystem::assignRoom(Patient* patient, Room* room) {
+    if (!room->assignPatient(patient->getId())) return;  // Occupied: nothing changed
+    patient->assignRoom(room->getId());
+    noteChanged(patient);
+    noteChanged(room);
+    ship(Mutation(MutationType::AssignRoom).addInt(patient->getId()).addInt(room->getId()));
+}
+
+// Discharges a patient from their room
+void HospitalSystem::dischargePatient(Patient* patient) {
+    Room* room;
+    findRoom(patient->getRoomId(), room);
+    if (room) {
+        room->vacateRoom();
+        noteChanged(room);
+    }
+    patient->dischargeFromRoom();
+    noteChanged(patient);
+    ship(Mutation(MutationType::DischargePatient).addInt(patient->getId()));
+}
+
+// Adds or deducts stock
+void HospitalSystem::updateStock(Medicine* medicine, int quantity) {
+    medicine->updateStock(quantity);
+    noteChanged(medicine);
+    ship(Mutation(MutationType::UpdateStock).addInt(medicine->getId()).addInt(quantity));
+}
+
+// Charges a service to a bill
+void HospitalSystem::addServiceToBill(Billing* bill, const string& service, double cost) {
+    bill->addService(service, cost);
+    noteChanged(bill);
+    ship(Mutation(MutationType::AddServiceToBill).addInt(bill->getId()).addText(service).addDouble(cost));
+}
+
+// Charges dispensed medicine to a bill and deducts it from stock as one change
+void HospitalSystem::addMedicineToBill(Billing* bill, Medicine* medicine, int quantity) {
+    beginUpdate();  // Reports see the charge and the stock change together
+    bill->addMedicine(medicine->getId(), quantity, medicine->getPrice());
+    medicine->updateStock(-quantity);
+    commitUpdate();
+    noteChanged(bill);
+    noteChanged(medicine);
+    ship(Mutation(MutationType::AddMedicineToBill).addInt(bill->getId()).addInt(medicine->getId()).addInt(quantity));
+}
+
+// Takes a payment against a bill
+void HospitalSystem::processPayment(Billing* bill, double amount) {
+    if (!bill->processPayment(amount)) return;  // Already paid or short: nothing changed
+    noteChanged(bill);
+    ship(Mutation(MutationType::ProcessPayment).addInt(bill->getId()).addDouble(amount));
+}
+
+// Removes a condition added by mistake and re-indexes the condition list
+void HospitalSystem::removeDisease(Patient* patient, const string& disease) {
+    patient->removeDisease(disease);
+    indexDiseases(patient);
+    noteChanged(patient);
+    ship(Mutation(MutationType::RemoveDisease).addInt(patient->getId()).addText(disease));
+}
+
+// Removes an appointment booked by mistake
+void HospitalSystem::removeAppointment(Patient* patient, int apptId) {
+    if (!patient->removeAppointment(apptId)) return;
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::RemoveAppointment).addInt(patient->getId()).addInt(apptId));
+}
+
+// Removes a medical record created by mistake and its text from the index
+void HospitalSystem::removeMedicalRecord(Patient* patient, int recordId) {
+    if (!patient->removeMedicalRecord(recordId)) return;
+    clinicalText.indexText(patient->getId(), TextSourceKind::Record, recordId, {});
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::RemoveMedicalRecord).addInt(patient->getId()).addInt(recordId));
+}
+
+// Drops a record's newest test result and re-indexes it
+void HospitalSystem::removeTestResult(Patient* patient, int recordId) {
+    MedicalRecord* record;
+    patient->getMedicalRecord(recordId, record);
+    if (!record || !record->removeLastTestResult()) return;
+    patient->markCollectionsChanged();
+    indexRecord(*record);
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::RemoveTestResult).addInt(patient->getId()).addInt(recordId));
+}
+
+// Puts back a record's previous treatment plan and re-indexes it
+void HospitalSystem::revertTreatmentPlan(Patient* patient, int recordId) {
+    MedicalRecord* record;
+    patient->getMedicalRecord(recordId, record);
+    if (!record || !record->revertTreatmentPlan()) return;
+    patient->markCollectionsChanged();
+    indexRecord(*record);
+    noteCollectionsChanged(patient);
+    ship(Mutation(MutationType::RevertTreatmentPlan).addInt(patient->getId()).addInt(recordId));
+}
+
+// Returns a completed appointment to pending and removes its notes from the index
+void HospitalSystem::reopenAppointment(Doctor* doctor, int apptId) {
+    Appointment* appt;
+    doctor->getAppointment(apptId, appt);
+    if (!appt || !doctor->reopenAppointment(apptId)) return;
+    clinicalText.indexText(appt->getPatientId(), TextSourceKind::Appointment, apptId, {});
+    noteChanged(doctor);
+    ship(Mutation(MutationType::ReopenAppointment).addInt(doctor->getId()).addInt(apptId));
+}
+
+// Withdraws an appointment slot
+void HospitalSystem::removeAvailableSlot(Doctor* doctor, const string& slot) {
+    doctor->removeAvailableSlot(slot);
+    noteChanged(doctor);
+    ship(Mutation(MutationType::RemoveAvailableSlot).addInt(doctor->getId()).addText(slot));
+}
+
+// Takes a service charge back off a bill
+void HospitalSystem::removeServiceFromBill(Billing* bill, const string& service, double cost) {
+    bill->removeService(service, cost);
+    noteChanged(bill);
+    ship(Mutation(MutationType::RemoveServiceFromBill).addInt(bill->getId()).addText(service).addDouble(cost));
+}
+
+// Takes a medicine charge back off a bill and returns the medicine to stock as one change
+void HospitalSystem::removeMedicineFromBill(Billing* bill, Medicine* medicine, int quantity) {
+    beginUpdate();  // Reports see the refund and the stock change together
+    bill->removeMedicine(medicine->getId(), quantity, medicine->getPrice());
+    medicine->updateStock(quantity);
+    commitUpdate();
+    noteChanged(bill);
+    noteChanged(medicine);
+    ship(Mutation(MutationType::RemoveMedicineFromBill).addInt(bill->getId()).addInt(medicine->getId())
+             .addInt(quantity));
+}
+
+// Marks a paid bill as unpaid again
+void HospitalSystem::refundPayment(Billing* bill) {
+    if (!bill->refundPayment()) return;  // Not paid: nothing changed
+    noteChanged(bill);
+    ship(Mutation(MutationType::RefundPayment).addInt(bill->getId()));
+}
+
+// Makes a change and keeps it for undo
+bool HospitalSystem::execute(unique_ptr<Command> command) {
+    if (!command->execute(*this)) return false;
+    commandLog.record(move(command));
+    return true;
+}
+
+// Reverses the most recent change; changes that cannot be taken back stop undo
+bool HospitalSystem::undo() {
+    Command* command = commandLog.nextUndo();
+    if (!command) {
+        cout << "\nNothing to undo.\n";
+        return false;
+    }
+    if (!command->isReversible()) {
+        cout << "\nCannot undo \"" << command->describe() << "\": it is permanent.\n";
+        return false;
+    }
+    cout << "\nUndoing: " << command->describe() << "\n";
+    command->undo(*this);
+    commandLog.markUndone();
+    return true;
+}
+
+// Makes the most recently undone change again
+bool HospitalSystem::redo() {
+    Command* command = commandLog.nextRedo();
+    if (!command) {
+        cout << "\nNothing to redo.\n";
+        return false;
+    }
+    cout << "\nRedoing: " << command->describe() << "\n";
+    if (!command->execute(*this)) {
+        cout << "\nThe change could not be made again.\n";
+        return false;
+    }
+    commandLog.markRedone();
+    return true;
+}
+
+// Changes how many changes can be undone
+void HospitalSystem::setHistoryLimit(size_t commands) { commandLog.setCapacity(commands); }
+
+// Undo/redo history (for display)
+const CommandLog& HospitalSystem::getCommandLog() const { return commandLog; }
+
+// Searches all indexed clinical text
+bool HospitalSystem::searchClinicalText(const string& query, vector<TextHit>& hits) const {
+    return clinicalText.search(query, hits);
+}
+
+// Sets how many idle days clinical text stays uncompressed
+void HospitalSystem::setColdTextAge(int days) { coldTextAgeDays = days; }
+
+// Idle days before clinical text is compressed
+int HospitalSystem::getColdTextAge() const { return coldTextAgeDays; }
+
+// Compresses clinical text idle for the configured age
+size_t HospitalSystem::compressColdText() {
+    time_t idleSince = time(nullptr) - static_cast<time_t>(coldTextAgeDays) * 24 * 60 * 60;
+    if (coldTextAgeDays == 0) idleSince++;  // Includes text touched this second
+    size_t frozen = 0;
+    patientPool.forEach([&](Patient& patient) { frozen += patient.freezeColdText(coldText, idleSince); });
+    doctorPool.forEach([&](Doctor& doctor) { frozen += doctor.freezeColdText(coldText, idleSince); });
+    coldText.seal();  // Leaves nothing uncompressed in a half-filled block
+    return frozen;
+}
+
+// Compressed clinical text store (for reporting)
+const ColdTextStore& HospitalSystem::getColdTextStore() const { return coldText; }
+
+// Keeps only the most recently used patients' collections in memory (or resizes the resident set)
+bool HospitalSystem::enableTieredStorage(const string& directory, size_t residentPatients) {
+    if (patientTier.isEnabled()) {
+        patientTier.setCapacity(residentPatients);
+        return true;
+    }
+    if (!patientTier.open(directory, residentPatients)) return false;
+    for (const auto& person : persons) {  // Registration order, so the newest stay resident
+        if (Patient* patient = dynamic_cast<Patient*>(person)) patientTier.attach(patient);
+    }
+    return true;
+}
+
+// Loads every patient's collections back and deletes the segment files
+void HospitalSystem::disableTieredStorage() {
+    if (!patientTier.isEnabled()) return;
+    patientTier.setCapacity(SIZE_MAX);  // Nothing is unloaded while patients are read back
+    patientPool.forEach([&](Patient& patient) { patientTier.detach(&patient); });
+    patientTier.close();
+}
+
+// Tiered patient storage (for reporting)
+const PatientTier& HospitalSystem::getPatientTier() const { return patientTier; }
+
+// Rebuilds every lookup filter for a new false-positive rate
+void HospitalSystem::setLookupFilterRate(double falsePositiveRate) {
+    lookupFilterRate = falsePositiveRate;
+    patientFilter = BloomFilter(falsePositiveRate);
+    doctorFilter = BloomFilter(falsePositiveRate);
+    nurseFilter = BloomFilter(falsePositiveRate);
+    medicineFilter = BloomFilter(falsePositiveRate);
+    billFilter = BloomFilter(falsePositiveRate);
+    for (const auto& person : persons) {
+        uint64_t id = static_cast<uint64_t>(person->getId());
+        if (dynamic_cast<Patient*>(person)) patientFilter.add(id);
+        else if (dynamic_cast<Doctor*>(person)) doctorFilter.add(id);
+        else if (dynamic_cast<Nurse*>(person)) nurseFilter.add(id);
+    }
+    for (const auto& med : medicines) medicineFilter.add(static_cast<uint64_t>(med->getId()));
+    for (const auto& bill : bills) billFilter.add(static_cast<uint64_t>(bill->getPatientId()));
+}
+
+// Starts a new replication log; changes from now on are shipped
+bool HospitalSystem::startShipping(const string& logPath) { return replicationLog.open(logPath); }
+
+// Continues an existing log after its last sequence number
+bool HospitalSystem::resumeShipping(const string& logPath, uint64_t lastSequence) {
+    return replicationLog.open(logPath, true, lastSequence);
+}
+
+// Stops shipping changes
+void HospitalSystem::stopShipping() { replicationLog.close(); }
+
+// Replication log (for reporting)
+const LogShipper& HospitalSystem::getReplicationLog() const { return replicationLog; }
+
+// Ships a completed change and saves a checkpoint when one is due
+void HospitalSystem::ship(Mutation& mutation) {
+    if (replicationLog.isOpen() && !replicationLog.ship(mutation)) {
+        cout << "\nWarning: could not write to replication log " << replicationLog.getPath() << "\n";
+    }
+    if (checkpointing && time(nullptr) - lastCheckpoint >= checkpointInterval && !saveCheckpoint()) {
+        cout << "\nWarning: could not save checkpoint to " << checkpoints.getDirectory() << "\n";
+    }
+}
+
+// Replays a shipped change. Entities are created with the primary's IDs and
+// targets are found by ID the same way the menus find them.
+bool HospitalSystem::applyMutation(const Mutation& mutation) {
+    MutationReader args(mutation);
+    switch (mutation.type) {
+        case MutationType::RegisterPatient: {
+            int id = static_cast<int>(args.nextInt());
+            string name = args.nextText();
+            int age = static_cast<int>(args.nextInt());
+            string gender = args.nextText(), address = args.nextText(), contact = args.nextText();
+            string bloodGroup = args.nextText();
+            int doctorId = static_cast<int>(args.nextInt());
+            Patient* patient = newPatient(id, name, age, gender, address, contact, bloodGroup, doctorId);
+            for (int64_t count = args.nextInt(); count > 0; count--) patient->addDisease(args.nextText());
+            addPatient(patient);
+            return true;
+        }
+        case MutationType::RegisterDoctor:
+        case MutationType::RegisterNurse: {
+            int id = static_cast<int>(args.nextInt());
+            string name = args.nextText();
+            int age = static_cast<int>(args.nextInt());
+            string gender = args.nextText(), address = args.nextText(), contact = args.nextText();
+            double salary = args.nextDouble();
+            string department = args.nextText(), joinDate = args.nextText();
+            string first = args.nextText(), second = args.nextText();
+            if (mutation.type == MutationType::RegisterDoctor) {
+                addDoctor(newDoctor(id, name, age, gender, address, contact, salary, department, joinDate, first, second));
+            } else {
+                addNurse(newNurse(id, name, age, gender, address, contact, salary, department, joinDate, first, second));
+            }
+            return true;
+        }
+        case MutationType::AddMedicine: {
+            Medicine::setNextId(static_cast<int>(args.nextInt()));
+            string name = args.nextText();
+            double price = args.nextDouble();
+            int quantity = static_cast<int>(args.nextInt());
+            addMedicine(newMedicine(name, price, quantity, args.nextText()));
+            return true;
+        }
+        case MutationType::AddRoom:
+            Room::setNextId(static_cast<int>(args.nextInt()));
+            addRoom(newRoom(args.nextText()));
+            return true;
+        case MutationType::CreateBill: {
+            Billing::setNextId(static_cast<int>(args.nextInt()));
+            Billing* bill;
+            createBill(static_cast<int>(args.nextInt()), bill);
+            return true;
+        }
+        default:
+            break;
+    }
+
+    // Everything else changes an existing entity
+    switch (mutation.type) {
+        case MutationType::UpdateContactInfo: {
+            char kind = static_cast<char>(args.nextInt());
+            int id = static_cast<int>(args.nextInt());
+            Person* person = nullptr;
+            if (kind == 'P') { Patient* p; findPatient(id, p); person = p; }
+            else if (kind == 'N') { Nurse* n; findNurse(id, n); person = n; }
+            else { Doctor* d; findDoctor(id, d); person = d; }
+            if (!person) return false;
+            string address = args.nextText();
+            updateContactInfo(person, address, args.nextText());
+            return true;
+        }
+        case MutationType::TransferDepartment: {
+            char kind = static_cast<char>(args.nextInt());
+            int id = static_cast<int>(args.nextInt());
+            Staff* staff = nullptr;
+            if (kind == 'N') { Nurse* n; findNurse(id, n); staff = n; }
+            else { Doctor* d; findDoctor(id, d); staff = d; }
+            if (!staff) return false;
+            transferDepartment(staff, args.nextText());
+            return true;
+        }
+        case MutationType::AddAvailableSlot:
+        case MutationType::CompleteAppointment:
+        case MutationType::RemoveAvailableSlot:
+        case MutationType::ReopenAppointment: {
+            Doctor* doctor;
+            findDoctor(static_cast<int>(args.nextInt()), doctor);
+            if (!doctor) return false;
+            if (mutation.type == MutationType::AddAvailableSlot) {
+                addAvailableSlot(doctor, args.nextText());
+            } else if (mutation.type == MutationType::RemoveAvailableSlot) {
+                removeAvailableSlot(doctor, args.nextText());
+            } else if (mutation.type == MutationType::ReopenAppointment) {
+                reopenAppointment(doctor, static_cast<int>(args.nextInt()));
+            } else {
+                int apptId = static_cast<int>(args.nextInt());
+                completeAppointment(doctor, apptId, args.nextText());
+            }
+            return true;
+        }
+        case MutationType::ScheduleAppointment:
+        case MutationType::AddMedicalRecord: {
+            int newId = static_cast<int>(args.nextInt());
+            Patient* patient;
+            findPatient(static_cast<int>(args.nextInt()), patient);
+            if (!patient) return false;
+            int doctorId = static_cast<int>(args.nextInt());
+            string text = args.nextText();
+            // A redone change reuses an older ID, so the counter never moves back
+            if (mutation.type == MutationType::ScheduleAppointment) {
+                int next = max(Appointment::getNextId(), newId + 1);
+                Appointment::setNextId(newId);
+                scheduleAppointment(patient, doctorId, text);
+                Appointment::setNextId(next);
+            } else {
+                int next = max(MedicalRecord::getNextId(), newId + 1);
+                MedicalRecord::setNextId(newId);
+                addMedicalRecord(patient, doctorId, text, args.nextText());
+                MedicalRecord::setNextId(next);
+            }
+            return true;
+        }
+        case MutationType::UpdateBloodGroup:
+        case MutationType::AddDisease:
+        case MutationType::AddTestResult:
+        case MutationType::UpdateTreatmentPlan:
+        case MutationType::AssignRoom:
+        case MutationType::DischargePatient:
+        case MutationType::RemoveDisease:
+        case MutationType::RemoveAppointment:
+        case MutationType::RemoveMedicalRecord:
+        case MutationType::RemoveTestResult:
+        case MutationType::RevertTreatmentPlan: {
+            Patient* patient;
+            findPatient(static_cast<int>(args.nextInt()), patient);
+            if (!patient) return false;
+            if (mutation.type == MutationType::UpdateBloodGroup) {
+                updateBloodGroup(patient, args.nextText());
+            } else if (mutation.type == MutationType::AddDisease) {
+                addDisease(patient, args.nextText());
+            } else if (mutation.type == MutationType::AddTestResult) {
+                int recordId = static_cast<int>(args.nextInt());
+                addTestResult(patient, recordId, args.nextText());
+            } else if (mutation.type == MutationType::UpdateTreatmentPlan) {
+                int recordId = static_cast<int>(args.nextInt());
+                updateTreatmentPlan(patient, recordId, args.nextText());
+            } else if (mutation.type == MutationType::AssignRoom) {
+                Room* room;
+                findRoom(static_cast<int>(args.nextInt()), room);
+                if (!room) return false;
+                assignRoom(patient, room);
+            } else if (mutation.type == MutationType::DischargePatient) {
+                dischargePatient(patient);
+            } else if (mutation.type == MutationType::RemoveDisease) {
+                removeDisease(patient, args.nextText());
+            } else {
+                int id = static_cast<int>(args.nextInt());
+                if (mutation.type == MutationType::RemoveAppointment) removeAppointment(patient, id);
+                else if (mutation.type == MutationType::RemoveMedicalRecord) removeMedicalRecord(patient, id);
+                else if (mutation.type == MutationType::RemoveTestResult) removeTestResult(patient, id);
+                else revertTreatmentPlan(patient, id);
+            }
+            return true;
+        }
+        case MutationType::UpdateStock: {
+            Medicine* medicine;
+            findMedicine(static_cast<int>(args.nextInt()), medicine);
+            if (!medicine) return false;
+            updateStock(medicine, static_cast<int>(args.nextInt()));
+            return true;
+        }
+        case MutationType::AddServiceToBill:
+        case MutationType::AddMedicineToBill:
+        case MutationType::ProcessPayment:
+        case MutationType::RemoveServiceFromBill:
+        case MutationType::RemoveMedicineFromBill:
+        case MutationType::RefundPayment: {
+            int billId = static_cast<int>(args.nextInt());
+            Billing* bill = nullptr;
+            for (auto* candidate : bills) {
+                if (candidate->getId() == billId) {
+                    bill = candidate;
+                    break;
+                }
+            }
+            if (!bill) return false;
+            if (mutation.type == MutationType::AddServiceToBill) {
+                string service = args.nextText();
+                addServiceToBill(bill, service, args.nextDouble());
+            } else if (mutation.type == MutationType::RemoveServiceFromBill) {
+                string service = args.nextText();
+                removeServiceFromBill(bill, service, args.nextDouble());
+            } else if (mutation.type == MutationType::AddMedicineToBill ||
+                       mutation.type == MutationType::RemoveMedicineFromBill) {
+                Medicine* medicine;
+                findMedicine(static_cast<int>(args.nextInt()), medicine);
+                if (!medicine) return false;
+                int quantity = static_cast<int>(args.nextInt());
+                if (mutation.type == MutationType::AddMedicineToBill) addMedicineToBill(bill, medicine, quantity);
+                else removeMedicineFromBill(bill, medicine, quantity);
+            } else if (mutation.type == MutationType::RefundPayment) {
+                refundPayment(bill);
+            } else {
+                processPayment(bill, args.nextDouble());
+            }
+            return true;
+        }
+        default:
+            return false;  // Unknown type (a newer primary)
+    }
+}
+
+// Checkpoint tables; persons, their collections, medicines, rooms and bills
+// are keyed by position in their registry, so restoring keeps registration order
+enum CheckpointTable : uint8_t {
+    CountersTable = 0,     // Next ID of every auto-numbered entity
+    PersonsTable,          // Patient, doctor or nurse (tagged P, D or N)
+    CollectionsTable,      // A patient's appointments, prescriptions and records
+    MedicinesTable,
+    RoomsTable,
+    BillsTable
+};
+
+// Checkpoint key of an object: table in the high half, registry position in the low half
+static uint64_t checkpointKey(CheckpointTable table, uint32_t position) {
+    return static_cast<uint64_t>(table) << 32 | position;
+}
+
+// Lists a changed person for the next delta (only while checkpoint files are open)
+void HospitalSystem::noteChanged(const Person* person) {
+    if (!checkpoints.isOpen()) return;
+    uint32_t position;
+    if (const Patient* patient = dynamic_cast<const Patient*>(person)) {
+        position = patientPositions[patientPool.handleOf(patient).index];
+    } else if (const Nurse* nurse = dynamic_cast<const Nurse*>(person)) {
+        position = nursePositions[nursePool.handleOf(nurse).index];
+    } else {
+        position = doctorPositions[doctorPool.handleOf(static_cast<const Doctor*>(person)).index];
+    }
+    changedObjects.push_back(checkpointKey(PersonsTable, position));
+}
+
+// Lists a patient whose appointments, prescriptions or records changed
+void HospitalSystem::noteCollectionsChanged(const Patient* patient) {
+    if (!checkpoints.isOpen()) return;
+    changedObjects.push_back(checkpointKey(CollectionsTable, patientPositions[patientPool.handleOf(patient).index]));
+}
+
+// Lists a changed medicine
+void HospitalSystem::noteChanged(const Medicine* medicine) {
+    if (!checkpoints.isOpen()) return;
+    changedObjects.push_back(checkpointKey(MedicinesTable, medicinePositions[medicinePool.handleOf(medicine).index]));
+}
+
+// Lists a changed room
+void HospitalSystem::noteChanged(const Room* room) {
+    if (!checkpoints.isOpen()) return;
+    changedObjects.push_back(checkpointKey(RoomsTable, roomPositions[roomPool.handleOf(room).index]));
+}
+
+// Lists a changed bill
+void HospitalSystem::noteChanged(const Billing* bill) {
+    if (!checkpoints.isOpen()) return;
+    changedObjects.push_back(checkpointKey(BillsTable, billPositions[billPool.handleOf(bill).index]));
+}
+
+// Encodes every object (or only the listed ones still marked changed) for a checkpoint
+void HospitalSystem::collectCheckpoint(bool everything, vector<CheckpointRecord>& records) const {
+    CheckpointRecord counters{ CountersTable, 0, {} };  // Always saved, so restored IDs never repeat
+    for (int next : { Appointment::getNextId(), Prescription::getNextId(), MedicalRecord::getNextId(),
+                      Medicine::getNextId(), Room::getNextId(), Billing::getNextId() }) {
+        writeSigned(counters.state, next);
+    }
+    records.push_back(move(counters));
+
+    // Encodes one object under its key; unless saving everything, skips it if already saved
+    auto encode = [&](CheckpointTable table, uint32_t pos) {
+        CheckpointRecord record{ table, pos, {} };
+        switch (table) {
+            case PersonsTable: {
+                const Person* person = persons[pos];
+                if (!everything && !person->isChanged()) return;
+                record.state.push_back(dynamic_cast<const Patient*>(person) ? 'P'
+                                       : dynamic_cast<const Nurse*>(person) ? 'N' : 'D');
+                person->writeTo(record.state);
+                break;
+            }
+            case CollectionsTable: {
+                const Patient* patient = static_cast<const Patient*>(persons[pos]);
+                if (!everything && !patient->areCollectionsChanged()) return;
+                patient->saveCollections(record.state);
+                break;
+            }
+            case MedicinesTable:
+                if (!everything && !medicines[pos]->isChanged()) return;
+                medicines[pos]->writeTo(record.state);
+                break;
+            case RoomsTable:
+                if (!everything && !rooms[pos]->isChanged()) return;
+                rooms[pos]->writeTo(record.state);
+                break;
+            case BillsTable:
+                if (!everything && !bills[pos]->isChanged()) return;
+                bills[pos]->writeTo(record.state);
+                break;
+            default:
+                return;
+        }
+        records.push_back(move(record));
+    };
+
+    if (!everything) {  // A delta visits only what the mutators listed
+        for (uint64_t key : changedObjects) {
+            encode(static_cast<CheckpointTable>(key >> 32), static_cast<uint32_t>(key));
+        }
+        return;
+    }
+    for (uint32_t pos = 0; pos < persons.size(); pos++) {
+        encode(PersonsTable, pos);
+        if (dynamic_cast<const Patient*>(persons[pos])) encode(CollectionsTable, pos);
+    }
+    for (uint32_t pos = 0; pos < medicines.size(); pos++) encode(MedicinesTable, pos);
+    for (uint32_t pos = 0; pos < rooms.size(); pos++) encode(RoomsTable, pos);
+    for (uint32_t pos = 0; pos < bills.size(); pos++) encode(BillsTable, pos);
+}
+
+// Clears the change flags once a checkpoint holds the current state: every
+// flag after a full save, only the listed objects' after a delta
+void HospitalSystem::markCheckpointSaved(bool everything) {
+    if (everything) {
+        for (auto* person : persons) {
+            person->markSaved();
+            if (Patient* patient = dynamic_cast<Patient*>(person)) patient->markCollectionsSaved();
+        }
+        for (auto* medicine : medicines) medicine->markSaved();
+        for (auto* room : rooms) room->markSaved();
+        for (auto* bill : bills) bill->markSaved();
+    } else {
+        for (uint64_t key : changedObjects) {
+            uint32_t pos = static_cast<uint32_t>(key);
+            switch (static_cast<CheckpointTable>(key >> 32)) {
+                case PersonsTable: persons[pos]->markSaved(); break;
+                case CollectionsTable: static_cast<Patient*>(persons[pos])->markCollectionsSaved(); break;
+                case MedicinesTable: medicines[pos]->markSaved(); break;
+                case RoomsTable: rooms[pos]->markSaved(); break;
+                case BillsTable: bills[pos]->markSaved(); break;
+                default: break;
+            }
+        }
+    }
+    changedObjects.clear();
+}
+
+// Starts checkpointing to a directory with a full base
+bool HospitalSystem::enableCheckpoints(const string& directory, int intervalSeconds) {
+    if (!checkpoints.open(directory)) return false;
+    checkpoints.reset();  // Files from another system would mix with this one's
+    checkpointInterval = max(intervalSeconds, 1);
+    checkpointing = true;
+    return saveCheckpoint(true);
+}
+
+// Rebuilds an empty system from the base and deltas in a directory, then keeps
+// saving deltas there
+bool HospitalSystem::restoreCheckpoint(const string& directory, int intervalSeconds) {
+    CheckpointImage image;
+    if (!persons.empty() || !checkpoints.open(directory) || !checkpoints.load(image)) {
+        checkpoints.close();
+        return false;
+    }
+    vector<int> counters;
+    for (const auto& entry : image) {
+        const vector<uint8_t>& state = entry.second;
+        uint32_t slot = static_cast<uint32_t>(entry.first);
+        size_t pos = 0;
+        switch (static_cast<uint8_t>(entry.first >> 32)) {
+            case CountersTable:
+                while (pos < state.size()) counters.push_back(static_cast<int>(readSigned(state, pos)));
+                break;
+            case PersonsTable:
+                pos = 1;
+                if (state[0] == 'P') {
+                    Patient* patient = newPatient(Patient::readFrom(state, pos));
+                    addPatient(patient);
+                    if (!patient->getDiseases().empty()) indexDiseases(patient);
+                } else if (state[0] == 'N') {
+                    addNurse(newNurse(Nurse::readFrom(state, pos)));
+                } else {
+                    Doctor* doctor = newDoctor(Doctor::readFrom(state, pos));
+                    addDoctor(doctor);
+                    for (const auto& appt : doctor->getAppointments()) {
+                        if (appt.getStatus() != AppointmentStatus::Completed) continue;
+                        clinicalText.indexText(appt.getPatientId(), TextSourceKind::Appointment, appt.getId(),
+                                               { appt.getDiagnosisNotes() });
+                    }
+                }
+                break;
+            case CollectionsTable: {
+                Patient* patient = slot < persons.size() ? dynamic_cast<Patient*>(persons[slot]) : nullptr;
+                if (!patient) break;
+                patient->loadCollections(state);
+                for (const auto& record : patient->getMedicalRecords()) indexRecord(record);
+                break;
+            }
+            case MedicinesTable: {  // Restored like bills: no confirmation printed and nothing shipped
+                Medicine* medicine = newMedicine(Medicine::readFrom(state, pos));
+                medicines.push_back(medicine);
+                rememberPosition(medicinePositions, medicinePool.handleOf(medicine).index, medicines.size() - 1);
+                medicineFilter.add(static_cast<uint64_t>(medicine->getId()));
+                medicine->setVersions(&medicineVersions, medicineVersions.insert(*medicine));
+                break;
+            }
+            case RoomsTable: {
+                Room* room = newRoom(Room::readFrom(state, pos));
+                rooms.push_back(room);
+                rememberPosition(roomPositions, roomPool.handleOf(room).index, rooms.size() - 1);
+                room->setVersions(&roomVersions, roomVersions.insert(*room));
+                break;
+            }
+            case BillsTable: {
+                Billing* bill = billPool.create(Billing::readFrom(state, pos));
+                bills.push_back(bill);
+                rememberPosition(billPositions, billPool.handleOf(bill).index, bills.size() - 1);
+                billFilter.add(static_cast<uint64_t>(bill->getPatientId()));
+                bill->setVersions(&billVersions, billVersions.insert(*bill));
+                break;
+            }
+        }
+    }
+    if (counters.size() >= 6) {  // Restored entities took IDs from the counters; put them back
+        Appointment::setNextId(counters[0]);
+        Prescription::setNextId(counters[1]);
+        MedicalRecord::setNextId(counters[2]);
+        Medicine::setNextId(counters[3]);
+        Room::setNextId(counters[4]);
+        Billing::setNextId(counters[5]);
+    }
+    markCheckpointSaved(true);
+    checkpointInterval = max(intervalSeconds, 1);
+    checkpointing = true;
+    lastCheckpoint = time(nullptr);
+    return true;
+}
+
+// Stops periodic saves (files are kept)
+void HospitalSystem::disableCheckpoints() {
+    checkpointing = false;
+    checkpoints.close();
+    changedObjects.clear();  // Enabling again starts with a full base
+}
+
+// Writes changed objects (or everything). Deltas are merged once they take as
+// much space as the base (rewriting it costs about as much as they saved) or
+// once there are enough of them to slow a restore.
+bool HospitalSystem::saveCheckpoint(bool full) {
+    if (!checkpoints.isOpen()) return false;
+    vector<CheckpointRecord> records;
+    full = full || !checkpoints.hasBase();
+    sort(changedObjects.begin(), changedObjects.end());  // Objects changed repeatedly are listed once
+    changedObjects.erase(unique(changedObjects.begin(), changedObjects.end()), changedObjects.end());
+    collectCheckpoint(full, records);
+    if (!full && records.size() == 1) {  // Only the ID counters, which change only with new objects
+        changedObjects.clear();
+        lastCheckpoint = time(nullptr);
+        return true;
+    }
+    if (!(full ? checkpoints.writeBase(records) : checkpoints.writeDelta(records))) return false;
+    markCheckpointSaved(full);
+    lastCheckpoint = time(nullptr);
+    if (checkpoints.deltaCount() >= compactAfterDeltas ||
+        checkpoints.deltaBytesOnDisk() >= checkpoints.baseBytesOnDisk()) {
+        return checkpoints.compact();
+    }
+    return true;
+}
+
+// Merges the deltas into a new base
+bool HospitalSystem::compactCheckpoints() { return checkpoints.compact(); }
+
+// True while periodic saves are on
+bool HospitalSystem::isCheckpointing() const { return checkpointing; }
+
+// Checkpoint files (for reporting)
+const CheckpointStore& HospitalSystem::getCheckpointStore() const { return checkpoints; }
+
+// Displays checkpoint files, schedule and I/O figures
+void HospitalSystem::displayCheckpointReport() const {
+    cout << "\n=== CHECKPOINTS ===\n";
+    if (!checkpoints.isOpen()) {
+        cout << "Checkpoints are off.\n";
+        return;
+    }
+    cout << "Saving:             " << (checkpointing ? "every " + to_string(checkpointInterval) + " s of activity"
+                                                     : string("stopped")) << "\n";
+    if (checkpointing) {
+        cout << "Last save:          " << time(nullptr) - lastCheckpoint << " s ago\n";
+    }
+    checkpoints.displayReport();
+}
+
+// Opens a group of changes; nested calls join the outer group
+void HospitalSystem::beginUpdate() { snapshotEpochs.beginWrite(); }
+
+// Commits the group, so snapshots see all of its changes at once
+void HospitalSystem::commitUpdate() { snapshotEpochs.endWrite(); }
+
+// Displays commit clock, active snapshots and version figures
+void HospitalSystem::displaySnapshotReport() const {
+    cout << "\n=== REPORT SNAPSHOTS ===\n";
+    cout << "Commits so far:       " << snapshotEpochs.now() << "\n";
+    cout << "Open snapshots:       " << snapshotEpochs.activeReaders() << "\n";
+    cout << "Versioned rows:       " << medicineVersions.size() << " medicines, " << roomVersions.size()
+         << " rooms, " << billVersions.size() << " bills\n";
+    cout << "Old versions waiting: " << snapshotEpochs.retainedVersions() << " (at most "
+         << snapshotEpochs.peakRetainedVersions() << ")\n";
+    cout << "Old versions freed:   " << snapshotEpochs.reclaimedVersions() << "\n";
+    cout << "Current versions:     " << medicineVersions.memoryUsage() + roomVersions.memoryUsage() +
+            billVersions.memoryUsage() << " bytes\n";
+}
+
+// Target false-positive rate of the lookup filters
+double HospitalSystem::getLookupFilterRate() const { return lookupFilterRate; }
+
+// Displays keys, memory and hit figures of every lookup filter
+void HospitalSystem::displayLookupFilterReport() const {
+    cout << "\n=== LOOKUP FILTERS ===\n";
+    cout << left << setw(12) << "Filter" << right << setw(10) << "Keys" << setw(12) << "Bytes"
+         << setw(10) << "Lookups" << setw(10) << "Rejected" << setw(10) << "False+" << setw(11) << "Observed"
+         << setw(10) << "Target" << "\n";
+    patientFilter.displayRow("Patients");
+    doctorFilter.displayRow("Doctors");
+    nurseFilter.displayRow("Nurses");
+    medicineFilter.displayRow("Medicines");
+    billFilter.displayRow("Bills");
+    cout << right << "Total filter memory: " << patientFilter.memoryUsage() + doctorFilter.memoryUsage() +
+            nurseFilter.memoryUsage() + medicineFilter.memoryUsage() + billFilter.memoryUsage() << " bytes\n";
+}
+
+// Collects memory usage of every entity owned by the system
+void HospitalSystem::collectMemoryUsage(MemoryReport& report) const {
+    for (const auto& person : persons) {
+        person->reportMemory(report);  // Polymorphic accounting per person type
+    }
+    for (const auto& med : medicines) {
+        report.record(Subsystem::Inventory, "Medicine", med->memoryUsage());
+    }
+    for (const auto& room : rooms) {
+        report.record(Subsystem::Inventory, "Room", room->memoryUsage());
+    }
+    for (const auto& bill : bills) {
+        report.record(Subsystem::Billing, "Billing", bill->memoryUsage());
+    }
+
+    // Pool chunks not occupied by live objects (free slots and bookkeeping)
+    report.addOverhead(Subsystem::Persons, patientPool.overheadBytes() +
+                       doctorPool.overheadBytes() + nursePool.overheadBytes());
+    report.addOverhead(Subsystem::Inventory, medicinePool.overheadBytes() + roomPool.overheadBytes());
+    report.addOverhead(Subsystem::Billing, billPool.overheadBytes());
+
+    // Secondary structures over persons
+    report.addOverhead(Subsystem::Persons, patientColumns.memoryUsage() + staffColumns.memoryUsage());
+    report.addOverhead(Subsystem::Persons, allPersonIds.memoryUsage() + bloodGroupIndex.memoryUsage() +
+                       genderIndex.memoryUsage() + departmentIndex.memoryUsage());
+    for (const auto& bitmap : donorsByBloodGroup) {
+        report.addOverhead(Subsystem::Persons, bitmap.memoryUsage());
+    }
+    report.addOverhead(Subsystem::Records, clinicalText.memoryUsage());
+    report.addOverhead(Subsystem::Persons, nameIndex.memoryUsage());
+    report.addOverhead(Subsystem::Persons, contactIndex.memoryUsage());
+    report.addOverhead(Subsystem::Persons, duplicateDetector.memoryUsage());
+    report.addOverhead(Subsystem::Persons, internTable().memoryUsage());  // Shared categorical values
+    report.addOverhead(Subsystem::Records, coldText.memoryUsage());
+    report.addOverhead(Subsystem::Persons, patientTier.memoryUsage());
+    report.addOverhead(Subsystem::Persons, patientFilter.memoryUsage() + doctorFilter.memoryUsage() +
+                       nurseFilter.memoryUsage());
+    report.addOverhead(Subsystem::Inventory, medicineFilter.memoryUsage());
+    report.addOverhead(Subsystem::Billing, billFilter.memoryUsage());
+    report.addOverhead(Subsystem::Inventory, medicineVersions.memoryUsage() + roomVersions.memoryUsage());
+    report.addOverhead(Subsystem::Billing, billVersions.memoryUsage());
+
+    // Pointer arrays held by the system itself
+    report.addOverhead(Subsystem::Persons, vectorBufferBytes(persons));
+    report.addOverhead(Subsystem::Inventory, vectorBufferBytes(medicines) + vectorBufferBytes(rooms));
+    report.addOverhead(Subsystem::Billing, vectorBufferBytes(bills));
+}
+
+// Displays memory usage report and remembers it for growth tracking
+void HospitalSystem::displayMemoryReport() {
+    displayHeader("MEMORY USAGE REPORT");  // Formatted header
+    MemoryReport report;
+    collectMemoryUsage(report);
+    report.display(lastMemoryReport);  // Shows growth since the previous report
+    lastMemoryReport = report;
+}
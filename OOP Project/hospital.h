@@ -5,6 +5,28 @@
 #include <vector>     // For dynamic array containers
 #include <ctime>      // For date/time handling
 #include <string>     // For string operations
+#include <string_view> // For lookups without copies
+#include <list>       // For LRU ordering
+#include <unordered_map> // For resident patient lookup
+#include "memory.h"   // For memory accounting
+#include "pool.h"     // For pooled entity storage
+#include "columnar.h" // For columnar patient store
+#include "bitmap_index.h" // For categorical bitmap indexes
+#include "blood_match.h"  // For blood compatibility rules
+#include "text_index.h"   // For clinical full-text search
+#include "name_index.h"   // For fuzzy name lookup
+#include "contact_index.h" // For caller identification
+#include "dedup.h"        // For duplicate patient detection
+#include "cold_text.h"    // For compressing unused clinical text
+#include "segment_store.h" // For per-patient segment files
+#include "bloom_filter.h"  // For rejecting lookups of unknown IDs
+#include "snapshot.h"      // For point-in-time report views
+#include "replication.h"   // For shipping changes to a standby
+#include "checkpoint.h"    // For incremental checkpoints
+#include "command_log.h"   // For undo/redo of menu changes
+#include "intern.h"        // For shared categorical values
+#include "inline_string.h" // For short identifiers stored in place
+#include "date_time.h"     // For packed appointment and prescription dates
 using namespace std;  // Standard namespace (note: generally avoided in headers)
 
 // Forward declarations of all classes to resolve circular dependencies
@@ -19,35 +41,106 @@ class Billing;
 class Appointment;
 class Prescription;
 class MedicalRecord;
+class PatientTier;
+
+// Fixed-size summary of a patient's collections. Profile views and ID lookups
+// read only this; the collections themselves may still be in a segment file.
+struct SegmentHeader {
+    uint32_t segment = 0;            // Segment file number (0 = none yet)
+    uint32_t appointmentCount = 0;   // Appointments in the collections
+    uint32_t prescriptionCount = 0;  // Prescriptions in the collections
+    uint32_t recordCount = 0;        // Medical records in the collections
+    bool loaded = true;              // Collections are in memory
+    bool dirty = true;               // Changed since the segment file was written
+};
+
+// Status state machines. Each entity moves between these states only through
+// its own methods, which reject a transition the table does not allow.
+
+// Room occupancy: Vacant <-> Occupied
+enum class RoomStatus : uint8_t { Vacant, Occupied };
+
+// Appointment lifecycle: Pending -> Completed or Cancelled; Completed -> Pending only when undone
+enum class AppointmentStatus : uint8_t { Pending, Completed, Cancelled };
+
+// Bill settlement: Unpaid -> Paid; Paid -> Unpaid only when refunded
+enum class PaymentStatus : uint8_t { Unpaid, Paid };
+
+// Display names ("Vacant", "Pending", "Unpaid", ...)
+const string& statusName(RoomStatus status);
+const string& statusName(AppointmentStatus status);
+const string& statusName(PaymentStatus status);
+
+// True if the state machine allows moving from one status to the other
+bool isValidTransition(RoomStatus from, RoomStatus to);
+bool isValidTransition(AppointmentStatus from, AppointmentStatus to);
+bool isValidTransition(PaymentStatus from, PaymentStatus to);
+
+// Short identifiers stored inside person records (capacity in characters)
+using ContactNumberText = InlineString<22>;  // "+92-300-1234567", "(555) 123-4567 x12"
+using LicenseNumberText = InlineString<15>;  // "PMDC-1000001"
+using ShiftTimeText = InlineString<15>;      // "Morning", "08:00-16:00"
 
 // Utility function declarations
 void clearScreen();                     // Clears console screen
+void setScreenClearing(bool enabled);   // Turns clearScreen on or off
 void displayHeader(const string& title);// Displays formatted section headers
 void pressEnterToContinue();            // Pauses execution until Enter key
+string readField(const string& prompt, bool (*isValid)(string_view), const string& rule);  // Asks until a line is accepted
+extern const string DATE_TIME_RULE;     // Shown when a date/time is rejected
 
 // Base Person class (abstract)
 class Person {
 protected:
     int id;                // Unique identifier
-    string name;           // Full name
     int age;               // Age in years
-    string gender;         // Gender identity
+    string name;           // Full name
+    InternedString gender; // Gender identity (shared)
     string address;        // Physical address
-    string contactNumber;  // Phone number
+    ContactNumberText contactNumber;  // Phone number
+    bool changed = true;   // Modified since the last checkpoint
 
 public:
     // Constructor initializes all basic person attributes
     Person(int id, string name, int age, string gender, string address, string contactNumber);
     
+    // Virtual destructor so derived objects are released correctly
+    virtual ~Person() = default;
+    
     // Pure virtual function makes this an abstract class
     virtual void displayDetails() const = 0;
     
-    // Updates contact information
-    void updateContactInfo(string newAddress, string newContact);
+    // Records this person's memory footprint (and owned collections) in the report
+    virtual void reportMemory(MemoryReport& report) const = 0;
+    
+    // Writes the full state for a checkpoint
+    virtual void writeTo(vector<uint8_t>& out) const = 0;
+    
+    // Checkpoint tracking (only changed people are rewritten)
+    bool isChanged() const;
+    void markSaved();
+    
+    // Updates contact information (the number is checked by the caller)
+    void updateContactInfo(string newAddress, string_view newContact);
+    
+    // Field rules applied where values are entered
+    static bool isValidGender(string_view gender);         // Letters, spaces, hyphens; 1-15 characters
+    static bool isValidContactNumber(string_view number);  // Digits and + - ( ) . x; at least 3 digits, up to 22 characters
     
     // Accessor methods
     int getId() const;
-    string getName() const;
+    const string& getName() const;
+    int getAge() const;
+    const string& getGender() const;
+    const string& getAddress() const;
+    string_view getContactNumber() const;
+
+protected:
+    // Heap bytes owned by the Person string fields
+    size_t personHeapBytes() const;
+    
+    // Serializes the Person fields
+    void writePersonFields(vector<uint8_t>& out) const;
 };
 
 // Staff base class (inherits from Person)
@@ -55,7 +148,7 @@ class Staff : public Person {
 protected:
     int staffId;         // Staff-specific ID
     double salary;       // Monthly compensation
-    string department;   // Department assignment
+    InternedString department;  // Department assignment (shared)
     string joinDate;     // Employment start date
 
 public:
@@ -65,6 +158,24 @@ public:
     
     // Displays staff details (override from Person)
     void displayDetails() const override;
+    
+    // Accessor methods
+    double getSalary() const;
+    const string& getDepartment() const;
+    const string& getJoinDate() const;
+    
+    // Moves staff member to another department
+    void setDepartment(const string& newDepartment);
+    
+    // Records staff memory footprint
+    void reportMemory(MemoryReport& report) const override;
+
+protected:
+    // Heap bytes owned by the Person and Staff string fields
+    size_t staffHeapBytes() const;
+    
+    // Serializes the Person and Staff fields
+    void writeStaffFields(vector<uint8_t>& out) const;
 };
 
 // Appointment management class
@@ -74,19 +185,38 @@ private:
     int appointmentId;       // Unique appointment ID
     int patientId;           // Associated patient
     int doctorId;            // Assigned doctor
-    string dateTime;         // Scheduled date/time
-    string status;           // Current status (Pending/Completed/Cancelled)
-    string diagnosisNotes;   // Doctor's notes
+    PackedDateTime dateTime; // Scheduled date/time
+    mutable string diagnosisNotes;  // Doctor's notes (empty while compressed)
+    mutable ColdTextStore* coldStore = nullptr;  // Store holding the notes while compressed
+    mutable ColdTextRef coldNotes;               // Location of the compressed notes
+    AppointmentStatus status = AppointmentStatus::Pending;  // Current status (fills the gap after coldNotes)
+    mutable time_t lastAccess;                   // Last time the notes were read or changed
+
+    // Empty appointment, filled in by readFrom
+    Appointment() = default;
+
+    // Restores compressed notes without marking them as used
+    void restoreText() const;
+
+    // Restores compressed notes and marks them as recently used
+    void touchText() const;
 
 public:
     // Constructor creates new appointment
-    Appointment(int pId, int dId, const string& dt);
+    Appointment(int pId, int dId, string_view dt);
+    
+    // Sets the ID the next appointment receives (a standby reuses the primary's IDs)
+    static void setNextId(int id);
+    static int getNextId();
     
-    // Marks appointment as complete with notes
-    void completeAppointment(const string& notes);
+    // Marks a pending appointment as complete with notes; false if not pending
+    bool completeAppointment(const string& notes);
     
-    // Cancels the appointment
-    void cancelAppointment();
+    // Cancels a pending appointment; false if not pending
+    bool cancelAppointment();
+    
+    // Returns a completed appointment to pending and clears its notes (undo); false if not completed
+    bool reopenAppointment();
     
     // Shows appointment details
     void displayDetails() const;
@@ -95,7 +225,28 @@ public:
     int getId() const;
     int getPatientId() const;
     int getDoctorId() const;
-    string getStatus() const;
+    AppointmentStatus getStatus() const;
+    string getDiagnosisNotes() const;
+    
+    // Compresses the notes if unused since idleSince; returns true if compressed
+    bool freezeText(ColdTextStore& store, time_t idleSince);
+    
+    // Frees the compressed notes (before the appointment is dropped)
+    void releaseColdText() const;
+    
+    // Serialization (for segment files); compressed notes are written without restoring them
+    void writeTo(vector<uint8_t>& out) const;
+    static Appointment readFrom(const vector<uint8_t>& in, size_t& pos);
+    
+    // Object size plus owned heap memory in bytes
+    size_t memoryUsage() const;
+};
+
+// One line of a prescription. Drug names and dosages repeat across the whole
+// hospital, so both are kept once in the intern table.
+struct PrescribedDrug {
+    InternedString medication;  // Drug name
+    InternedString dosage;      // How it is taken
 };
 
 // Prescription management class
@@ -105,14 +256,20 @@ private:
     int prescriptionId;          // Unique prescription ID
     int patientId;               // Associated patient
     int doctorId;                // Prescribing doctor
-    vector<string> medications;  // List of prescribed drugs
-    vector<string> dosages;      // Corresponding dosages
-    string dateIssued;           // Creation date
+    PackedDateTime dateIssued;   // Creation date and time
+    vector<PrescribedDrug> drugs;  // Prescribed drugs with their dosages
+
+    // Empty prescription, filled in by readFrom
+    Prescription() = default;
 
 public:
     // Constructor creates new prescription
     Prescription(int pId, int dId, const string& date = "");
     
+    // ID the next prescription receives (restored from checkpoints)
+    static void setNextId(int id);
+    static int getNextId();
+    
     // Adds medication to prescription
     void addMedication(const string& med, const string& dosage);
     
@@ -121,6 +278,13 @@ public:
     
     // Accessor method
     int getId() const;
+    
+    // Serialization (for segment files)
+    void writeTo(vector<uint8_t>& out) const;
+    static Prescription readFrom(const vector<uint8_t>& in, size_t& pos);
+    
+    // Object size plus owned heap memory in bytes
+    size_t memoryUsage() const;
 };
 
 // Medical record management class
@@ -130,38 +294,91 @@ private:
     int recordId;                // Unique record ID
     int patientId;               // Associated patient
     int doctorId;                // Attending doctor
-    string diagnosis;            // Medical diagnosis
-    string treatmentPlan;        // Recommended treatment
-    vector<string> testReports;  // Lab/test results
+    // Clinical text (mutable so const readers can restore it after compression)
+    mutable string diagnosis;            // Medical diagnosis
+    mutable string treatmentPlan;        // Recommended treatment (current version)
+    mutable vector<string> testReports;  // Lab/test results
+    mutable vector<uint8_t> planHistory; // Earlier plans as reverse deltas, oldest first
+    int planRevisions = 0;               // Number of deltas in planHistory
+    mutable ColdTextStore* coldStore = nullptr;  // Store holding the text while compressed
+    mutable ColdTextRef coldText;                // Location of the compressed text
+    mutable time_t lastAccess;                   // Last time the text was read or changed
+
+    // Empty record, filled in by readFrom
+    MedicalRecord() = default;
+
+    // Restores compressed text without marking it as used
+    void restoreText() const;
+
+    // Restores compressed text and marks it as recently used
+    void touchText() const;
 
 public:
     // Constructor creates new medical record
-    MedicalRecord(int pId, int dId, const string& diag, const string& plan);
+    MedicalRecord(int pId, int dId, string diag, string plan);
+    
+    // Sets the ID the next record receives (a standby reuses the primary's IDs)
+    static void setNextId(int id);
+    static int getNextId();
     
     // Adds test result to record
     void addTestResult(const string& result);
     
-    // Updates treatment plan
+    // Updates treatment plan, keeping the previous version in the history
     void updateTreatmentPlan(const string& newPlan);
     
+    // Reversals used by undo: drops the newest test result, or restores the
+    // previous plan and forgets the revision; false if there is none
+    bool removeLastTestResult();
+    bool revertTreatmentPlan();
+    
     // Displays record details
     void display() const;
     
-    // Accessor method
+    // Treatment plan history (version 1 is the original plan)
+    int getPlanVersionCount() const;
+    string getTreatmentPlanVersion(int version, time_t* changedAt = nullptr) const;
+    void displayPlanHistory() const;
+    
+    // Appends diagnosis, treatment plan and test reports (for indexing)
+    void collectText(vector<string>& fields) const;
+    
+    // Compresses the text if unused since idleSince; returns true if compressed
+    bool freezeText(ColdTextStore& store, time_t idleSince);
+    
+    // Frees the compressed text (before the record is dropped)
+    void releaseColdText() const;
+    
+    // Serialization (for segment files); compressed text is written without restoring it
+    void writeTo(vector<uint8_t>& out) const;
+    static MedicalRecord readFrom(const vector<uint8_t>& in, size_t& pos);
+    
+    // Accessor methods
     int getId() const;
+    int getPatientId() const;
+    
+    // Object size plus owned heap memory in bytes
+    size_t memoryUsage() const;
 };
 
 // Patient class (inherits from Person)
 class Patient : public Person {
 private:
-    int patientId;                         // Patient-specific ID
-    string bloodGroup;                     // Blood type
-    vector<string> diseases;               // Known conditions
-    int assignedDoctorId;                   // Primary physician
-    vector<Appointment> appointments;      // Scheduled appointments
-    vector<Prescription> prescriptions;    // Medication history
-    vector<MedicalRecord> medicalRecords;  // Health records
+    InternedString bloodGroup;             // Blood type (shared)
+    vector<InternedString> diseases;       // Known conditions (shared names)
+    // Owned collections (mutable so const readers can load them lazily from disk)
+    mutable vector<Appointment> appointments;      // Scheduled appointments
+    mutable vector<Prescription> prescriptions;    // Medication history
+    mutable vector<MedicalRecord> medicalRecords;  // Health records
+    PatientTier* tier = nullptr;           // Tiered storage managing the collections (if any)
+    int assignedDoctorId;                  // Primary physician
     int roomId;                            // Assigned room (-1 if none)
+    mutable SegmentHeader header;          // Collection counts and residency
+    mutable bool collectionsChanged = true;  // Collections modified since the last checkpoint
+
+    // Loads the collections on first access and marks the patient as recently used;
+    // modifying accesses also mark the segment file as out of date
+    void ensureLoaded(bool modifying) const;
 
 public:
     // Constructor adds patient-specific attributes
@@ -171,28 +388,72 @@ public:
     // Displays patient details (override from Person)
     void displayDetails() const override;
     
+    // Records patient memory footprint, including appointments, prescriptions and records
+    void reportMemory(MemoryReport& report) const override;
+    
     // Adds diagnosed condition
     void addDisease(const string& disease);
     
+    // Removes the most recent entry of a condition (undo)
+    void removeDisease(const string& disease);
+    
     // Display methods for patient data
     void displayAppointments() const;
     void displayPrescriptions() const;
     void displayMedicalRecords() const;
     
     // Management methods
-    void scheduleAppointment(int doctorId, const string& dateTime);
-    void addPrescription(int doctorId);
-    void addMedicalRecord(int doctorId, const string& diagnosis, const string& plan);
+    int scheduleAppointment(int doctorId, const string& dateTime);  // Returns new appointment ID, 0 if the date is invalid
+    void addPrescription(int doctorId, const string& date = "");  // Issued now unless a date is given
+    int addMedicalRecord(int doctorId, const string& diagnosis, const string& plan);  // Returns new record ID
     void assignRoom(int rId);
     void dischargeFromRoom();
     
-    // Search methods
+    // Removes an appointment or record that was added by mistake (undo); false if not found
+    bool removeAppointment(int id);
+    bool removeMedicalRecord(int id);
+    
+    // Search methods for changes: call markCollectionsChanged after changing the result
     void getAppointment(int id, Appointment*& appt);
     void getPrescription(int id, Prescription*& presc);
     void getMedicalRecord(int id, MedicalRecord*& record);
+    void markCollectionsChanged();  // Next checkpoint and segment write include the collections
     
-    // Accessor method
+    // Search methods for reading (leave the collections clean)
+    void findAppointment(int id, const Appointment*& appt) const;
+    void findPrescription(int id, const Prescription*& presc) const;
+    void findMedicalRecord(int id, const MedicalRecord*& record) const;
+    
+    // Accessor methods
     int getRoomId() const;
+    const string& getBloodGroup() const;
+    static bool isValidBloodGroup(string_view bloodGroup);  // One of the eight ABO/Rh groups
+    int getAssignedDoctorId() const;
+    const vector<InternedString>& getDiseases() const;
+    void collectDiseases(vector<string>& names) const;  // Appends the condition names
+    const vector<Appointment>& getAppointments() const;   // Loads them first if tiered
+    const vector<MedicalRecord>& getMedicalRecords() const;
+    
+    // Corrects recorded blood group
+    void setBloodGroup(const string& newBloodGroup);
+    
+    // Compresses record and appointment text unused since idleSince; returns items compressed
+    size_t freezeColdText(ColdTextStore& store, time_t idleSince);
+    
+    // Tiered storage (used by PatientTier)
+    void setTier(PatientTier* newTier, uint32_t segment);
+    const SegmentHeader& getSegmentHeader() const;
+    void writeCollections(vector<uint8_t>& out) const;       // Serializes the collections
+    void markSegmentWritten() const;                         // Segment file now matches memory
+    void unloadCollections() const;                          // Releases them (segment must be current)
+    void loadCollections(const vector<uint8_t>& in) const;   // Reads them back from the segment
+    
+    // Checkpoints: profile and collections are saved separately, each only when changed
+    void writeTo(vector<uint8_t>& out) const override;        // Profile, conditions and room
+    static Patient readFrom(const vector<uint8_t>& in, size_t& pos);
+    bool areCollectionsChanged() const;
+    void saveCollections(vector<uint8_t>& out) const;        // Loads them first if tiered
+    void markCollectionsSaved();
 };
 
 // Doctor class (inherits from Staff)
@@ -200,7 +461,7 @@ class Doctor : public Staff {
 private:
     int doctorId;                   // Doctor-specific ID
     string specialization;          // Medical specialty
-    string licenseNumber;           // Professional license
+    LicenseNumberText licenseNumber; // Professional license
     vector<string> availableSlots;   // Open appointment times
     vector<Appointment> appointments; // Scheduled appointments
 
@@ -212,26 +473,46 @@ public:
     // Displays doctor details (override from Staff)
     void displayDetails() const override;
     
+    // Records doctor memory footprint, including appointments
+    void reportMemory(MemoryReport& report) const override;
+    
     // Prescribes medication to patient
     void prescribeMedication(int patientId, const string &medication, const string& dosage);
     
     // Manages availability
     void addAvailableSlot(const string& slot);
+    void removeAvailableSlot(const string& slot);  // Most recent entry of the slot (undo)
     
     // Appointment management
     void viewAppointments() const;
-    void completeAppointment(int apptId, const string& notes);
+    bool completeAppointment(int apptId, const string& notes);  // False if not found or not pending
+    bool reopenAppointment(int apptId);  // False if not found or not completed
     void addAppointment(int patientId, const string& dateTime);
     
     // Search method
     void getAppointment(int id, Appointment*& appt);
+    
+    // Accessor methods
+    const string& getSpecialization() const;
+    string_view getLicenseNumber() const;
+    
+    // Letters, digits, hyphens and slashes; 1-15 characters
+    static bool isValidLicenseNumber(string_view license);
+    const vector<Appointment>& getAppointments() const;
+    
+    // Compresses appointment notes unused since idleSince; returns items compressed
+    size_t freezeColdText(ColdTextStore& store, time_t idleSince);
+    
+    // Checkpoint serialization (slots and appointments included)
+    void writeTo(vector<uint8_t>& out) const override;
+    static Doctor readFrom(const vector<uint8_t>& in, size_t& pos);
 };
 
 // Nurse class (inherits from Staff)
 class Nurse : public Staff {
 private:
     int nurseId;            // Nurse-specific ID
-    string shiftTime;       // Work schedule
+    ShiftTimeText shiftTime; // Work schedule
     string qualification;   // Professional credentials
 
 public:
@@ -242,9 +523,23 @@ public:
     // Displays nurse details (override from Staff)
     void displayDetails() const override;
     
+    // Records nurse memory footprint
+    void reportMemory(MemoryReport& report) const override;
+    
     // Work methods
     void assistDoctor(int doctorId);
     void monitorPatient(int patientId);
+    
+    // Accessor methods
+    string_view getShiftTime() const;
+    const string& getQualification() const;
+    
+    // Printable text such as "Night" or "08:00-16:00"; 1-15 characters
+    static bool isValidShiftTime(string_view shift);
+    
+    // Checkpoint serialization
+    void writeTo(vector<uint8_t>& out) const override;
+    static Nurse readFrom(const vector<uint8_t>& in, size_t& pos);
 };
 
 // Medicine inventory class
@@ -256,10 +551,20 @@ private:
     double price;               // Unit price
     int quantityInStock;        // Current inventory
     string expiryDate;          // Shelf life
+    VersionedTable<Medicine>* versions = nullptr;  // Report snapshots (nullptr = not published)
+    uint32_t versionRow = 0;    // Row in the snapshot table
+    bool changed = true;        // Modified since the last checkpoint
+
+    // Publishes the current state to report snapshots
+    void publishVersion() const;
 
 public:
     // Constructor creates medicine entry
-    Medicine(const string& name, double price, int quantity, const string& expiry);
+    Medicine(string name, double price, int quantity, string expiry);
+    
+    // Sets the ID the next medicine receives (a standby reuses the primary's IDs)
+    static void setNextId(int id);
+    static int getNextId();
     
     // Displays medicine details
     void displayDetails() const;
@@ -270,9 +575,22 @@ public:
     
     // Accessor methods
     int getId() const;
-    string getName() const;
+    const string& getName() const;
     double getPrice() const;
     int getQuantity() const;
+    const string& getExpiryDate() const;
+    
+    // Links the medicine to its report snapshot row
+    void setVersions(VersionedTable<Medicine>* table, uint32_t row);
+    
+    // Checkpoints (only changed medicines are rewritten; readFrom keeps the original ID)
+    bool isChanged() const;
+    void markSaved();
+    void writeTo(vector<uint8_t>& out) const;
+    static Medicine readFrom(const vector<uint8_t>& in, size_t& pos);
+    
+    // Object size plus owned heap memory in bytes
+    size_t memoryUsage() const;
 };
 
 // Room management class
@@ -280,27 +598,49 @@ class Room {
 private:
     static int nextId;    // Tracks next available ID
     int roomId;           // Unique room number
-    string type;          // Room category (General/ICU/OR)
-    string status;        // Vacant/Occupied
+    InternedString type;  // Room category (General/ICU/OR, shared)
+    RoomStatus status;    // Vacant/Occupied
     int patientId;        // Current occupant (-1 if vacant)
+    VersionedTable<Room>* versions = nullptr;  // Report snapshots (nullptr = not published)
+    uint32_t versionRow = 0;  // Row in the snapshot table
+    bool changed = true;      // Modified since the last checkpoint
+
+    // Publishes the current state to report snapshots
+    void publishVersion() const;
 
 public:
     // Constructor creates room
-    Room(const string& type);
+    Room(string type);
+    
+    // Sets the ID the next room receives (a standby reuses the primary's IDs)
+    static void setNextId(int id);
+    static int getNextId();
     
     // Displays room details
     void displayDetails() const;
     
     // Status methods
     void checkAvailability() const;
-    void assignPatient(int pId);
-    void vacateRoom();
+    bool assignPatient(int pId);  // False if the room is occupied
+    bool vacateRoom();            // False if the room is vacant
     
     // Accessor methods
     int getId() const;
-    string getType() const;
-    string getStatus() const;
+    const string& getType() const;
+    RoomStatus getStatus() const;
     int getPatientId() const;
+    
+    // Links the room to its report snapshot row
+    void setVersions(VersionedTable<Room>* table, uint32_t row);
+    
+    // Checkpoints (only changed rooms are rewritten; readFrom keeps the original ID)
+    bool isChanged() const;
+    void markSaved();
+    void writeTo(vector<uint8_t>& out) const;
+    static Room readFrom(const vector<uint8_t>& in, size_t& pos);
+    
+    // Object size plus owned heap memory in bytes
+    size_t memoryUsage() const;
 };
 
 // Billing system class
@@ -310,22 +650,37 @@ private:
     int billId;                   // Unique bill number
     int patientId;                // Associated patient
     double totalAmount;           // Charges total
-    string paymentStatus;         // Paid/Unpaid
+    PaymentStatus paymentStatus;  // Paid/Unpaid
     vector<string> servicesAvailed; // Medical services
     vector<pair<int, int>> medicines; // (Medicine ID, Quantity) pairs
+    VersionedTable<Billing>* versions = nullptr;  // Report snapshots (nullptr = not published)
+    uint32_t versionRow = 0;      // Row in the snapshot table
+    bool changed = true;          // Modified since the last checkpoint
+
+    // Publishes the current state to report snapshots
+    void publishVersion() const;
 
 public:
     // Constructor creates new bill
     Billing(int pId);
     
+    // Sets the ID the next bill receives (a standby reuses the primary's IDs)
+    static void setNextId(int id);
+    static int getNextId();
+    
     // Adds service charge
     void addService(const string& service, double cost);
     
     // Adds medication charge
     void addMedicine(int medId, int quantity, double price);
     
-    // Processes payment
-    void processPayment(double amount);
+    // Settles an unpaid bill; false if already paid or the amount is short
+    bool processPayment(double amount);
+    
+    // Reversals used by undo: drop the most recent matching charge, or mark the bill unpaid again
+    void removeService(const string& service, double cost);
+    void removeMedicine(int medId, int quantity, double price);
+    bool refundPayment();  // False if the bill is not paid
     
     // Displays detailed bill
     void displayBill() const;
@@ -334,18 +689,200 @@ public:
     int getId() const;
     int getPatientId() const;
     double getTotalAmount() const;
-    string getPaymentStatus() const;
+    PaymentStatus getPaymentStatus() const;
+    
+    // Links the bill to its report snapshot row
+    void setVersions(VersionedTable<Billing>* table, uint32_t row);
+    
+    // Checkpoints (only changed bills are rewritten; readFrom keeps the original ID)
+    bool isChanged() const;
+    void markSaved();
+    void writeTo(vector<uint8_t>& out) const;
+    static Billing readFrom(const vector<uint8_t>& in, size_t& pos);
+    
+    // Object size plus owned heap memory in bytes
+    size_t memoryUsage() const;
+};
+
+// Tiered storage for patient collections.
+// Each patient's appointments, prescriptions and medical records have their own
+// segment file and are loaded lazily on first access. A bounded LRU keeps the
+// most recently used patients loaded; the least recently used one beyond
+// capacity is unloaded, writing its segment first only if it changed since it
+// was loaded. Admitted patients are never unloaded.
+class PatientTier {
+private:
+    SegmentStore segments;          // One file per patient
+    uint32_t nextSegment = 1;       // Next segment number to hand out
+    size_t capacity = 0;            // Patients whose collections stay resident
+    size_t managed = 0;             // Patients attached (loaded or not)
+    list<const Patient*> resident;  // Resident patients, most recently used first
+    unordered_map<const Patient*, list<const Patient*>::iterator> positions;  // Patient -> LRU entry
+
+    // Access statistics
+    size_t hits = 0;           // Accesses to resident patients
+    size_t misses = 0;         // Accesses that loaded collections from disk
+    size_t spills = 0;         // Patients unloaded
+    size_t cleanSpills = 0;    // Unloads that needed no write (segment already current)
+    size_t failures = 0;       // Writes or loads that hit an I/O error
+    double faultSeconds = 0;   // Total time spent loading
+    double spillSeconds = 0;   // Total time spent unloading
+
+    // Unloads least recently used patients until within capacity
+    void evict();
+
+    // Writes one patient's segment if needed and releases the collections; returns false on I/O failure
+    bool spill(const Patient* patient);
+
+public:
+    // Starts tiering with segment files in the given directory; returns false if it cannot be used
+    bool open(const string& directory, size_t residentPatients);
+
+    // Stops tiering and deletes the segment files (patients must be detached first)
+    void close();
+
+    // Changes how many patients stay resident, spilling any excess
+    void setCapacity(size_t residentPatients);
+
+    // Starts managing a patient (its collections are resident)
+    void attach(Patient* patient);
+
+    // Faults a patient back in and stops managing it
+    void detach(Patient* patient);
+
+    // Records an access, loading the patient's collections if unloaded
+    void touch(const Patient* patient);
+
+    // Accessor methods
+    bool isEnabled() const;
+    size_t getCapacity() const;
+    size_t residentCount() const;
+    size_t unloadedCount() const;
+    double hitRate() const;
+
+    // Heap bytes used by the LRU
+    size_t memoryUsage() const;
+
+    // Displays residency, hit rate and I/O figures
+    void displayReport() const;
 };
 
 // Main hospital management system
+// Owns every entity through type-specific pools; the vectors below are
+// non-owning registries in insertion order.
 class HospitalSystem {
 private:
+    ObjectPool<Patient> patientPool;    // Storage for all patients
+    ObjectPool<Doctor> doctorPool;      // Storage for all doctors
+    ObjectPool<Nurse> nursePool;        // Storage for all nurses
+    ObjectPool<Medicine> medicinePool;  // Storage for all medicines
+    ObjectPool<Room> roomPool;          // Storage for all rooms
+    ObjectPool<Billing> billPool;       // Storage for all bills
+
     vector<Person*> persons;      // All people (patients/staff)
     vector<Medicine*> medicines;  // Medicine inventory
     vector<Room*> rooms;          // Room inventory
     vector<Billing*> bills;       // Financial records
+    MemoryReport lastMemoryReport; // Previous report, used to show growth
+
+    bool columnarEnabled = false;   // True once the columnar mirror is built
+    PatientColumns patientColumns;  // Optional columnar mirror of patient attributes
+    StaffColumns staffColumns;      // Optional columnar mirror of staff attributes
+
+    RoaringBitmap allPersonIds;     // Every registered person (universe for NOT)
+    CategoryIndex bloodGroupIndex;  // Blood group -> patient IDs
+    CategoryIndex genderIndex;      // Gender -> person IDs
+    CategoryIndex departmentIndex;  // Department -> staff IDs
+    RoaringBitmap donorsByBloodGroup[BLOOD_GROUP_COUNT];  // Blood group -> registration positions in persons
+
+    TextIndex clinicalText;  // Full-text index over diseases, records and appointment notes
+    NameIndex nameIndex;     // Trigram index over names, keyed by position in persons
+    ContactIndex contactIndex; // Normalized phone number / address -> persons
+    DuplicateDetector duplicateDetector;  // Blocking index over patients, keyed by pool slot
+
+    ColdTextStore coldText;              // Compressed clinical text not used recently
+    int coldTextAgeDays = 365;           // Idle days before clinical text is compressed
+
+    PatientTier patientTier;             // Keeps inactive patients' collections on disk only
+
+    // Bloom filters over IDs, so lookups of unknown IDs skip the scan
+    double lookupFilterRate = 0.01;      // Target false-positive rate
+    BloomFilter patientFilter;           // Patient IDs
+    BloomFilter doctorFilter;            // Doctor IDs
+    BloomFilter nurseFilter;             // Nurse IDs
+    BloomFilter medicineFilter;          // Medicine IDs
+    BloomFilter billFilter;              // Patient IDs that have a bill
+
+    // Versions of medicines, rooms and bills for lock-free report snapshots
+    mutable EpochManager snapshotEpochs;                    // Commit clock and reclamation (readers pin it)
+    VersionedTable<Medicine> medicineVersions{snapshotEpochs};
+    VersionedTable<Room> roomVersions{snapshotEpochs};
+    VersionedTable<Billing> billVersions{snapshotEpochs};
+
+    LogShipper replicationLog;           // Ships every change to a standby process (when open)
+
+    // Incremental checkpoints: a full base, then only objects changed since the last save
+    CheckpointStore checkpoints;         // Base and delta files
+    bool checkpointing = false;          // Saves are due periodically
+    int checkpointInterval = 300;        // Seconds between saves
+    size_t compactAfterDeltas = 64;      // Deltas merged into a new base once this many exist
+    time_t lastCheckpoint = 0;           // Time of the last save
+    vector<uint64_t> changedObjects;     // Checkpoint keys listed by mutators since the last save
+    vector<uint32_t> patientPositions;   // Pool slot -> position in persons (checkpoint keys)
+    vector<uint32_t> doctorPositions;
+    vector<uint32_t> nursePositions;
+    vector<uint32_t> medicinePositions;  // Pool slot -> position in medicines
+    vector<uint32_t> roomPositions;      // Pool slot -> position in rooms
+    vector<uint32_t> billPositions;      // Pool slot -> position in bills
+
+    CommandLog commandLog;               // Menu changes that can be undone or redone
+
+    // Records a completed change: ships it to the standby (when shipping) and
+    // saves a checkpoint when one is due
+    void ship(Mutation& mutation);
+
+    // Lists a changed object for the next delta checkpoint, so saves and flag
+    // clears visit only what changed
+    void noteChanged(const Person* person);
+    void noteChanged(const Medicine* medicine);
+    void noteChanged(const Room* room);
+    void noteChanged(const Billing* bill);
+    void noteCollectionsChanged(const Patient* patient);
+
+    // Encodes every object (or only the listed changed ones) for a checkpoint
+    void collectCheckpoint(bool everything, vector<CheckpointRecord>& records) const;
+
+    // Clears the change flags (all, or only the listed objects') once a checkpoint holds the current state
+    void markCheckpointSaved(bool everything);
+
+    // Re-indexes the text of one medical record
+    void indexRecord(const MedicalRecord& record);
+
+    // Re-indexes the condition list of one patient
+    void indexDiseases(const Patient* patient);
+
+    // Adds a newly registered person to the categorical indexes
+    void indexPerson(Person* person);
 
 public:
+    HospitalSystem() = default;
+    HospitalSystem(const HospitalSystem&) = delete;             // System owns its entities
+    HospitalSystem& operator=(const HospitalSystem&) = delete;
+
+    // Entity allocation (objects are owned by the system; register them with addX)
+    template <typename... Args> Patient* newPatient(Args&&... args) { return patientPool.create(forward<Args>(args)...); }
+    template <typename... Args> Doctor* newDoctor(Args&&... args) { return doctorPool.create(forward<Args>(args)...); }
+    template <typename... Args> Nurse* newNurse(Args&&... args) { return nursePool.create(forward<Args>(args)...); }
+    template <typename... Args> Medicine* newMedicine(Args&&... args) { return medicinePool.create(forward<Args>(args)...); }
+    template <typename... Args> Room* newRoom(Args&&... args) { return roomPool.create(forward<Args>(args)...); }
+
+    // Stable handles for pooled entities
+    PoolHandle handleOf(const Patient* patient) const;
+    Patient* getPatient(PoolHandle handle) const;
+
+    // Releases every entity in one step (used when unloading a whole system)
+    void releaseAll();
+
     // Person management
     void addPatient(Patient* patient);
     void addDoctor(Doctor* doctor);
@@ -355,6 +892,20 @@ public:
     void findDoctor(int id, Doctor*& doctor);
     void findNurse(int id, Nurse*& nurse);
 
+    // Typo-tolerant name lookup: best matches first with their similarity (0..1)
+    void searchByName(const string& query, size_t maxResults, vector<pair<Person*, double>>& matches) const;
+
+    // Contact details (reverse-indexed for caller identification)
+    void updateContactInfo(Person* person, const string& newAddress, const string& newContact);
+    const vector<Person*>& findByPhone(const string& phone) const;
+    const vector<Person*>& findByAddress(const string& address) const;
+
+    // Duplicate patient detection
+    void checkDuplicates(const Patient* patient, vector<pair<Patient*, double>>& matches) const;
+    void findDuplicatePatients(unsigned threads, vector<DuplicatePair>& pairs) const;
+    Patient* patientForRow(uint32_t row) const;  // Resolves rows reported in DuplicatePair
+    void discardPatient(Patient* patient);       // Frees a patient that was never registered
+
     // Medicine management
     void addMedicine(Medicine* medicine);
     void displayAllMedicines() const;
@@ -364,24 +915,167 @@ public:
     void addRoom(Room* room);
     void displayAllRooms() const;
     void findRoom(int id, Room*& room);
-    void findAvailableRoom(const string& type, Room*& room);
+    void findAvailableRoom(string_view type, Room*& room);
 
     // Billing management
     void createBill(int patientId, Billing*& bill);
     void displayAllBills() const;
     void findPatientBill(int patientId, Billing*& bill);
+
+    // Columnar patient and staff store for population queries
+    void enableColumnarStore();
+    bool isColumnarEnabled() const;
+    void queryPatients(const PatientFilter& filter, vector<int>& patientIds);
+    void queryStaff(const StaffFilter& filter, vector<int>& staffIds);
+
+    // Categorical bitmap indexes
+    void updateBloodGroup(Patient* patient, const string& newBloodGroup);
+    void transferDepartment(Staff* staff, const string& newDepartment);
+    bool queryCategories(const string& expression, vector<int>& personIds) const;
+
+    // Blood matching: compatible patients, available (not admitted) first, then most recently registered
+    void findCompatibleDonors(const Patient* recipient, size_t maxResults, vector<Patient*>& donors) const;
+
+    // Clinical text updates (kept searchable immediately)
+    void addDisease(Patient* patient, const string& disease);
+    void addMedicalRecord(Patient* patient, int doctorId, const string& diagnosis, const string& plan);
+    void addTestResult(Patient* patient, int recordId, const string& result);
+    void updateTreatmentPlan(Patient* patient, int recordId, const string& newPlan);
+    void completeAppointment(Doctor* doctor, int apptId, const string& notes);
+    bool searchClinicalText(const string& query, vector<TextHit>& hits) const;
+
+    // Front-desk, ward, pharmacy and cashier changes made from the menus
+    int scheduleAppointment(Patient* patient, int doctorId, const string& dateTime);  // Returns appointment ID, 0 if rejected
+    void addAvailableSlot(Doctor* doctor, const string& slot);
+    void assignRoom(Patient* patient, Room* room);
+    void dischargePatient(Patient* patient);
+    void updateStock(Medicine* medicine, int quantity);
+    void addServiceToBill(Billing* bill, const string& service, double cost);
+    void addMedicineToBill(Billing* bill, Medicine* medicine, int quantity);  // Also deducts the stock
+    void processPayment(Billing* bill, double amount);
+
+    // Reversals used by undo (shipped like any other change)
+    void removeDisease(Patient* patient, const string& disease);
+    void removeAppointment(Patient* patient, int apptId);
+    void removeMedicalRecord(Patient* patient, int recordId);
+    void removeTestResult(Patient* patient, int recordId);
+    void revertTreatmentPlan(Patient* patient, int recordId);
+    void reopenAppointment(Doctor* doctor, int apptId);
+    void removeAvailableSlot(Doctor* doctor, const string& slot);
+    void removeServiceFromBill(Billing* bill, const string& service, double cost);
+    void removeMedicineFromBill(Billing* bill, Medicine* medicine, int quantity);  // Also restocks
+    void refundPayment(Billing* bill);
+
+    // Undo/redo: the menus make changes through commands kept in a bounded history
+    bool execute(unique_ptr<Command> command);  // False if the change was not made
+    bool undo();
+    bool redo();
+    void setHistoryLimit(size_t commands);
+    const CommandLog& getCommandLog() const;
+
+    // Cold clinical text compression
+    void setColdTextAge(int days);
+    int getColdTextAge() const;
+    size_t compressColdText();  // Compresses text idle for the configured age; returns items compressed
+    const ColdTextStore& getColdTextStore() const;
+
+    // Tiered patient storage (only the most recently used patients keep their collections resident)
+    bool enableTieredStorage(const string& directory, size_t residentPatients);
+    void disableTieredStorage();
+    const PatientTier& getPatientTier() const;
+
+    // Lookup filters (rebuilt from the registries when the rate changes)
+    void setLookupFilterRate(double falsePositiveRate);
+    double getLookupFilterRate() const;
+    void displayLookupFilterReport() const;
+
+    // Groups several changes so report snapshots see all of them or none
+    void beginUpdate();
+    void commitUpdate();
+
+    // Displays commit clock, active snapshots and version figures
+    void displaySnapshotReport() const;
+
+    // Log shipping: a primary appends every change to a shared file that a
+    // standby process follows. Start shipping before the first change.
+    bool startShipping(const string& logPath);
+    bool resumeShipping(const string& logPath, uint64_t lastSequence);  // Promoted standby continues the log
+    void stopShipping();
+    const LogShipper& getReplicationLog() const;
+
+    // Replays a shipped change on a standby; false if its target does not exist here
+    bool applyMutation(const Mutation& mutation);
+
+    // Checkpoints: enabling writes a full base (replacing any files in the directory);
+    // later saves write only changed objects and compact the deltas as they pile up
+    bool enableCheckpoints(const string& directory, int intervalSeconds);
+    bool restoreCheckpoint(const string& directory, int intervalSeconds);  // Empty system only
+    void disableCheckpoints();
+    bool saveCheckpoint(bool full = false);
+    bool compactCheckpoints();
+    bool isCheckpointing() const;
+    const CheckpointStore& getCheckpointStore() const;
+    void displayCheckpointReport() const;
+
+    // Memory accounting
+    void collectMemoryUsage(MemoryReport& report) const;
+    void displayMemoryReport();
 };
 
-// Factory functions for object creation
-void createPatient(Patient*& patient);
-void createDoctor(Doctor*& doctor);
-void createNurse(Nurse*& nurse);
-void createMedicine(Medicine*& medicine);
-void createRoom(Room*& room);
+// Factory functions for object creation (objects are allocated by the hospital)
+void createPatient(HospitalSystem& hospital, Patient*& patient);
+void createDoctor(HospitalSystem& hospital, Doctor*& doctor);
+void createNurse(HospitalSystem& hospital, Nurse*& nurse);
+void createMedicine(HospitalSystem& hospital, Medicine*& medicine);
+void createRoom(HospitalSystem& hospital, Room*& room);
 
 // Operational menus
 void patientOperations(HospitalSystem& hospital, Patient* patient);
-void doctorOperations(Doctor* doctor);
-void nurseOperations(Nurse* nurse);
+void doctorOperations(HospitalSystem& hospital, Doctor* doctor);
+void nurseOperations(HospitalSystem& hospital, Nurse* nurse);
 void inventoryOperations(HospitalSystem& hospital);
-void billingOperations(HospitalSystem& hospital);
\ No newline at end of file
+void billingOperations(HospitalSystem& hospital);
+void diagnosticsOperations(HospitalSystem& hospital);
+void populationQuery(HospitalSystem& hospital);
+void staffPopulationQuery(HospitalSystem& hospital);
+void categoryQuery(HospitalSystem& hospital);
+void clinicalTextSearch(HospitalSystem& hospital);
+void lookupOperations(HospitalSystem& hospital);
+void nameSearch(HospitalSystem& hospital);
+void contactSearch(HospitalSystem& hospital, bool byPhone);
+bool confirmNotDuplicate(HospitalSystem& hospital, const Patient* patient);
+void duplicateReport(HospitalSystem& hospital);
+void coldTextOperations(HospitalSystem& hospital);
+void tieredStorageOperations(HospitalSystem& hospital);
+void lookupFilterOperations(HospitalSystem& hospital);
+void snapshotOperations(HospitalSystem& hospital);
+void replicationOperations(HospitalSystem& hospital);
+void checkpointOperations(HospitalSystem& hospital);
+void historyOperations(HospitalSystem& hospital);
+
+// Follows a primary's log until promoted (true) or closed (false)
+bool runStandby(HospitalSystem& hospital, const string& logPath);
+
+// Measures replication lag with a primary and standby sharing a log file
+void runReplicationBenchmark(size_t mutations, size_t ratePerSecond);
+
+// Compares full and delta checkpoint I/O under a stream of changes, then restores and checks the result
+void runCheckpointBenchmark(size_t patients, size_t changesPerSave, size_t saves);
+
+// Runs generated patients through a small resident set and reports hit rate and memory
+void runTieredStorageBenchmark(size_t patients, size_t residentPatients);
+
+// Simulated staff for the concurrent load test. Roles are front desk, doctor,
+// pharmacy and cashier, in that order; a rate of 0 runs an actor flat out.
+struct LoadTestPlan {
+    size_t actors[4] = { 2, 4, 2, 2 };         // Actors per role
+    double rates[4] = { 50, 50, 50, 50 };      // Operations per second per actor
+    double seconds = 5;                        // Length of the run
+    size_t patients = 2000;                    // Registered before the run starts
+};
+
+// Reports bytes per patient at several history depths; true if a typical patient fits the budget
+bool runFootprintBenchmark(size_t patients);
+
+// Runs the actors on their own threads and reports throughput, tail latency and lock contention per role
+void runLoadTest(const LoadTestPlan& plan);
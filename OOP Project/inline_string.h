@@ -0,0 +1,46 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string_view>  // For reading and assigning text
+#include <algorithm>    // For min
+#include <cstring>      // For memcpy
+#include <cstdint>      // For the length byte
+using namespace std;
+
+// Short text stored inside the object: up to Capacity characters and a length
+// byte, with no heap allocation and no separate string header. Text longer
+// than Capacity is cut short, so input is checked with fits() (or a stricter
+// field rule) before it gets here.
+template <size_t Capacity>
+class InlineString {
+    static_assert(Capacity < 256, "The length is kept in one byte");
+
+private:
+    char chars[Capacity] = {};  // Text (not null-terminated)
+    uint8_t length = 0;         // Characters in use
+
+public:
+    InlineString() = default;
+    InlineString(string_view text) { assign(text); }
+
+    InlineString& operator=(string_view text) {
+        assign(text);
+        return *this;
+    }
+
+    // Replaces the text, keeping at most Capacity characters
+    void assign(string_view text) {
+        length = static_cast<uint8_t>(min(text.size(), Capacity));
+        if (length) memcpy(chars, text.data(), length);
+    }
+
+    // True if text is stored whole
+    static bool fits(string_view text) { return text.size() <= Capacity; }
+
+    // Stored text
+    string_view view() const { return string_view(chars, length); }
+    bool empty() const { return length == 0; }
+
+    bool operator==(const InlineString& other) const { return view() == other.view(); }
+    bool operator!=(const InlineString& other) const { return view() != other.view(); }
+};
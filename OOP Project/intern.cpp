@@ -0,0 +1,51 @@
+#include "intern.h"  // Interning table declarations
+#include "memory.h"  // For heap accounting
+
+// ========== INTERN TABLE IMPLEMENTATION ========== //
+
+const string* InternTable::intern(string_view value) {
+    lock_guard<mutex> guard(lock);
+    auto it = lookup.find(value);
+    if (it != lookup.end()) return it->second;
+    values.emplace_back(value);
+    const string* stored = &values.back();
+    lookup.emplace(string_view(*stored), stored);  // Key views the stored copy
+    return stored;
+}
+
+const string* InternTable::find(string_view value) const {
+    lock_guard<mutex> guard(lock);
+    auto it = lookup.find(value);
+    return it == lookup.end() ? nullptr : it->second;
+}
+
+size_t InternTable::size() const {
+    lock_guard<mutex> guard(lock);
+    return values.size();
+}
+
+// Strings and their heap, plus one hash node and bucket per value
+size_t InternTable::memoryUsage() const {
+    lock_guard<mutex> guard(lock);
+    size_t bytes = values.size() * sizeof(string) + lookup.bucket_count() * sizeof(void*);
+    for (const auto& value : values) {
+        bytes += stringHeapBytes(value) + sizeof(pair<string_view, const string*>) + sizeof(void*);
+    }
+    return bytes;
+}
+
+InternTable& internTable() {
+    static InternTable table;  // Built on first use, before any field interns
+    return table;
+}
+
+// ========== INTERNED STRING IMPLEMENTATION ========== //
+
+InternedString::InternedString() : value(internTable().intern("")) {}
+
+InternedString::InternedString(string_view text) : value(internTable().intern(text)) {}
+
+InternedString& InternedString::operator=(string_view text) {
+    value = internTable().intern(text);
+    return *this;
+}
@@ -0,0 +1,55 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>         // For stored values
+#include <string_view>    // For lookups without copies
+#include <deque>          // For values that never move
+#include <unordered_map>  // For value lookup
+#include <mutex>          // For registration from several threads
+using namespace std;
+
+// Shared storage for categorical text (room types, genders, departments, blood
+// groups). Each distinct value is kept once for the life of the program and
+// never moves, so fields can hold a pointer to it and equal values share one
+// address.
+class InternTable {
+private:
+    mutable mutex lock;                                   // Guards both containers
+    deque<string> values;                                 // Stored values (stable addresses)
+    unordered_map<string_view, const string*> lookup;     // Value -> its stored copy
+
+public:
+    // Stored copy of value, adding it if new
+    const string* intern(string_view value);
+
+    // Stored copy of value, or nullptr if it was never interned
+    const string* find(string_view value) const;
+
+    // Number of distinct values
+    size_t size() const;
+
+    // Heap bytes used by the table
+    size_t memoryUsage() const;
+};
+
+// The program-wide table
+InternTable& internTable();
+
+// Field holding an interned value: one pointer instead of a string, compared
+// by address. Assigning text interns it.
+class InternedString {
+private:
+    const string* value;  // Stored copy in the program-wide table
+
+public:
+    InternedString();                              // Empty value
+    InternedString(string_view text);              // Interns text
+    InternedString& operator=(string_view text);   // Interns text
+
+    // Stored text
+    const string& str() const { return *value; }
+
+    // Same value (one pointer compare)
+    bool operator==(const InternedString& other) const { return value == other.value; }
+    bool operator!=(const InternedString& other) const { return value != other.value; }
+};
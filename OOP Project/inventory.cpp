@@ -1,4 +1,5 @@
 #include "hospital.h"  // Includes the main hospital system header
+#include "varint.h"    // For checkpoint serialization
 
 // Medicine implementation
 
@@ -6,12 +7,18 @@
 int Medicine::nextId = 1;
 
 // Constructor implementation
-Medicine::Medicine(const string& name, double price, int quantity, const string& expiry)
+Medicine::Medicine(string name, double price, int quantity, string expiry)
     : medicineId(nextId++),  // Auto-increments ID for each new medicine
-      name(name),            // Sets medicine name
+      name(move(name)),      // Sets medicine name
       price(price),          // Sets unit price
       quantityInStock(quantity), // Initializes stock quantity
-      expiryDate(expiry) {}  // Sets expiration date
+      expiryDate(move(expiry)) {}  // Sets expiration date
+
+// Sets the ID the next medicine receives
+void Medicine::setNextId(int id) { nextId = id; }
+
+// ID the next medicine receives
+int Medicine::getNextId() { return nextId; }
 
 // Displays complete medicine information
 void Medicine::displayDetails() const {
@@ -41,13 +48,15 @@ void Medicine::updateStock(int quantity) {
         cout << "\nDeducted " << -quantity << " units from stock.\n";  // Dispensing message
     }
     cout << "Current stock: " << quantityInStock << "\n";  // Updated quantity
+    changed = true;
+    publishVersion();
 }
 
 // Getter for medicine ID
 int Medicine::getId() const { return medicineId; }
 
 // Getter for medicine name
-string Medicine::getName() const { return name; }
+const string& Medicine::getName() const { return name; }
 
 // Getter for unit price
 double Medicine::getPrice() const { return price; }
@@ -55,68 +64,174 @@ double Medicine::getPrice() const { return price; }
 // Getter for current quantity
 int Medicine::getQuantity() const { return quantityInStock; }
 
+// Getter for expiry date
+const string& Medicine::getExpiryDate() const { return expiryDate; }
+
+// Links the medicine to its report snapshot row
+void Medicine::setVersions(VersionedTable<Medicine>* table, uint32_t row) {
+    versions = table;
+    versionRow = row;
+}
+
+// True if modified since the last checkpoint
+bool Medicine::isChanged() const { return changed; }
+
+// The last checkpoint now holds this medicine's state
+void Medicine::markSaved() { changed = false; }
+
+// Serializes the medicine for a checkpoint
+void Medicine::writeTo(vector<uint8_t>& out) const {
+    writeSigned(out, medicineId);
+    writeString(out, name);
+    writeDouble(out, price);
+    writeSigned(out, quantityInStock);
+    writeString(out, expiryDate);
+}
+
+// Reads a medicine written by writeTo (keeps its original ID)
+Medicine Medicine::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    int id = static_cast<int>(readSigned(in, pos));
+    string name = readString(in, pos);
+    double price = readDouble(in, pos);
+    int quantity = static_cast<int>(readSigned(in, pos));
+    Medicine medicine(name, price, quantity, readString(in, pos));
+    medicine.medicineId = id;
+    return medicine;
+}
+
+// Publishes the current state to report snapshots
+void Medicine::publishVersion() const {
+    if (versions) versions->update(versionRow, *this);
+}
+
+// Object size plus owned heap memory
+size_t Medicine::memoryUsage() const {
+    return sizeof(Medicine) + stringHeapBytes(name) + stringHeapBytes(expiryDate);
+}
+
 // Room implementation
 
 // Static member initialization - tracks next available room ID
 int Room::nextId = 1;
 
 // Constructor implementation
-Room::Room(const string& type) 
+Room::Room(string type)
     : roomId(nextId++),  // Auto-increments ID for each new room
-      type(type),        // Sets room type (General/ICU/OR)
-      status("Vacant"),  // Default status
+      type(type),        // Sets room type (General/ICU/OR, interned)
+      status(RoomStatus::Vacant),  // Default status
       patientId(-1) {}   // -1 indicates no patient assigned
 
+// Room status names, indexed by RoomStatus
+const string& statusName(RoomStatus status) {
+    static const string names[] = { "Vacant", "Occupied" };
+    return names[static_cast<int>(status)];
+}
+
+// A room is only ever filled when vacant and emptied when occupied
+bool isValidTransition(RoomStatus from, RoomStatus to) { return from != to; }
+
+// Sets the ID the next room receives
+void Room::setNextId(int id) { nextId = id; }
+
+// ID the next room receives
+int Room::getNextId() { return nextId; }
+
 // Displays complete room information
 void Room::displayDetails() const {
     cout << "\n=== ROOM DETAILS ===\n";  // Header
     cout << "Room ID: " << roomId << "\n";  // Unique identifier
-    cout << "Type: " << type << "\n";    // Room category
-    cout << "Status: " << status << "\n"; // Vacant/Occupied
-    if (status == "Occupied") {
+    cout << "Type: " << type.str() << "\n";    // Room category
+    cout << "Status: " << statusName(status) << "\n"; // Vacant/Occupied
+    if (status == RoomStatus::Occupied) {
         cout << "Patient ID: " << patientId << "\n";  // Shows occupant if occupied
     }
 }
 
 // Checks and displays room availability
 void Room::checkAvailability() const {
-    if (status == "Vacant") {
-        cout << "\nRoom #" << roomId << " (" << type << ") is available.\n";
+    if (status == RoomStatus::Vacant) {
+        cout << "\nRoom #" << roomId << " (" << type.str() << ") is available.\n";
     } else {
         cout << "\nRoom #" << roomId << " is occupied by patient " << patientId << ".\n";
     }
 }
 
 // Assigns a patient to the room
-void Room::assignPatient(int pId) {
-    if (status == "Vacant") {  // Only assign if vacant
+bool Room::assignPatient(int pId) {
+    if (isValidTransition(status, RoomStatus::Occupied)) {  // Only assign if vacant
         patientId = pId;
-        status = "Occupied";
+        status = RoomStatus::Occupied;
+        changed = true;
+        publishVersion();
         cout << "\nPatient " << pId << " assigned to Room #" << roomId << "\n";
-    } else {
-        cout << "\nRoom is already occupied!\n";  // Error message
+        return true;
     }
+    cout << "\nRoom is already occupied!\n";  // Error message
+    return false;
 }
 
 // Vacates the room
-void Room::vacateRoom() {
-    if (status == "Occupied") {  // Only vacate if occupied
+bool Room::vacateRoom() {
+    if (isValidTransition(status, RoomStatus::Vacant)) {  // Only vacate if occupied
         cout << "\nPatient " << patientId << " discharged from Room #" << roomId << "\n";
         patientId = -1;  // Reset patient ID
-        status = "Vacant";  // Update status
-    } else {
-        cout << "\nRoom is already vacant!\n";  // Error message
+        status = RoomStatus::Vacant;  // Update status
+        changed = true;
+        publishVersion();
+        return true;
     }
+    cout << "\nRoom is already vacant!\n";  // Error message
+    return false;
 }
 
 // Getter for room ID
 int Room::getId() const { return roomId; }
 
 // Getter for room type
-string Room::getType() const { return type; }
+const string& Room::getType() const { return type.str(); }
 
 // Getter for room status
-string Room::getStatus() const { return status; }
+RoomStatus Room::getStatus() const { return status; }
 
 // Getter for assigned patient ID
-int Room::getPatientId() const { return patientId; }
\ No newline at end of file
+int Room::getPatientId() const { return patientId; }
+
+// Links the room to its report snapshot row
+void Room::setVersions(VersionedTable<Room>* table, uint32_t row) {
+    versions = table;
+    versionRow = row;
+}
+
+// True if modified since the last checkpoint
+bool Room::isChanged() const { return changed; }
+
+// The last checkpoint now holds this room's state
+void Room::markSaved() { changed = false; }
+
+// Serializes the room for a checkpoint
+void Room::writeTo(vector<uint8_t>& out) const {
+    writeSigned(out, roomId);
+    writeString(out, type.str());
+    writeVarint(out, static_cast<uint32_t>(status));
+    writeSigned(out, patientId);
+}
+
+// Reads a room written by writeTo (keeps its original ID)
+Room Room::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    int id = static_cast<int>(readSigned(in, pos));
+    Room room(readString(in, pos));
+    room.roomId = id;
+    room.status = static_cast<RoomStatus>(readVarint(in, pos));
+    room.patientId = static_cast<int>(readSigned(in, pos));
+    return room;
+}
+
+// Publishes the current state to report snapshots
+void Room::publishVersion() const {
+    if (versions) versions->update(versionRow, *this);
+}
+
+// Object size plus owned heap memory
+size_t Room::memoryUsage() const {
+    return sizeof(Room);  // The type is shared and the status inline
+}
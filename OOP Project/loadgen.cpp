@@ -0,0 +1,211 @@
+#include "hospital.h"  // Includes the main hospital system header
+#include "workload.h"  // For generated patients and a quiet console
+#include <iomanip>     // For formatted figures
+#include <chrono>      // For pacing and latency
+#include <thread>      // For actor threads
+#include <mutex>       // For the hospital lock
+#include <deque>       // For appointments waiting for a doctor
+#include <algorithm>   // For sort and max
+
+// ========== CONCURRENT LOAD TEST ========== //
+
+static const size_t LOAD_ROLES = 4;
+static const char* loadRoleNames[LOAD_ROLES] = { "Front desk", "Doctor", "Pharmacy", "Cashier" };
+
+// What one actor measured
+struct ActorFigures {
+    vector<float> latencies;   // Milliseconds from scheduled start to completion
+    size_t idle = 0;           // Turns with nothing to do (no booked patient or unpaid bill)
+    size_t contended = 0;      // Operations that found the lock held by another actor
+    double waitSeconds = 0;    // Time spent waiting for the lock
+    double holdSeconds = 0;    // Time spent holding it
+};
+
+// Everything the actors share; only touched while holding the lock
+struct LoadState {
+    HospitalSystem hospital;
+    vector<int> patientIds;           // Registered patients
+    deque<pair<int, int>> waiting;    // Booked (patient, doctor) pairs not yet seen
+    vector<int> medicineIds;
+    int nextPatientId = 100000;
+    int doctors = 20;
+};
+
+// Registers a patient, opens their bill and books them with a doctor
+static void registerPatient(LoadState& state, PopulationBuilder& people) {
+    int id = state.nextPatientId++;
+    HospitalSystem& hospital = state.hospital;
+    Patient* patient = hospital.newPatient(people.patient(id, 1));
+    hospital.addPatient(patient);
+    int doctorId = 1 + static_cast<int>(people.pick(state.doctors));
+    hospital.scheduleAppointment(patient, doctorId, "0" + to_string(1 + people.pick(9)) + "/01/2025 10:00");
+    Billing* bill;
+    hospital.createBill(id, bill);
+    hospital.addServiceToBill(bill, "Registration", 20);
+    state.patientIds.push_back(id);
+    state.waiting.emplace_back(id, doctorId);
+}
+
+// One operation for a role; false if there was nothing to do
+static bool performRole(size_t role, LoadState& state, PopulationBuilder& people) {
+    static const char* diagnoses[] = { "Hypertension", "Type 2 diabetes", "Asthma", "Migraine" };
+    HospitalSystem& hospital = state.hospital;
+    if (role == 0) {
+        registerPatient(state, people);
+        return true;
+    }
+    if (role == 1) {  // Sees the next booked patient: records the visit and charges for it
+        if (state.waiting.empty()) return false;
+        pair<int, int> visit = state.waiting.front();
+        state.waiting.pop_front();
+        Patient* patient;
+        hospital.findPatient(visit.first, patient);
+        if (!patient) return false;
+        hospital.addMedicalRecord(patient, visit.second, diagnoses[people.pick(4)], "Review in two weeks");
+        Billing* bill;
+        hospital.findPatientBill(visit.first, bill);
+        if (!bill) hospital.createBill(visit.first, bill);
+        hospital.addServiceToBill(bill, "Consultation", 50);
+        return true;
+    }
+
+    int patientId = state.patientIds[people.pick(state.patientIds.size())];
+    Billing* bill;
+    hospital.findPatientBill(patientId, bill);
+    if (role == 2) {  // Dispenses to a random patient, restocking when low
+        Medicine* medicine;
+        hospital.findMedicine(state.medicineIds[people.pick(state.medicineIds.size())], medicine);
+        if (medicine->getQuantity() < 100) hospital.updateStock(medicine, 10000);
+        if (!bill) hospital.createBill(patientId, bill);
+        hospital.addMedicineToBill(bill, medicine, 1 + static_cast<int>(people.pick(3)));
+        return true;
+    }
+    if (!bill) return false;  // Cashier: settles a random patient's bill in full
+    hospital.processPayment(bill, bill->getTotalAmount());
+    return true;
+}
+
+// Value at a fraction of the sorted latencies
+static float percentile(const vector<float>& sorted, double fraction) {
+    if (sorted.empty()) return 0;
+    return sorted[min(sorted.size() - 1, static_cast<size_t>(sorted.size() * fraction))];
+}
+
+// Runs front desk, doctor, pharmacy and cashier actors against one hospital.
+// Every change goes through the hospital's single writer (each mutator also
+// ships the change and updates shared indexes), so actors take one lock per
+// operation; waiting for it is reported apart from holding it. Figures are per
+// role, not per subsystem: a pharmacy operation touches billing and inventory
+// under the same lock. Paced actors keep to their schedule, so falling behind
+// shows up as latency.
+void runLoadTest(const LoadTestPlan& plan) {
+    LoadState state;
+    PopulationBuilder setup(2024);
+    cout << "\nRegistering " << plan.patients << " patients...\n";
+    ConsoleSilencer quiet;
+    setup.addDoctors(state.hospital, state.doctors);
+    for (Medicine* medicine : setup.addMedicines(state.hospital, 50, 10000)) {
+        state.medicineIds.push_back(medicine->getId());
+    }
+    for (size_t i = 0; i < max<size_t>(plan.patients, 1); i++) registerPatient(state, setup);
+
+    // One thread per actor
+    mutex hospitalLock;
+    vector<ActorFigures> figures;
+    vector<size_t> roles;
+    for (size_t role = 0; role < LOAD_ROLES; role++) {
+        for (size_t a = 0; a < plan.actors[role]; a++) roles.push_back(role);
+    }
+    figures.resize(roles.size());
+    auto start = chrono::steady_clock::now() + chrono::milliseconds(10);  // Every thread starts together
+    auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(
+                                chrono::duration<double>(plan.seconds));
+    vector<thread> threads;
+    for (size_t actor = 0; actor < roles.size(); actor++) {
+        threads.emplace_back([&, actor]() {
+            size_t role = roles[actor];
+            ActorFigures& mine = figures[actor];
+            PopulationBuilder people(static_cast<unsigned>(7919 * (actor + 1)));
+            double rate = plan.rates[role];
+            auto interval = chrono::duration_cast<chrono::steady_clock::duration>(
+                chrono::duration<double>(rate > 0 ? 1.0 / rate : 0));
+            auto scheduled = start;
+            this_thread::sleep_until(start);
+            while (true) {
+                if (rate > 0) {
+                    if (scheduled >= deadline) break;
+                    this_thread::sleep_until(scheduled);
+                } else {
+                    scheduled = chrono::steady_clock::now();
+                    if (scheduled >= deadline) break;
+                }
+                auto arrived = chrono::steady_clock::now();
+                unique_lock<mutex> guard(hospitalLock, try_to_lock);
+                if (!guard.owns_lock()) {
+                    mine.contended++;
+                    guard.lock();
+                }
+                auto acquired = chrono::steady_clock::now();
+                bool worked = performRole(role, state, people);
+                auto finished = chrono::steady_clock::now();  // Before unlocking, so holds never overlap
+                guard.unlock();
+                mine.waitSeconds += chrono::duration<double>(acquired - arrived).count();
+                mine.holdSeconds += chrono::duration<double>(finished - acquired).count();
+                if (worked) {
+                    mine.latencies.push_back(chrono::duration<float, milli>(finished - scheduled).count());
+                } else {
+                    mine.idle++;
+                }
+                scheduled += interval;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    quiet.restore();
+    double seconds = max(plan.seconds, 1e-9);
+
+    // One line per role
+    cout << "\n" << roles.size() << " actors for " << plan.seconds << " s on " << thread::hardware_concurrency()
+         << " hardware thread(s)\n\n";
+    cout << left << setw(12) << "Role" << right << setw(7) << "Actors" << setw(9) << "Ops/s" << setw(10)
+         << "p50 ms" << setw(10) << "p99 ms" << setw(11) << "p99.9 ms" << setw(10) << "max ms" << setw(10)
+         << "Hold us" << setw(9) << "Wait %" << setw(12) << "Contended" << setw(7) << "Idle" << "\n";
+    double totalHold = 0;
+    size_t totalOps = 0;
+    for (size_t role = 0; role < LOAD_ROLES; role++) {
+        if (!plan.actors[role]) continue;
+        vector<float> latencies;
+        ActorFigures sum;
+        for (size_t actor = 0; actor < roles.size(); actor++) {
+            if (roles[actor] != role) continue;
+            const ActorFigures& one = figures[actor];
+            latencies.insert(latencies.end(), one.latencies.begin(), one.latencies.end());
+            sum.idle += one.idle;
+            sum.contended += one.contended;
+            sum.waitSeconds += one.waitSeconds;
+            sum.holdSeconds += one.holdSeconds;
+        }
+        sort(latencies.begin(), latencies.end());
+        size_t attempts = max<size_t>(latencies.size() + sum.idle, 1);
+        totalHold += sum.holdSeconds;
+        totalOps += latencies.size();
+        cout << left << setw(12) << loadRoleNames[role] << right << setw(7) << plan.actors[role] << fixed
+             << setprecision(0) << setw(9) << latencies.size() / seconds << setprecision(2) << setw(10)
+             << percentile(latencies, 0.5) << setw(10) << percentile(latencies, 0.99) << setw(11)
+             << percentile(latencies, 0.999) << setw(10) << (latencies.empty() ? 0 : latencies.back())
+             << setprecision(1) << setw(10) << sum.holdSeconds * 1e6 / attempts << setw(9)
+             << 100 * sum.waitSeconds / max(sum.waitSeconds + sum.holdSeconds, 1e-9) << setw(11)
+             << 100.0 * sum.contended / attempts << "%" << setw(7) << sum.idle << "\n";
+        cout.unsetf(ios::floatfield);
+        cout << setprecision(6);
+    }
+    double busy = 100 * totalHold / seconds;
+    cout << fixed << setprecision(1) << "\nTotal: " << totalOps / seconds << " operations/s; the hospital lock was held "
+         << busy << "% of the run.\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+    if (busy > 90) {
+        cout << "The single writer is saturated: more actors add latency, not throughput. The role with the\n";
+        cout << "largest hold time per operation is the one to speed up first (all roles share one lock).\n";
+    }
+}
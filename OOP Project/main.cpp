@@ -1,43 +1,88 @@
 #include "hospital.h"         // Main hospital management system header
 #include "authentication.h"   // User authentication system
+#include "commands.h"         // Menu changes as undoable commands
+#include "session.h"          // Session record and replay
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
     // Initialize hospital system and set name
     HospitalSystem hospital;
     string hospitalName = "City General Hospital";
     string currentRole;  // Tracks logged-in user's role
     
-    // ========== SAMPLE DATA INITIALIZATION ========== //
-    // Create sample patient with complete details
-    Patient* p1 = new Patient(101, "John Smith", 35, "Male", "123 Main St", "555-1234", "O+", 201);
+    // ========== STARTUP MODE ========== //
+    // "--primary <log>" ships every change to <log>; "--standby <log>" follows it;
+    // "--checkpoint <dir>" restores from the checkpoints in <dir> (or starts them there);
+    // "--record <file>" saves everything typed to <file> except passwords;
+    // "--replay <file> [password]" runs it again, typing [password] at password prompts
+    string startupMode = argc >= 3 ? argv[1] : "";
+    SessionRecorder recorder;
+    SessionReplayer replayer;
+    if (startupMode == "--record") {
+        if (!recorder.start(argv[2])) {
+            cout << "Error: could not create session file " << argv[2] << "\n";
+            return 1;
+        }
+        cout << "Recording everything typed to " << argv[2] << ". Passwords are saved as a placeholder;\n"
+             << "replay with a test password: program --replay " << argv[2] << " <password>\n";
+    }
+    if (startupMode == "--replay") {
+        if (!replayer.load(argv[2])) {
+            cout << "Error: " << argv[2] << " is not a recorded session\n";
+            return 1;
+        }
+        if (argc >= 4) replayer.setPassword(argv[3]);
+        cout << "Replaying " << replayer.lineCount() << " recorded input lines from " << argv[2] << "...\n";
+        setScreenClearing(false);
+        replayer.start();  // Sample data loading is timed as the startup
+    }
+    if (startupMode == "--primary" && !hospital.startShipping(argv[2])) {
+        cout << "Error: could not create replication log " << argv[2] << "\n";
+        return 1;
+    }
+    bool restored = startupMode == "--checkpoint" && hospital.restoreCheckpoint(argv[2], 300);
+    if (restored) {
+        cout << "Restored from the checkpoints in " << argv[2] << "\n";
+    }
+    if (startupMode == "--standby") {
+        // The primary's log already holds its sample data
+        if (!runStandby(hospital, argv[2])) return 0;
+    } else if (!restored) {
+        // ========== SAMPLE DATA INITIALIZATION ========== //
+        // Create sample patient with complete details
+        Patient* p1 = hospital.newPatient(101, "John Smith", 35, "Male", "123 Main St", "555-1234", "O+", 201);
     
-    // Create sample doctor with specialization
-    Doctor* d1 = new Doctor(201, "Dr. Sarah Johnson", 45, "Female", "456 Oak Ave", "555-5678", 
-                          150000, "Cardiology", "01/01/2010", "Cardiologist", "MD12345");
+        // Create sample doctor with specialization
+        Doctor* d1 = hospital.newDoctor(201, "Dr. Sarah Johnson", 45, "Female", "456 Oak Ave", "555-5678", 
+                              150000, "Cardiology", "01/01/2010", "Cardiologist", "MD12345");
     
-    // Create sample nurse with shift info
-    Nurse* n1 = new Nurse(301, "Emily Davis", 28, "Female", "789 Pine Rd", "555-9012", 
-                        65000, "Cardiology", "15/06/2018", "Day", "RN");
+        // Create sample nurse with shift info
+        Nurse* n1 = hospital.newNurse(301, "Emily Davis", 28, "Female", "789 Pine Rd", "555-9012", 
+                            65000, "Cardiology", "15/06/2018", "Day", "RN");
     
-    // Create sample medicines
-    Medicine* m1 = new Medicine("Paracetamol", 5.99, 100, "01/01/2025");
-    Medicine* m2 = new Medicine("Ibuprofen", 8.50, 75, "01/06/2024");
+        // Create sample medicines
+        Medicine* m1 = hospital.newMedicine("Paracetamol", 5.99, 100, "01/01/2025");
+        Medicine* m2 = hospital.newMedicine("Ibuprofen", 8.50, 75, "01/06/2024");
     
-    // Create sample rooms of different types
-    Room* r1 = new Room("General");
-    Room* r2 = new Room("ICU");
-    Room* r3 = new Room("Private");
+        // Create sample rooms of different types
+        Room* r1 = hospital.newRoom("General");
+        Room* r2 = hospital.newRoom("ICU");
+        Room* r3 = hospital.newRoom("Private");
 
-    // Add all sample data to hospital system
-    hospital.addPatient(p1);
-    hospital.addDoctor(d1);
-    hospital.addNurse(n1);
-    hospital.addMedicine(m1);
-    hospital.addMedicine(m2);
-    hospital.addRoom(r1);
-    hospital.addRoom(r2);
-    hospital.addRoom(r3);
+        // Add all sample data to hospital system
+        hospital.addPatient(p1);
+        hospital.addDoctor(d1);
+        hospital.addNurse(n1);
+        hospital.addMedicine(m1);
+        hospital.addMedicine(m2);
+        hospital.addRoom(r1);
+        hospital.addRoom(r2);
+        hospital.addRoom(r3);
+    }
+    if (startupMode == "--checkpoint" && !restored && !hospital.enableCheckpoints(argv[2], 300)) {
+        cout << "Error: could not write checkpoints to " << argv[2] << "\n";
+        return 1;
+    }
 
     // ========== MAIN PROGRAM LOOP ========== //
     int mainChoice;
@@ -155,17 +200,17 @@ int main() {
                                 if (currentRole == "Doctor") {
                                     Doctor* doctor;
                                     hospital.findDoctor(id, doctor);
-                                    if (doctor) doctor->updateContactInfo(address, contact);
+                                    if (doctor) hospital.execute(make_unique<UpdateContactCommand>(doctor, address, contact));
                                 }
                                 else if (currentRole == "Nurse") {
                                     Nurse* nurse;
                                     hospital.findNurse(id, nurse);
-                                    if (nurse) nurse->updateContactInfo(address, contact);
+                                    if (nurse) hospital.execute(make_unique<UpdateContactCommand>(nurse, address, contact));
                                 }
                                 else if (currentRole == "Patient") {
                                     Patient* patient;
                                     hospital.findPatient(id, patient);
-                                    if (patient) patient->updateContactInfo(address, contact);
+                                    if (patient) hospital.execute(make_unique<UpdateContactCommand>(patient, address, contact));
                                 }
                                 break;
                             }
@@ -177,12 +222,12 @@ int main() {
                                     cin >> regChoice;
                                     if (regChoice == 1) {
                                         Doctor* doctor;
-                                        createDoctor(doctor);
-                                        hospital.addDoctor(doctor);
+                                        createDoctor(hospital, doctor);
+                                        hospital.execute(make_unique<RegisterCommand>(doctor));
                                     } else {
                                         Nurse* nurse;
-                                        createNurse(nurse);
-                                        hospital.addNurse(nurse);
+                                        createNurse(hospital, nurse);
+                                        hospital.execute(make_unique<RegisterCommand>(nurse));
                                     }
                                 }
                                 else if (currentRole == "Doctor") {
@@ -215,9 +260,8 @@ int main() {
                                         cout << "Enter Doctor ID: ";
                                         cin >> doctorId;
                                         cin.ignore();
-                                        cout << "Enter Date/Time (DD/MM/YYYY HH:MM): ";
-                                        getline(cin, date);
-                                        patient->scheduleAppointment(doctorId, date);
+                                        date = readField("Enter Date/Time (DD/MM/YYYY HH:MM): ", isValidDateTime, DATE_TIME_RULE);
+                                        hospital.execute(make_unique<ScheduleAppointmentCommand>(patient, doctorId, date));
                                     }
                                 }
                                 break;
@@ -254,6 +298,9 @@ int main() {
                     cout << "5. Nurse Operations\n";
                     cout << "6. Inventory Management\n";
                     cout << "7. Billing Management\n";
+                    cout << "8. System Diagnostics\n";
+                    cout << "9. Find Person\n";
+                    cout << "10. Undo / Redo\n";
                     cout << "0. Back to Main Menu\n";
                     cout << "Enter your choice: ";
                     cin >> quickChoice;
@@ -263,8 +310,12 @@ int main() {
                     switch(quickChoice) {
                         case 1: {  // New patient registration
                             Patient* patient;
-                            createPatient(patient);
-                            hospital.addPatient(patient);
+                            createPatient(hospital, patient);
+                            if (confirmNotDuplicate(hospital, patient)) {
+                                hospital.execute(make_unique<RegisterCommand>(patient));
+                            } else {
+                                hospital.discardPatient(patient);  // Clerk chose the existing record
+                            }
                             break;
                         }
                         case 2:  // View all records
@@ -290,7 +341,7 @@ int main() {
                             Doctor* doctor;
                             hospital.findDoctor(id, doctor);
                             if (doctor) {
-                                doctorOperations(doctor);
+                                doctorOperations(hospital, doctor);
                             } else {
                                 cout << "\nDoctor not found!\n";
                             }
@@ -303,7 +354,7 @@ int main() {
                             Nurse* nurse;
                             hospital.findNurse(id, nurse);
                             if (nurse) {
-                                nurseOperations(nurse);
+                                nurseOperations(hospital, nurse);
                             } else {
                                 cout << "\nNurse not found!\n";
                             }
@@ -315,6 +366,15 @@ int main() {
                         case 7:  // Billing management
                             billingOperations(hospital);
                             break;
+                        case 8:  // Memory and performance diagnostics
+                            diagnosticsOperations(hospital);
+                            break;
+                        case 9:  // Lookup by name and contact details
+                            lookupOperations(hospital);
+                            break;
+                        case 10:  // Take back or repeat recent changes
+                            historyOperations(hospital);
+                            break;
                         case 0:  // Return to main menu
                             break;
                         default:
@@ -333,5 +393,14 @@ int main() {
         if (mainChoice != 0) pressEnterToContinue();
     } while (mainChoice != 0);  // Continue until exit
 
+    // Changes since the last periodic save
+    if (hospital.isCheckpointing()) hospital.saveCheckpoint();
+
+    if (startupMode == "--record") {
+        recorder.stop();
+        cout << "Session of " << recorder.lineCount() << " input lines saved to " << argv[2] << "\n";
+    }
+    if (startupMode == "--replay") replayer.finish();
+
     return 0;
 }
\ No newline at end of file
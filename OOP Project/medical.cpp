@@ -1,4 +1,5 @@
 #include "hospital.h"  // Includes the main hospital system header
+#include "varint.h"    // For compact plan history
 
 // ========== APPOINTMENT CLASS IMPLEMENTATION ========== //
 
@@ -6,35 +7,109 @@
 int Appointment::nextId = 1;
 
 // Constructor implementation
-Appointment::Appointment(int pId, int dId, const string& dt) 
+Appointment::Appointment(int pId, int dId, string_view dt)
     : appointmentId(nextId++),  // Auto-increments ID
       patientId(pId),          // Sets patient ID
       doctorId(dId),           // Sets doctor ID
-      dateTime(dt),            // Sets appointment datetime
-      status("Pending"),       // Default status
-      diagnosisNotes("") {}    // Empty notes initially
+      dateTime(packDateTime(dt)),  // Sets appointment datetime (packed)
+      diagnosisNotes(""),      // Empty notes initially
+      status(AppointmentStatus::Pending),  // Default status
+      lastAccess(time(nullptr)) {}  // New appointments are in use
+
+// Appointment status names, indexed by AppointmentStatus
+const string& statusName(AppointmentStatus status) {
+    static const string names[] = { "Pending", "Completed", "Cancelled" };
+    return names[static_cast<int>(status)];
+}
+
+// Only a pending appointment is completed or cancelled; completing is undone back to pending
+bool isValidTransition(AppointmentStatus from, AppointmentStatus to) {
+    if (from == AppointmentStatus::Pending) return to != AppointmentStatus::Pending;
+    return from == AppointmentStatus::Completed && to == AppointmentStatus::Pending;
+}
+
+// Sets the ID the next appointment receives
+void Appointment::setNextId(int id) { nextId = id; }
+
+// ID the next appointment receives
+int Appointment::getNextId() { return nextId; }
+
+// Restores compressed notes without marking them as used
+void Appointment::restoreText() const {
+    if (!coldStore) return;
+    diagnosisNotes = coldStore->load(coldNotes);
+    coldStore->release(coldNotes);
+    coldStore = nullptr;
+}
+
+// Restores compressed notes and marks them as recently used
+void Appointment::touchText() const {
+    lastAccess = time(nullptr);
+    restoreText();
+}
+
+// Compresses the notes if unused since idleSince
+bool Appointment::freezeText(ColdTextStore& store, time_t idleSince) {
+    if (coldStore || diagnosisNotes.empty() || lastAccess >= idleSince) return false;
+    coldNotes = store.store(diagnosisNotes);
+    coldStore = &store;
+    string().swap(diagnosisNotes);  // Releases the text
+    return true;
+}
+
+// Frees the compressed notes of an appointment that is being dropped
+void Appointment::releaseColdText() const {
+    if (!coldStore) return;
+    coldStore->release(coldNotes);
+    coldStore = nullptr;
+}
 
 // Marks appointment as complete with doctor's notes
-void Appointment::completeAppointment(const string& notes) {
-    status = "Completed";             // Updates status
+bool Appointment::completeAppointment(const string& notes) {
+    if (!isValidTransition(status, AppointmentStatus::Completed)) {
+        cout << "\nAppointment #" << appointmentId << " is " << statusName(status) << " and cannot be completed.\n";
+        return false;
+    }
+    touchText();
+    status = AppointmentStatus::Completed;  // Updates status
     diagnosisNotes = notes;           // Stores diagnosis
     cout << "\nAppointment #" << appointmentId << " marked as completed.\n";  // Confirmation
+    return true;
 }
 
 // Cancels the appointment
-void Appointment::cancelAppointment() {
-    status = "Cancelled";  // Updates status
+bool Appointment::cancelAppointment() {
+    if (!isValidTransition(status, AppointmentStatus::Cancelled)) {
+        cout << "\nAppointment #" << appointmentId << " is " << statusName(status) << " and cannot be cancelled.\n";
+        return false;
+    }
+    status = AppointmentStatus::Cancelled;  // Updates status
     cout << "\nAppointment #" << appointmentId << " has been cancelled.\n";  // Confirmation
+    return true;
+}
+
+// Returns a completed appointment to pending
+bool Appointment::reopenAppointment() {
+    if (!isValidTransition(status, AppointmentStatus::Pending)) {  // A cancelled one is not reopened
+        cout << "\nAppointment #" << appointmentId << " is " << statusName(status) << " and cannot be reopened.\n";
+        return false;
+    }
+    touchText();
+    status = AppointmentStatus::Pending;  // Back to the state before completion
+    diagnosisNotes.clear();   // Notes belonged to the completion
+    cout << "\nAppointment #" << appointmentId << " reopened.\n";  // Confirmation
+    return true;
 }
 
 // Displays complete appointment details
 void Appointment::displayDetails() const {
+    touchText();
     cout << "\n=== APPOINTMENT DETAILS ===\n";  // Header
     cout << "Appointment ID: " << appointmentId << "\n";
     cout << "Patient ID: " << patientId << "\n";
     cout << "Doctor ID: " << doctorId << "\n";
-    cout << "Date/Time: " << dateTime << "\n";
-    cout << "Status: " << status << "\n";
+    cout << "Date/Time: " << formatDateTime(dateTime) << "\n";
+    cout << "Status: " << statusName(status) << "\n";
     if (!diagnosisNotes.empty()) {  // Only shows notes if exists
         cout << "Diagnosis Notes: " << diagnosisNotes << "\n";
     }
@@ -50,7 +125,42 @@ int Appointment::getPatientId() const { return patientId; }
 int Appointment::getDoctorId() const { return doctorId; }
 
 // Getter for appointment status
-string Appointment::getStatus() const { return status; }
+AppointmentStatus Appointment::getStatus() const { return status; }
+
+// Getter for diagnosis notes
+string Appointment::getDiagnosisNotes() const {
+    touchText();
+    return diagnosisNotes;
+}
+
+// Writes the appointment (notes included) to a byte buffer
+void Appointment::writeTo(vector<uint8_t>& out) const {
+    writeVarint(out, static_cast<uint32_t>(appointmentId));
+    writeVarint(out, static_cast<uint32_t>(patientId));
+    writeVarint(out, static_cast<uint32_t>(doctorId));
+    writeVarint(out, dateTime);
+    writeVarint(out, static_cast<uint32_t>(status));
+    writeString(out, coldStore ? coldStore->load(coldNotes) : diagnosisNotes);  // Cold notes stay compressed
+    writeVarint(out, static_cast<uint64_t>(lastAccess));
+}
+
+// Reads an appointment written by writeTo (keeps its original ID)
+Appointment Appointment::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    Appointment appt;
+    appt.appointmentId = static_cast<int>(readVarint(in, pos));
+    appt.patientId = static_cast<int>(readVarint(in, pos));
+    appt.doctorId = static_cast<int>(readVarint(in, pos));
+    appt.dateTime = static_cast<PackedDateTime>(readVarint(in, pos));
+    appt.status = static_cast<AppointmentStatus>(readVarint(in, pos));
+    appt.diagnosisNotes = readString(in, pos);
+    appt.lastAccess = static_cast<time_t>(readVarint(in, pos));
+    return appt;
+}
+
+// Object size plus owned heap memory
+size_t Appointment::memoryUsage() const {
+    return sizeof(Appointment) + stringHeapBytes(diagnosisNotes);
+}
 
 // ========== PRESCRIPTION CLASS IMPLEMENTATION ========== //
 
@@ -61,14 +171,18 @@ int Prescription::nextId = 1;
 Prescription::Prescription(int pId, int dId, const string& date) 
     : prescriptionId(nextId++),  // Auto-increments ID
       patientId(pId),           // Sets patient ID
-      doctorId(dId) {           // Sets doctor ID
-    dateIssued = date.empty() ? "Current Date" : date;  // Defaults to current date if empty
-}
+      doctorId(dId),            // Sets doctor ID
+      dateIssued(date.empty() ? currentDateTime() : packDateTime(date)) {}  // Defaults to now if empty
+
+// Sets the ID the next prescription receives
+void Prescription::setNextId(int id) { nextId = id; }
+
+// ID the next prescription receives
+int Prescription::getNextId() { return nextId; }
 
 // Adds medication to prescription
 void Prescription::addMedication(const string& med, const string& dosage) {
-    medications.push_back(med);    // Stores medication name
-    dosages.push_back(dosage);     // Stores dosage information
+    drugs.push_back({ InternedString(med), InternedString(dosage) });  // Stores the shared name and dosage
     cout << "\nAdded " << med << " (" << dosage << ") to prescription #" 
          << prescriptionId << "\n";  // Confirmation
 }
@@ -78,49 +192,249 @@ void Prescription::display() const {
     cout << "\n=== PRESCRIPTION #" << prescriptionId << " ===\n";
     cout << "Patient ID: " << patientId << "\n";
     cout << "Doctor ID: " << doctorId << "\n";
-    cout << "Date Issued: " << dateIssued;
+    cout << "Date Issued: " << formatDate(dateIssued) << "\n";
     cout << "Medications:\n";
     // Lists all medications with dosages
-    for (size_t i = 0; i < medications.size(); i++) {
-        cout << "- " << medications[i] << " (" << dosages[i] << ")\n";
+    for (const auto& drug : drugs) {
+        cout << "- " << drug.medication.str() << " (" << drug.dosage.str() << ")\n";
     }
 }
 
 // Getter for prescription ID
 int Prescription::getId() const { return prescriptionId; }
 
+// Writes the prescription to a byte buffer
+void Prescription::writeTo(vector<uint8_t>& out) const {
+    writeVarint(out, static_cast<uint32_t>(prescriptionId));
+    writeVarint(out, static_cast<uint32_t>(patientId));
+    writeVarint(out, static_cast<uint32_t>(doctorId));
+    writeVarint(out, drugs.size());
+    for (const auto& drug : drugs) {
+        writeString(out, drug.medication.str());
+        writeString(out, drug.dosage.str());
+    }
+    writeVarint(out, dateIssued);
+}
+
+// Reads a prescription written by writeTo (keeps its original ID)
+Prescription Prescription::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    Prescription presc;
+    presc.prescriptionId = static_cast<int>(readVarint(in, pos));
+    presc.patientId = static_cast<int>(readVarint(in, pos));
+    presc.doctorId = static_cast<int>(readVarint(in, pos));
+    size_t count = static_cast<size_t>(readVarint(in, pos));
+    presc.drugs.resize(count);
+    for (auto& drug : presc.drugs) {
+        drug.medication = readString(in, pos);
+        drug.dosage = readString(in, pos);
+    }
+    presc.dateIssued = static_cast<PackedDateTime>(readVarint(in, pos));
+    return presc;
+}
+
+// Object size plus owned heap memory
+size_t Prescription::memoryUsage() const {
+    return sizeof(Prescription) + drugs.capacity() * sizeof(PrescribedDrug);  // Text is in the intern table
+}
+
 // ========== MEDICAL RECORD CLASS IMPLEMENTATION ========== //
 
 // Static member initialization - tracks next record ID
 int MedicalRecord::nextId = 1;
 
 // Constructor implementation
-MedicalRecord::MedicalRecord(int pId, int dId, const string& diag, const string& plan)
+MedicalRecord::MedicalRecord(int pId, int dId, string diag, string plan)
     : recordId(nextId++),  // Auto-increments ID
       patientId(pId),      // Sets patient ID
       doctorId(dId),       // Sets doctor ID
-      diagnosis(diag),     // Stores initial diagnosis
-      treatmentPlan(plan) {} // Stores treatment plan
+      diagnosis(move(diag)),     // Stores initial diagnosis
+      treatmentPlan(move(plan)), // Stores treatment plan
+      lastAccess(time(nullptr)) {}  // New records are in use
+
+// Sets the ID the next record receives
+void MedicalRecord::setNextId(int id) { nextId = id; }
+
+// ID the next record receives
+int MedicalRecord::getNextId() { return nextId; }
+
+// Restores compressed text without marking it as used.
+// Compressed layout: diagnosis, plan, test count, tests, plan history, each
+// length-prefixed with a varint.
+void MedicalRecord::restoreText() const {
+    if (!coldStore) return;
+    string blob = coldStore->load(coldText);
+    coldStore->release(coldText);
+    coldStore = nullptr;
+
+    vector<uint8_t> bytes(blob.begin(), blob.end());
+    size_t pos = 0;
+    diagnosis = readString(bytes, pos);
+    treatmentPlan = readString(bytes, pos);
+    testReports.resize(readVarint(bytes, pos));
+    for (auto& report : testReports) report = readString(bytes, pos);
+    string history = readString(bytes, pos);
+    planHistory.assign(history.begin(), history.end());
+}
+
+// Restores compressed text and marks it as recently used
+void MedicalRecord::touchText() const {
+    lastAccess = time(nullptr);
+    restoreText();
+}
+
+// Compresses the text if unused since idleSince
+bool MedicalRecord::freezeText(ColdTextStore& store, time_t idleSince) {
+    if (coldStore || lastAccess >= idleSince) return false;
+    vector<uint8_t> blob;
+    writeString(blob, diagnosis);
+    writeString(blob, treatmentPlan);
+    writeVarint(blob, testReports.size());
+    for (const auto& report : testReports) writeString(blob, report);
+    writeString(blob, string(planHistory.begin(), planHistory.end()));
+
+    coldText = store.store(string(blob.begin(), blob.end()));
+    coldStore = &store;
+    string().swap(diagnosis);  // Releases the text
+    string().swap(treatmentPlan);
+    vector<string>().swap(testReports);
+    vector<uint8_t>().swap(planHistory);
+    return true;
+}
+
+// Frees the compressed text of a record that is being dropped
+void MedicalRecord::releaseColdText() const {
+    if (!coldStore) return;
+    coldStore->release(coldText);
+    coldStore = nullptr;
+}
 
 // Adds test result to medical record
 void MedicalRecord::addTestResult(const string& result) {
+    touchText();
     testReports.push_back(result);  // Stores test result
     cout << "\nAdded test result to record #" << recordId << "\n";  // Confirmation
 }
 
-// Updates the treatment plan
+// Updates the treatment plan.
+// The replaced plan is stored as a reverse delta against the new one:
+// [time replaced][shared prefix length][shared suffix length][middle length][middle bytes]
 void MedicalRecord::updateTreatmentPlan(const string& newPlan) {
+    touchText();
+    size_t prefix = 0;
+    while (prefix < treatmentPlan.size() && prefix < newPlan.size() && treatmentPlan[prefix] == newPlan[prefix]) {
+        prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < treatmentPlan.size() - prefix && suffix < newPlan.size() - prefix &&
+           treatmentPlan[treatmentPlan.size() - 1 - suffix] == newPlan[newPlan.size() - 1 - suffix]) {
+        suffix++;
+    }
+    writeVarint(planHistory, static_cast<uint64_t>(time(nullptr)));
+    writeVarint(planHistory, prefix);
+    writeVarint(planHistory, suffix);
+    writeVarint(planHistory, treatmentPlan.size() - prefix - suffix);
+    planHistory.insert(planHistory.end(), treatmentPlan.begin() + prefix, treatmentPlan.end() - suffix);
+    planRevisions++;
+
     treatmentPlan = newPlan;  // Updates treatment plan
     cout << "\nUpdated treatment plan for record #" << recordId << "\n";  // Confirmation
 }
 
+// Drops the newest test result
+bool MedicalRecord::removeLastTestResult() {
+    touchText();
+    if (testReports.empty()) return false;
+    testReports.pop_back();
+    cout << "\nRemoved latest test result from record #" << recordId << "\n";  // Confirmation
+    return true;
+}
+
+// Restores the plan replaced by the last update and drops its delta, as if
+// the update had never been made
+bool MedicalRecord::revertTreatmentPlan() {
+    if (planRevisions == 0) return false;
+    string previous = getTreatmentPlanVersion(planRevisions);  // Applies only the newest delta
+
+    // The newest delta is the last one in the history
+    size_t pos = 0, newest = 0;
+    while (pos < planHistory.size()) {
+        newest = pos;
+        readVarint(planHistory, pos);  // Time
+        readVarint(planHistory, pos);  // Prefix
+        readVarint(planHistory, pos);  // Suffix
+        pos += readVarint(planHistory, pos);  // Middle
+    }
+    planHistory.resize(newest);
+    planRevisions--;
+    treatmentPlan = previous;
+    cout << "\nRestored previous treatment plan for record #" << recordId << "\n";  // Confirmation
+    return true;
+}
+
+// Number of treatment plan versions (original plus revisions)
+int MedicalRecord::getPlanVersionCount() const { return planRevisions + 1; }
+
+// Rebuilds a treatment plan version by undoing deltas from the current plan;
+// changedAt receives when that version was replaced (0 for the current one)
+string MedicalRecord::getTreatmentPlanVersion(int version, time_t* changedAt) const {
+    touchText();
+    if (changedAt) *changedAt = 0;
+    if (version < 1 || version > planRevisions) return treatmentPlan;  // Current version costs nothing
+
+    // Deltas have variable length, so locate them front to back first
+    vector<size_t> offsets;
+    size_t pos = 0;
+    while (pos < planHistory.size()) {
+        offsets.push_back(pos);
+        readVarint(planHistory, pos);  // Time
+        readVarint(planHistory, pos);  // Prefix
+        readVarint(planHistory, pos);  // Suffix
+        pos += readVarint(planHistory, pos);  // Middle
+    }
+
+    string text = treatmentPlan;
+    for (int i = planRevisions - 1; i >= version - 1; i--) {
+        pos = offsets[i];
+        time_t replaced = static_cast<time_t>(readVarint(planHistory, pos));
+        size_t prefix = readVarint(planHistory, pos);
+        size_t suffix = readVarint(planHistory, pos);
+        size_t middle = readVarint(planHistory, pos);
+        text = text.substr(0, prefix) +
+               string(planHistory.begin() + pos, planHistory.begin() + pos + middle) +
+               text.substr(text.size() - suffix);
+        if (changedAt) *changedAt = replaced;
+    }
+    return text;
+}
+
+// Displays every version of the treatment plan, oldest first
+void MedicalRecord::displayPlanHistory() const {
+    cout << "\n=== TREATMENT PLAN HISTORY: RECORD #" << recordId << " ===\n";
+    for (int version = 1; version <= getPlanVersionCount(); version++) {
+        time_t replaced;
+        string plan = getTreatmentPlanVersion(version, &replaced);
+        cout << "Version " << version << ": " << plan;
+        if (replaced) {
+            char when[20];
+            strftime(when, sizeof(when), "%d/%m/%Y %H:%M", localtime(&replaced));
+            cout << "  (replaced " << when << ")";
+        } else {
+            cout << "  (current)";
+        }
+        cout << "\n";
+    }
+}
+
 // Displays complete medical record
 void MedicalRecord::display() const {
+    touchText();
     cout << "\n=== MEDICAL RECORD #" << recordId << " ===\n";
     cout << "Patient ID: " << patientId << "\n";
     cout << "Doctor ID: " << doctorId << "\n";
     cout << "Diagnosis: " << diagnosis << "\n";
-    cout << "Treatment Plan: " << treatmentPlan << "\n";
+    cout << "Treatment Plan: " << treatmentPlan;
+    if (planRevisions > 0) cout << " (version " << getPlanVersionCount() << ")";
+    cout << "\n";
     if (!testReports.empty()) {  // Only shows tests if exists
         cout << "Test Results:\n";
         for (const auto& test : testReports) {
@@ -129,5 +443,58 @@ void MedicalRecord::display() const {
     }
 }
 
+// Appends all clinical text of the record
+void MedicalRecord::collectText(vector<string>& fields) const {
+    touchText();
+    fields.push_back(diagnosis);
+    fields.push_back(treatmentPlan);
+    fields.insert(fields.end(), testReports.begin(), testReports.end());
+}
+
+// Writes the record (text and plan history included) to a byte buffer
+void MedicalRecord::writeTo(vector<uint8_t>& out) const {
+    writeVarint(out, static_cast<uint32_t>(recordId));
+    writeVarint(out, static_cast<uint32_t>(patientId));
+    writeVarint(out, static_cast<uint32_t>(doctorId));
+    if (coldStore) {
+        string blob = coldStore->load(coldText);  // Same layout as the fields below; text stays compressed
+        out.insert(out.end(), blob.begin(), blob.end());
+    } else {
+        writeString(out, diagnosis);
+        writeString(out, treatmentPlan);
+        writeVarint(out, testReports.size());
+        for (const auto& report : testReports) writeString(out, report);
+        writeString(out, string(planHistory.begin(), planHistory.end()));
+    }
+    writeVarint(out, static_cast<uint32_t>(planRevisions));
+    writeVarint(out, static_cast<uint64_t>(lastAccess));
+}
+
+// Reads a record written by writeTo (keeps its original ID)
+MedicalRecord MedicalRecord::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    MedicalRecord record;
+    record.recordId = static_cast<int>(readVarint(in, pos));
+    record.patientId = static_cast<int>(readVarint(in, pos));
+    record.doctorId = static_cast<int>(readVarint(in, pos));
+    record.diagnosis = readString(in, pos);
+    record.treatmentPlan = readString(in, pos);
+    record.testReports.resize(readVarint(in, pos));
+    for (auto& report : record.testReports) report = readString(in, pos);
+    string history = readString(in, pos);
+    record.planHistory.assign(history.begin(), history.end());
+    record.planRevisions = static_cast<int>(readVarint(in, pos));
+    record.lastAccess = static_cast<time_t>(readVarint(in, pos));
+    return record;
+}
+
 // Getter for record ID
-int MedicalRecord::getId() const { return recordId; }
\ No newline at end of file
+int MedicalRecord::getId() const { return recordId; }
+
+// Getter for patient ID
+int MedicalRecord::getPatientId() const { return patientId; }
+
+// Object size plus owned heap memory
+size_t MedicalRecord::memoryUsage() const {
+    return sizeof(MedicalRecord) + stringHeapBytes(diagnosis) + stringHeapBytes(treatmentPlan) +
+           stringVectorHeapBytes(testReports) + vectorBufferBytes(planHistory);
+}
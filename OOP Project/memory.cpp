@@ -0,0 +1,110 @@
+#include "memory.h"  // Memory accounting declarations
+#include <iomanip>   // For formatted report columns
+
+// ========== FOOTPRINT HELPERS ========== //
+
+// Returns display name of a subsystem
+const char* subsystemName(Subsystem subsystem) {
+    switch (subsystem) {
+        case Subsystem::Persons:       return "Persons";
+        case Subsystem::Appointments:  return "Appointments";
+        case Subsystem::Prescriptions: return "Prescriptions";
+        case Subsystem::Records:       return "Records";
+        case Subsystem::Inventory:     return "Inventory";
+        case Subsystem::Billing:       return "Billing";
+        default:                       return "Unknown";
+    }
+}
+
+// Heap bytes owned by a string
+size_t stringHeapBytes(const string& s) {
+    const char* object = reinterpret_cast<const char*>(&s);
+    const char* data = s.data();
+    if (data >= object && data < object + sizeof(string)) {
+        return 0;  // Characters live inside the string object itself
+    }
+    return s.capacity() + 1;  // Heap buffer includes terminating null
+}
+
+// Heap bytes owned by a vector of strings
+size_t stringVectorHeapBytes(const vector<string>& v) {
+    size_t bytes = vectorBufferBytes(v);  // Buffer holding the string objects
+    for (const auto& s : v) {
+        bytes += stringHeapBytes(s);  // Characters of each string
+    }
+    return bytes;
+}
+
+// ========== MEMORY REPORT IMPLEMENTATION ========== //
+
+// Records one object of the given type and its footprint
+void MemoryReport::record(Subsystem subsystem, const string& typeName, size_t bytes) {
+    Usage& total = subsystems[static_cast<int>(subsystem)];
+    total.objects++;
+    total.bytes += bytes;
+    Usage& type = types[typeName];
+    type.objects++;
+    type.bytes += bytes;
+}
+
+// Adds bytes to a subsystem without counting a new object
+void MemoryReport::addOverhead(Subsystem subsystem, size_t bytes) {
+    subsystems[static_cast<int>(subsystem)].bytes += bytes;
+}
+
+// Getter for object count of a subsystem
+size_t MemoryReport::objectCount(Subsystem subsystem) const {
+    return subsystems[static_cast<int>(subsystem)].objects;
+}
+
+// Getter for byte count of a subsystem
+size_t MemoryReport::byteCount(Subsystem subsystem) const {
+    return subsystems[static_cast<int>(subsystem)].bytes;
+}
+
+// Total objects across all subsystems
+size_t MemoryReport::totalObjects() const {
+    size_t total = 0;
+    for (const auto& usage : subsystems) total += usage.objects;
+    return total;
+}
+
+// Total bytes across all subsystems
+size_t MemoryReport::totalBytes() const {
+    size_t total = 0;
+    for (const auto& usage : subsystems) total += usage.bytes;
+    return total;
+}
+
+// Prints the report with growth since the previous report
+void MemoryReport::display(const MemoryReport& previous) const {
+    cout << "\n=== MEMORY BY SUBSYSTEM ===\n";
+    cout << left << setw(16) << "Subsystem" << right << setw(10) << "Objects"
+         << setw(14) << "Bytes" << setw(14) << "Growth" << "\n";
+    for (int i = 0; i < static_cast<int>(Subsystem::Count); i++) {
+        Subsystem subsystem = static_cast<Subsystem>(i);
+        long long growth = static_cast<long long>(byteCount(subsystem)) -
+                           static_cast<long long>(previous.byteCount(subsystem));
+        cout << left << setw(16) << subsystemName(subsystem) << right
+             << setw(10) << objectCount(subsystem)
+             << setw(14) << byteCount(subsystem)
+             << setw(14) << showpos << growth << noshowpos << "\n";
+    }
+
+    cout << "\n=== MEMORY BY ENTITY TYPE ===\n";
+    cout << left << setw(16) << "Type" << right << setw(10) << "Objects"
+         << setw(14) << "Bytes" << setw(14) << "Avg/Object" << "\n";
+    for (const auto& type : types) {
+        cout << left << setw(16) << type.first << right
+             << setw(10) << type.second.objects
+             << setw(14) << type.second.bytes
+             << setw(14) << (type.second.objects ? type.second.bytes / type.second.objects : 0)
+             << "\n";
+    }
+
+    long long totalGrowth = static_cast<long long>(totalBytes()) -
+                            static_cast<long long>(previous.totalBytes());
+    cout << "\nTotal: " << totalObjects() << " objects, " << totalBytes() << " bytes ("
+         << showpos << totalGrowth << noshowpos << " since last report)\n";
+    cout << right;  // Restore default alignment
+}
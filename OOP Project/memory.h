@@ -0,0 +1,63 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <iostream>   // For report output
+#include <string>     // For string operations
+#include <vector>     // For vector footprint helpers
+#include <map>        // For per-type counters
+#include <cstddef>    // For size_t
+using namespace std;
+
+// Subsystems that memory usage is attributed to
+enum class Subsystem {
+    Persons,        // Patients, doctors and nurses
+    Appointments,   // Patient and doctor appointments
+    Prescriptions,  // Prescriptions and their medication lists
+    Records,        // Medical records and test reports
+    Inventory,      // Medicines and rooms
+    Billing,        // Bills, services and medicine lines
+    Count           // Number of subsystems (not a real subsystem)
+};
+
+// Returns display name of a subsystem
+const char* subsystemName(Subsystem subsystem);
+
+// Heap bytes owned by a string (0 when stored inline by small-string optimisation)
+size_t stringHeapBytes(const string& s);
+
+// Heap bytes owned by a vector of strings (buffer plus each string's heap)
+size_t stringVectorHeapBytes(const vector<string>& v);
+
+// Heap bytes of a vector's buffer (elements are counted by the caller)
+template <typename T>
+size_t vectorBufferBytes(const vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+// Collects object counts and byte totals per subsystem and per entity type
+class MemoryReport {
+private:
+    struct Usage {
+        size_t objects = 0;  // Number of live objects
+        size_t bytes = 0;    // Object size plus owned heap memory
+    };
+
+    Usage subsystems[static_cast<int>(Subsystem::Count)];  // Totals per subsystem
+    map<string, Usage> types;                              // Totals per entity type
+
+public:
+    // Records one object of the given type and its footprint
+    void record(Subsystem subsystem, const string& typeName, size_t bytes);
+
+    // Adds bytes to a subsystem without counting a new object (e.g. container slack)
+    void addOverhead(Subsystem subsystem, size_t bytes);
+
+    // Accessor methods
+    size_t objectCount(Subsystem subsystem) const;
+    size_t byteCount(Subsystem subsystem) const;
+    size_t totalObjects() const;
+    size_t totalBytes() const;
+
+    // Prints the report, showing growth relative to an earlier report
+    void display(const MemoryReport& previous) const;
+};
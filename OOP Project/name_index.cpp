@@ -0,0 +1,266 @@
+#include "name_index.h"  // Name index declarations
+#include "memory.h"      // For footprint helpers
+#include <algorithm>     // For sorting, heaps and set intersection
+#include <cctype>        // For character classification
+#include <iostream>      // For benchmark output
+#include <chrono>        // For benchmark timing
+#include <iterator>      // For back_inserter
+#include <bitset>        // For counting shared grams
+
+// Lowercase alphanumeric words of a name
+void NameIndex::splitWords(const string& name, vector<string>& words) {
+    words.clear();
+    string word;
+    for (size_t i = 0; i <= name.size(); i++) {
+        unsigned char c = i < name.size() ? static_cast<unsigned char>(name[i]) : ' ';
+        if (isalnum(c)) {
+            word += static_cast<char>(tolower(c));
+        } else if (!word.empty()) {
+            words.push_back(word);
+            word.clear();
+        }
+    }
+}
+
+// Distinct packed trigrams of a name
+void NameIndex::trigrams(const string& name, vector<uint32_t>& grams) {
+    grams.clear();
+    vector<string> words;
+    splitWords(name, words);
+    for (const auto& word : words) {
+        string padded = "  " + word + " ";  // Padding weights word starts and ends
+        for (size_t j = 0; j + 3 <= padded.size(); j++) {
+            grams.push_back(static_cast<uint32_t>(static_cast<unsigned char>(padded[j])) << 16 |
+                            static_cast<uint32_t>(static_cast<unsigned char>(padded[j + 1])) << 8 |
+                            static_cast<unsigned char>(padded[j + 2]));
+        }
+    }
+    sort(grams.begin(), grams.end());
+    grams.erase(unique(grams.begin(), grams.end()), grams.end());
+}
+
+// Indexes the name of the person at row
+void NameIndex::add(uint32_t row, const string& name) {
+    if (rowWordStart.empty()) rowWordStart.push_back(0);
+    while (rowWordStart.size() <= row) rowWordStart.push_back(static_cast<uint32_t>(rowWords.size()));  // Skipped rows have no words
+
+    vector<string> words;
+    splitWords(name, words);
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    vector<uint32_t> grams;
+    for (const auto& word : words) {
+        auto found = wordIds.find(word);
+        uint32_t wordId;
+        if (found != wordIds.end()) {
+            wordId = found->second;
+        } else {
+            wordId = static_cast<uint32_t>(wordRows.size());  // New word: index its trigrams
+            wordIds.emplace(word, wordId);
+            wordRows.emplace_back();
+            wordMasks.push_back(0);
+            trigrams(word, grams);
+            for (uint32_t gram : grams) wordPostings[gram].push_back(wordId);
+        }
+        wordRows[wordId].push_back(row);
+        rowWords.push_back(wordId);
+    }
+    rowWordStart.push_back(static_cast<uint32_t>(rowWords.size()));
+
+    trigrams(name, grams);
+    if (gramCounts.size() <= row) {
+        gramCounts.resize(row + 1, 0);
+        seen.resize(row + 1, 0);  // Scratch grows with the index, not on the first search
+    }
+    gramCounts[row] = static_cast<uint8_t>(min<size_t>(grams.size(), 255));
+    maxWords = max(maxWords, words.size());
+    if (!grams.empty()) minGrams = min<size_t>(minGrams, gramCounts[row]);
+}
+
+// Ranks rows by trigram similarity to the query
+void NameIndex::search(const string& query, size_t maxResults, vector<NameMatch>& matches) const {
+    vector<uint32_t> grams;
+    trigrams(query, grams);
+    if (grams.size() > 64) grams.resize(64);  // One mask bit per query gram
+    if (grams.empty() || maxResults == 0) return;
+    size_t queryGrams = grams.size();
+    size_t minOverlap = max<size_t>(1, (queryGrams + 2) / 3);
+
+    // Mark which query grams each word holds. A name's trigrams are the union of
+    // its words' trigrams, so OR-ing the masks of a row's words gives exactly the
+    // grams the row shares with the query.
+    vector<uint32_t> touched;
+    for (size_t i = 0; i < grams.size(); i++) {
+        auto it = wordPostings.find(grams[i]);
+        if (it == wordPostings.end()) continue;
+        for (uint32_t word : it->second) {
+            if (wordMasks[word] == 0) touched.push_back(word);
+            wordMasks[word] |= uint64_t(1) << i;
+        }
+    }
+
+    // Words holding the most query grams first (counting sort on grams held)
+    vector<uint8_t> held(touched.size());
+    size_t bucketStart[66] = {};
+    for (size_t i = 0; i < touched.size(); i++) {
+        held[i] = static_cast<uint8_t>(bitset<64>(wordMasks[touched[i]]).count());
+        bucketStart[64 - held[i] + 1]++;
+    }
+    for (size_t b = 1; b < 66; b++) bucketStart[b] += bucketStart[b - 1];
+    vector<pair<size_t, uint32_t>> order(touched.size());  // (grams held, word)
+    for (size_t i = 0; i < touched.size(); i++) order[bucketStart[64 - held[i]]++] = { held[i], touched[i] };
+
+    // Rows are scored the first time one of their words comes up. A row not
+    // seen yet uses only words that hold at most `held` query grams, so it
+    // shares at most maxWords * held of them; once that cannot beat the current
+    // k-th result (or reach a third of the query) the remaining words are skipped.
+    auto better = [](const NameMatch& a, const NameMatch& b) {
+        return a.score != b.score ? a.score > b.score : a.row < b.row;  // Ties: earlier registration first
+    };
+    vector<uint32_t> scored;
+    vector<NameMatch> found;  // Heap of the best results, worst on top
+    for (const auto& entry : order) {
+        size_t reach = min(queryGrams, maxWords * entry.first);
+        if (reach < minOverlap) break;
+        if (found.size() == maxResults && 2.0 * reach / (queryGrams + minGrams) < found.front().score) break;
+        for (uint32_t row : wordRows[entry.second]) {
+            if (seen[row]) continue;
+            seen[row] = 1;
+            scored.push_back(row);
+            uint64_t mask = 0;
+            for (uint32_t i = rowWordStart[row]; i < rowWordStart[row + 1]; i++) mask |= wordMasks[rowWords[i]];
+            size_t common = bitset<64>(mask).count();
+            if (common < minOverlap) continue;
+            NameMatch match = { row, 2.0 * common / (queryGrams + gramCounts[row]) };
+            if (found.size() < maxResults) {
+                found.push_back(match);
+                push_heap(found.begin(), found.end(), better);
+            } else if (better(match, found.front())) {
+                pop_heap(found.begin(), found.end(), better);
+                found.back() = match;
+                push_heap(found.begin(), found.end(), better);
+            }
+        }
+    }
+    for (uint32_t row : scored) seen[row] = 0;          // Resets scratch for the next search
+    for (uint32_t word : touched) wordMasks[word] = 0;
+    sort(found.begin(), found.end(), better);
+    matches.insert(matches.end(), found.begin(), found.end());
+}
+
+// Number of distinct trigrams
+size_t NameIndex::trigramCount() const { return wordPostings.size(); }
+
+// Number of distinct words
+size_t NameIndex::wordCount() const { return wordRows.size(); }
+
+// Heap bytes used by the index
+size_t NameIndex::memoryUsage() const {
+    size_t bytes = wordIds.bucket_count() * sizeof(void*) + wordPostings.bucket_count() * sizeof(void*) +
+                   vectorBufferBytes(wordRows) + vectorBufferBytes(rowWordStart) + vectorBufferBytes(rowWords) +
+                   vectorBufferBytes(gramCounts) + vectorBufferBytes(wordMasks) + vectorBufferBytes(seen);
+    for (const auto& entry : wordIds) {
+        bytes += sizeof(entry) + sizeof(void*) + stringHeapBytes(entry.first);
+    }
+    for (const auto& entry : wordPostings) {
+        bytes += sizeof(entry) + sizeof(void*) + vectorBufferBytes(entry.second);
+    }
+    for (const auto& rows : wordRows) bytes += vectorBufferBytes(rows);
+    return bytes;
+}
+
+// ========== BENCHMARK ========== //
+
+// Generated name for the benchmark: one of 20 first names and a three-syllable
+// surname (about 3.9M distinct names); seed advances one step per name
+static void generatedName(uint32_t& seed, string& name) {
+    static const char* firstNames[] = { "John", "Sarah", "Ahmed", "Maria", "Wei", "Fatima", "James",
+                                        "Olga", "Carlos", "Aisha", "Peter", "Yuki", "David", "Leila",
+                                        "Omar", "Grace", "Ivan", "Nadia", "Lucas", "Emma" };
+    static const char* syllables[] = { "sm", "ith", "son", "ber", "ka", "mal", "ov", "ez", "lin",
+                                       "ham", "ton", "ri", "ck", "stein", "ba", "ra", "der", "wo",
+                                       "li", "an", "ko", "vic", "ler", "ma", "gu", "tz", "pe", "qui",
+                                       "no", "dre", "fe", "yam", "has", "sch", "mi", "dt", "ul", "ve",
+                                       "zo", "jan", "pol", "ski", "ne", "go", "ro", "wa", "ta", "hi",
+                                       "ox", "el", "ur", "bo", "ky", "nd", "ge", "ls", "us", "ph" };
+    const size_t syllableCount = sizeof(syllables) / sizeof(syllables[0]);
+    seed = seed * 1664525u + 1013904223u;  // Linear congruential generator
+    name = firstNames[(seed >> 8) % 20];
+    name += ' ';
+    uint32_t mix = seed * 2654435761u;  // Spreads seed bits for syllable choice
+    for (int s = 0; s < 3; s++) name += syllables[(mix >> (s * 8)) % syllableCount];
+}
+
+// Builds an index of generated names, times typo-tolerant searches and checks
+// each result list against a brute-force ranking of every generated name
+void runNameSearchBenchmark(size_t rows) {
+    const uint32_t firstSeed = 4242;
+    cout << "\nIndexing " << rows << " generated names...\n";
+    NameIndex index;
+    uint32_t seed = firstSeed;
+    string name;
+    auto buildStart = chrono::steady_clock::now();
+    for (size_t i = 0; i < rows; i++) {
+        generatedName(seed, name);
+        index.add(static_cast<uint32_t>(i), name);
+    }
+    double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - buildStart).count();
+    cout << "Built in " << buildSeconds << " s, " << index.wordCount() << " words, " << index.trigramCount()
+         << " trigrams, " << index.memoryUsage() / (1024 * 1024) << " MB\n";
+
+    const char* queries[] = { "Jon Smyth", "Sara Bersonka", "Ahmad Malovez", "Mariya Linhamton" };
+    const size_t queryCount = sizeof(queries) / sizeof(queries[0]);
+    const size_t topK = 10;
+    auto better = [](const NameMatch& a, const NameMatch& b) {
+        return a.score != b.score ? a.score > b.score : a.row < b.row;
+    };
+    vector<vector<NameMatch>> results(queryCount);
+    for (size_t q = 0; q < queryCount; q++) {
+        auto start = chrono::steady_clock::now();
+        index.search(queries[q], topK, results[q]);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "- \"" << queries[q] << "\": " << results[q].size() << " top matches in " << ms << " ms";
+        if (!results[q].empty()) cout << " (best score " << results[q][0].score << ")";
+        cout << "\n";
+    }
+
+    // Brute force: score every generated name against every query and keep the top k
+    cout << "Checking against a brute-force ranking of all " << rows << " names...\n";
+    vector<vector<uint32_t>> queryGrams(queryCount);
+    vector<vector<NameMatch>> expected(queryCount);  // Heaps of the best results, worst on top
+    for (size_t q = 0; q < queryCount; q++) NameIndex::trigrams(queries[q], queryGrams[q]);
+    vector<uint32_t> grams, common;
+    seed = firstSeed;
+    for (size_t i = 0; i < rows; i++) {
+        generatedName(seed, name);
+        NameIndex::trigrams(name, grams);
+        for (size_t q = 0; q < queryCount; q++) {
+            common.clear();
+            set_intersection(grams.begin(), grams.end(), queryGrams[q].begin(), queryGrams[q].end(),
+                             back_inserter(common));
+            if (common.size() < max<size_t>(1, (queryGrams[q].size() + 2) / 3)) continue;
+            NameMatch match = { static_cast<uint32_t>(i),
+                                2.0 * common.size() / (queryGrams[q].size() + min<size_t>(grams.size(), 255)) };
+            vector<NameMatch>& heap = expected[q];
+            if (heap.size() < topK) {
+                heap.push_back(match);
+                push_heap(heap.begin(), heap.end(), better);
+            } else if (better(match, heap.front())) {
+                pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = match;
+                push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+    }
+    size_t agreeing = 0;
+    for (size_t q = 0; q < queryCount; q++) {
+        sort(expected[q].begin(), expected[q].end(), better);
+        bool same = expected[q].size() == results[q].size();
+        for (size_t i = 0; same && i < expected[q].size(); i++) {
+            same = expected[q][i].row == results[q][i].row && expected[q][i].score == results[q][i].score;
+        }
+        if (same) agreeing++;
+        else cout << "- \"" << queries[q] << "\": index and brute force disagree\n";
+    }
+    cout << agreeing << " of " << queryCount << " result lists match the brute-force ranking.\n";
+}
@@ -0,0 +1,61 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>         // For names and queries
+#include <vector>         // For posting lists
+#include <unordered_map>  // For trigram dictionary
+#include <cstdint>        // For fixed-width types
+using namespace std;
+
+// One fuzzy name match
+struct NameMatch {
+    uint32_t row;  // Registration position of the person
+    double score;  // Dice similarity of trigram sets (0..1)
+};
+
+// Trigram index over person names for typo-tolerant lookup.
+// Each word is padded ("  jon ") and split into 3-character grams; a name
+// matches a query by the share of grams they have in common. First names and
+// surnames repeat across millions of people, so the trigrams index distinct
+// words and each word lists the rows using it. Rows are added in increasing
+// order, so row lists stay sorted without re-sorting.
+class NameIndex {
+private:
+    unordered_map<string, uint32_t> wordIds;                 // Word -> word number
+    unordered_map<uint32_t, vector<uint32_t>> wordPostings;  // Trigram -> sorted word numbers
+    vector<vector<uint32_t>> wordRows;                        // Word number -> sorted rows using it
+    vector<uint32_t> rowWordStart;   // Row -> first entry in rowWords (one extra entry at the end)
+    vector<uint32_t> rowWords;       // Word numbers of every row, row after row
+    vector<uint8_t> gramCounts;      // Row -> distinct trigrams in name
+    size_t maxWords = 0;             // Most words in one name
+    size_t minGrams = 255;           // Fewest trigrams in one name
+    mutable vector<uint64_t> wordMasks;  // Scratch: word -> query grams it holds (one search at a time)
+    mutable vector<uint8_t> seen;        // Scratch: row already scored
+
+    // Lowercase alphanumeric words of a name
+    static void splitWords(const string& name, vector<string>& words);
+
+public:
+    // Distinct packed trigrams of a name, sorted
+    static void trigrams(const string& name, vector<uint32_t>& grams);
+
+    // Indexes the name of the person at row (rows must be added in increasing order)
+    void add(uint32_t row, const string& name);
+
+    // Ranks rows by similarity to query; keeps matches sharing at least a third of the
+    // query's trigrams and returns up to maxResults, best first (ties: lower row).
+    // Only the first 64 distinct trigrams of a query are used.
+    void search(const string& query, size_t maxResults, vector<NameMatch>& matches) const;
+
+    // Number of distinct trigrams
+    size_t trigramCount() const;
+
+    // Number of distinct words
+    size_t wordCount() const;
+
+    // Heap bytes used by the index
+    size_t memoryUsage() const;
+};
+
+// Times fuzzy searches over generated names
+void runNameSearchBenchmark(size_t rows);
@@ -1,20 +1,24 @@
 #include "hospital.h"  // Includes the main hospital system header
+#include "varint.h"    // For serialized collections
+#include <cctype>      // For field rules
+#include <cstring>     // For strchr
 
 // ========== PERSON CLASS IMPLEMENTATION ========== //
 
 // Constructor implementation for base Person class
 Person::Person(int id, string name, int age, string gender, string address, string contactNumber)
-    : id(id),            // Unique identifier
-      name(name),        // Full name
-      age(age),          // Age in years
-      gender(gender),    // Gender identity
-      address(address),  // Physical address
-      contactNumber(contactNumber) {}  // Contact information
+    : id(id),                              // Unique identifier
+      age(age),                            // Age in years
+      name(move(name)),                    // Full name
+      gender(gender),                      // Gender identity (interned)
+      address(move(address)),              // Physical address
+      contactNumber(contactNumber) {}      // Contact information (checked where entered)
 
 // Updates contact information for any person
-void Person::updateContactInfo(string newAddress, string newContact) {
-    address = newAddress;          // Updates address
-    contactNumber = newContact;    // Updates phone number
+void Person::updateContactInfo(string newAddress, string_view newContact) {
+    address = move(newAddress);        // Updates address
+    contactNumber = newContact;        // Updates phone number
+    changed = true;
     cout << "\nContact information updated successfully!\n";  // Confirmation
 }
 
@@ -22,64 +26,217 @@ void Person::updateContactInfo(string newAddress, string newContact) {
 int Person::getId() const { return id; }
 
 // Getter for person name
-string Person::getName() const { return name; }
+const string& Person::getName() const { return name; }
+
+// Getter for age
+int Person::getAge() const { return age; }
+
+// Getter for gender
+const string& Person::getGender() const { return gender.str(); }
+
+// Getter for address
+const string& Person::getAddress() const { return address; }
+
+// Getter for contact number
+string_view Person::getContactNumber() const { return contactNumber.view(); }
+
+// Gender as typed at registration ("Female", "Non-binary")
+bool Person::isValidGender(string_view gender) {
+    if (gender.empty() || gender.size() > 15) return false;
+    for (char c : gender) {
+        if (!isalpha(static_cast<unsigned char>(c)) && c != ' ' && c != '-') return false;
+    }
+    return true;
+}
+
+// Phone number with common separators and an optional extension ("+92-300-1234567 x12")
+bool Person::isValidContactNumber(string_view number) {
+    if (!ContactNumberText::fits(number)) return false;
+    size_t digits = 0;
+    for (char c : number) {
+        if (isdigit(static_cast<unsigned char>(c))) digits++;
+        else if (c == '\0' || !strchr(" +-().x", c)) return false;
+    }
+    return digits >= 3;
+}
+
+// Heap bytes owned by the Person string fields (gender is shared)
+size_t Person::personHeapBytes() const {
+    return stringHeapBytes(name) + stringHeapBytes(address);  // Contact number is inline
+}
+
+// True if modified since the last checkpoint
+bool Person::isChanged() const { return changed; }
+
+// The last checkpoint now holds this person's state
+void Person::markSaved() { changed = false; }
+
+// Serializes the Person fields
+void Person::writePersonFields(vector<uint8_t>& out) const {
+    writeSigned(out, id);
+    writeString(out, name);
+    writeSigned(out, age);
+    writeString(out, gender.str());
+    writeString(out, address);
+    writeString(out, contactNumber.view());
+}
+
+// Person and Staff fields as written by writePersonFields and writeStaffFields
+struct SavedPerson {
+    int id, age;
+    string name, gender, address, contactNumber;
+    double salary = 0;
+    string department, joinDate;
+};
+
+static SavedPerson readPersonFields(const vector<uint8_t>& in, size_t& pos, bool staff) {
+    SavedPerson saved;
+    saved.id = static_cast<int>(readSigned(in, pos));
+    saved.name = readString(in, pos);
+    saved.age = static_cast<int>(readSigned(in, pos));
+    saved.gender = readString(in, pos);
+    saved.address = readString(in, pos);
+    saved.contactNumber = readString(in, pos);
+    if (staff) {
+        saved.salary = readDouble(in, pos);
+        saved.department = readString(in, pos);
+        saved.joinDate = readString(in, pos);
+    }
+    return saved;
+}
 
 // ========== STAFF CLASS IMPLEMENTATION ========== //
 
 // Constructor for Staff (inherits from Person)
 Staff::Staff(int id, string name, int age, string gender, string address, string contactNumber,
       double salary, string department, string joinDate)
-    : Person(id, name, age, gender, address, contactNumber),  // Initializes base Person
-      staffId(id),          // Staff-specific ID
-      salary(salary),       // Annual salary
-      department(department),  // Department assignment
-      joinDate(joinDate) {} // Employment start date
+    : Person(id, move(name), age, move(gender), move(address), move(contactNumber)),  // Initializes base Person
+      staffId(id),                 // Staff-specific ID
+      salary(salary),              // Annual salary
+      department(department),        // Department assignment (interned)
+      joinDate(move(joinDate)) {}  // Employment start date
 
 // Displays complete staff information
 void Staff::displayDetails() const {
     cout << "\n=== STAFF DETAILS ===\n";  // Header
     cout << "ID: " << staffId << "\n";
     cout << "Name: " << name << "\n";
-    cout << "Department: " << department << "\n";
+    cout << "Department: " << department.str() << "\n";
     cout << "Join Date: " << joinDate << "\n";
     cout << "Salary: $" << salary << "\n";  // Formatted currency
 }
 
+// Getter for salary
+double Staff::getSalary() const { return salary; }
+
+// Getter for department
+const string& Staff::getDepartment() const { return department.str(); }
+
+// Getter for join date
+const string& Staff::getJoinDate() const { return joinDate; }
+
+// Moves staff member to another department
+void Staff::setDepartment(const string& newDepartment) {
+    department = newDepartment;
+    changed = true;
+}
+
+// Records staff memory footprint
+void Staff::reportMemory(MemoryReport& report) const {
+    report.record(Subsystem::Persons, "Staff", sizeof(Staff) + staffHeapBytes());
+}
+
+// Heap bytes owned by the Person and Staff string fields (department is shared)
+size_t Staff::staffHeapBytes() const {
+    return personHeapBytes() + stringHeapBytes(joinDate);
+}
+
+// Serializes the Person and Staff fields
+void Staff::writeStaffFields(vector<uint8_t>& out) const {
+    writePersonFields(out);
+    writeDouble(out, salary);
+    writeString(out, department.str());
+    writeString(out, joinDate);
+}
+
 // ========== PATIENT CLASS IMPLEMENTATION ========== //
 
 // Constructor for Patient (inherits from Person)
 Patient::Patient(int id, string name, int age, string gender, string address, string contactNumber,
         string bloodGroup, int assignedDoctorId)
-    : Person(id, name, age, gender, address, contactNumber),  // Initializes base Person
-      patientId(id),          // Patient-specific ID
-      bloodGroup(bloodGroup), // Blood type
+    : Person(id, move(name), age, move(gender), move(address), move(contactNumber)),  // Initializes base Person
+      bloodGroup(bloodGroup),       // Blood type (interned)
       assignedDoctorId(assignedDoctorId),  // Primary physician
       roomId(-1) {}           // -1 indicates no room assigned
 
 // Displays complete patient information
 void Patient::displayDetails() const {
     cout << "\n=== PATIENT DETAILS ===\n";  // Header
-    cout << "ID: " << patientId << "\n";
+    cout << "ID: " << id << "\n";
     cout << "Name: " << name << "\n";
     cout << "Age: " << age << "\n";
-    cout << "Gender: " << gender << "\n";
-    cout << "Blood Group: " << bloodGroup << "\n";
+    cout << "Gender: " << gender.str() << "\n";
+    cout << "Blood Group: " << bloodGroup.str() << "\n";
     cout << "Assigned Doctor ID: " << assignedDoctorId << "\n";
     if (roomId != -1) {  // Only shows room if assigned
         cout << "Room ID: " << roomId << "\n";
     }
     cout << "Address: " << address << "\n";
-    cout << "Contact: " << contactNumber << "\n";
+    cout << "Contact: " << contactNumber.view() << "\n";
+    const SegmentHeader& summary = getSegmentHeader();  // Counts only; nothing is loaded
+    cout << "On File: " << summary.appointmentCount << " appointment(s), " << summary.prescriptionCount
+         << " prescription(s), " << summary.recordCount << " medical record(s)\n";
+}
+
+// Records patient memory footprint, including owned collections
+void Patient::reportMemory(MemoryReport& report) const {
+    // Condition names live in the intern table; only the references are the patient's
+    size_t bytes = sizeof(Patient) + personHeapBytes() + diseases.capacity() * sizeof(InternedString);
+    report.record(Subsystem::Persons, "Patient", bytes);
+    if (!header.loaded) return;  // Collections are on disk, not in memory
+
+    // Each owned entity is attributed to its own subsystem
+    for (const auto& appt : appointments) {
+        report.record(Subsystem::Appointments, "Appointment", appt.memoryUsage());
+    }
+    for (const auto& presc : prescriptions) {
+        report.record(Subsystem::Prescriptions, "Prescription", presc.memoryUsage());
+    }
+    for (const auto& record : medicalRecords) {
+        report.record(Subsystem::Records, "MedicalRecord", record.memoryUsage());
+    }
+
+    // Unused vector capacity still occupies heap memory
+    report.addOverhead(Subsystem::Appointments,
+                       (appointments.capacity() - appointments.size()) * sizeof(Appointment));
+    report.addOverhead(Subsystem::Prescriptions,
+                       (prescriptions.capacity() - prescriptions.size()) * sizeof(Prescription));
+    report.addOverhead(Subsystem::Records,
+                       (medicalRecords.capacity() - medicalRecords.size()) * sizeof(MedicalRecord));
 }
 
 // Adds medical condition to patient's record
 void Patient::addDisease(const string& disease) {
-    diseases.push_back(disease);  // Stores condition
+    diseases.emplace_back(disease);  // Stores the shared condition name
+    changed = true;
     cout << "\nAdded medical condition: " << disease << "\n";  // Confirmation
 }
 
+// Removes the most recent entry of a condition
+void Patient::removeDisease(const string& disease) {
+    for (auto it = diseases.rbegin(); it != diseases.rend(); ++it) {
+        if (it->str() == disease) {
+            diseases.erase(next(it).base());
+            changed = true;
+            cout << "\nRemoved medical condition: " << disease << "\n";  // Confirmation
+            return;
+        }
+    }
+}
+
 // Displays all patient appointments
 void Patient::displayAppointments() const {
+    ensureLoaded(false);
     if (appointments.empty()) {  // Handles empty case
         cout << "\nNo appointments scheduled.\n";
         return;
@@ -94,6 +251,7 @@ void Patient::displayAppointments() const {
 
 // Displays all patient prescriptions
 void Patient::displayPrescriptions() const {
+    ensureLoaded(false);
     if (prescriptions.empty()) {  // Handles empty case
         cout << "\nNo prescriptions available.\n";
         return;
@@ -108,6 +266,7 @@ void Patient::displayPrescriptions() const {
 
 // Displays all medical records
 void Patient::displayMedicalRecords() const {
+    ensureLoaded(false);
     if (medicalRecords.empty()) {  // Handles empty case
         cout << "\nNo medical records available.\n";
         return;
@@ -120,38 +279,80 @@ void Patient::displayMedicalRecords() const {
     }
 }
 
-// Schedules new appointment
-void Patient::scheduleAppointment(int doctorId, const string& dateTime) {
-    appointments.emplace_back(patientId, doctorId, dateTime);  // Creates new appointment
+// Schedules new appointment and returns its ID
+int Patient::scheduleAppointment(int doctorId, const string& dateTime) {
+    if (!isValidDateTime(dateTime)) {
+        cout << "\nInvalid date/time! Use DD/MM/YYYY HH:MM.\n";  // Would be stored as not recorded
+        return 0;
+    }
+    ensureLoaded(true);
+    appointments.emplace_back(id, doctorId, dateTime);  // Creates new appointment
     cout << "\nAppointment scheduled successfully!\n";  // Confirmation
+    return appointments.back().getId();
 }
 
 // Creates new prescription
-void Patient::addPrescription(int doctorId) {
-    prescriptions.emplace_back(patientId, doctorId);  // Creates new prescription
+void Patient::addPrescription(int doctorId, const string& date) {
+    ensureLoaded(true);
+    prescriptions.emplace_back(id, doctorId, date);  // Creates new prescription
     cout << "\nNew prescription created!\n";  // Confirmation
 }
 
-// Creates new medical record
-void Patient::addMedicalRecord(int doctorId, const string& diagnosis, const string& plan) {
-    medicalRecords.emplace_back(patientId, doctorId, diagnosis, plan);  // Creates record
-    cout << "\nMedical record created!\n";  // Confirmation
+// Creates new medical record and returns its ID
+int Patient::addMedicalRecord(int doctorId, const string& diagnosis, const string& plan) {
+    ensureLoaded(true);
+    medicalRecords.emplace_back(id, doctorId, diagnosis, plan);  // Creates record
+    cout << "\nMedical record #" << medicalRecords.back().getId() << " created!\n";  // Confirmation
+    return medicalRecords.back().getId();
 }
 
 // Assigns patient to room
 void Patient::assignRoom(int rId) {
     roomId = rId;  // Sets room ID
+    changed = true;
     cout << "\nAssigned to Room #" << rId << "\n";  // Confirmation
 }
 
 // Removes patient from room
 void Patient::dischargeFromRoom() {
     roomId = -1;  // Resets room assignment
+    changed = true;
     cout << "\nDischarged from room\n";  // Confirmation
 }
 
-// Finds appointment by ID
+// Removes an appointment by ID
+bool Patient::removeAppointment(int id) {
+    ensureLoaded(false);
+    for (auto it = appointments.begin(); it != appointments.end(); ++it) {
+        if (it->getId() == id) {
+            it->releaseColdText();
+            appointments.erase(it);
+            markCollectionsChanged();
+            cout << "\nAppointment #" << id << " removed.\n";  // Confirmation
+            return true;
+        }
+    }
+    return false;
+}
+
+// Removes a medical record by ID
+bool Patient::removeMedicalRecord(int id) {
+    ensureLoaded(false);
+    for (auto it = medicalRecords.begin(); it != medicalRecords.end(); ++it) {
+        if (it->getId() == id) {
+            it->releaseColdText();
+            medicalRecords.erase(it);
+            markCollectionsChanged();
+            cout << "\nMedical record #" << id << " removed.\n";  // Confirmation
+            return true;
+        }
+    }
+    return false;
+}
+
+// Finds appointment by ID (for changes)
 void Patient::getAppointment(int id, Appointment*& appt) {
+    ensureLoaded(false);  // Dirty only once the caller reports a change
     for (auto& a : appointments) {  // Searches appointments
         if (a.getId() == id) {
             appt = &a;  // Returns found appointment
@@ -161,8 +362,9 @@ void Patient::getAppointment(int id, Appointment*& appt) {
     appt = nullptr;  // Returns null if not found
 }
 
-// Finds prescription by ID
+// Finds prescription by ID (for changes)
 void Patient::getPrescription(int id, Prescription*& presc) {
+    ensureLoaded(false);
     for (auto& p : prescriptions) {  // Searches prescriptions
         if (p.getId() == id) {
             presc = &p;  // Returns found prescription
@@ -172,8 +374,9 @@ void Patient::getPrescription(int id, Prescription*& presc) {
     presc = nullptr;  // Returns null if not found
 }
 
-// Finds medical record by ID
+// Finds medical record by ID (for changes)
 void Patient::getMedicalRecord(int id, MedicalRecord*& record) {
+    ensureLoaded(false);
     for (auto& r : medicalRecords) {  // Searches records
         if (r.getId() == id) {
             record = &r;  // Returns found record
@@ -183,24 +386,211 @@ void Patient::getMedicalRecord(int id, MedicalRecord*& record) {
     record = nullptr;  // Returns null if not found
 }
 
+// Records a change made through a get* result
+void Patient::markCollectionsChanged() {
+    collectionsChanged = true;  // Next checkpoint rewrites them
+    header.dirty = true;        // Segment file is out of date
+}
+
+// Finds appointment by ID (read only)
+void Patient::findAppointment(int id, const Appointment*& appt) const {
+    ensureLoaded(false);
+    for (const auto& a : appointments) {
+        if (a.getId() == id) {
+            appt = &a;
+            return;
+        }
+    }
+    appt = nullptr;  // Returns null if not found
+}
+
+// Finds prescription by ID (read only)
+void Patient::findPrescription(int id, const Prescription*& presc) const {
+    ensureLoaded(false);
+    for (const auto& p : prescriptions) {
+        if (p.getId() == id) {
+            presc = &p;
+            return;
+        }
+    }
+    presc = nullptr;  // Returns null if not found
+}
+
+// Finds medical record by ID (read only)
+void Patient::findMedicalRecord(int id, const MedicalRecord*& record) const {
+    ensureLoaded(false);
+    for (const auto& r : medicalRecords) {
+        if (r.getId() == id) {
+            record = &r;
+            return;
+        }
+    }
+    record = nullptr;  // Returns null if not found
+}
+
+// Compresses record and appointment text unused since idleSince
+size_t Patient::freezeColdText(ColdTextStore& store, time_t idleSince) {
+    if (!header.loaded) return 0;  // Unloaded text is already out of memory
+    size_t frozen = 0;
+    for (auto& record : medicalRecords) frozen += record.freezeText(store, idleSince);
+    for (auto& appt : appointments) frozen += appt.freezeText(store, idleSince);
+    return frozen;
+}
+
 // Getter for room ID
 int Patient::getRoomId() const { return roomId; }
 
+// Getter for blood group
+const string& Patient::getBloodGroup() const { return bloodGroup.str(); }
+
+// Any spelling bloodGroupCode recognises ("AB-", "o +")
+bool Patient::isValidBloodGroup(string_view bloodGroup) { return bloodGroupCode(string(bloodGroup)) >= 0; }
+
+// Getter for assigned doctor ID
+int Patient::getAssignedDoctorId() const { return assignedDoctorId; }
+
+// Getter for known conditions
+const vector<InternedString>& Patient::getDiseases() const { return diseases; }
+
+// Appends the condition names (for the text index and the change log)
+void Patient::collectDiseases(vector<string>& names) const {
+    for (const auto& disease : diseases) names.push_back(disease.str());
+}
+
+// Getter for appointments (loaded first if spilled)
+const vector<Appointment>& Patient::getAppointments() const {
+    ensureLoaded(false);
+    return appointments;
+}
+
+// Getter for medical records (loaded first if spilled)
+const vector<MedicalRecord>& Patient::getMedicalRecords() const {
+    ensureLoaded(false);
+    return medicalRecords;
+}
+
+// Corrects recorded blood group
+void Patient::setBloodGroup(const string& newBloodGroup) {
+    bloodGroup = newBloodGroup;
+    changed = true;
+}
+
+// Loads the collections on first access and marks the patient as recently used
+void Patient::ensureLoaded(bool modifying) const {
+    if (modifying) collectionsChanged = true;  // Next checkpoint rewrites them
+    if (!tier) return;
+    tier->touch(this);
+    if (modifying) header.dirty = true;  // Caller is about to change the collections
+}
+
+// Sets (or clears) the tiered storage managing the collections and the patient's segment number
+void Patient::setTier(PatientTier* newTier, uint32_t segment) {
+    tier = newTier;
+    header.segment = segment;
+    header.dirty = true;  // A new segment has not been written yet
+}
+
+// Fixed-size summary of the collections
+const SegmentHeader& Patient::getSegmentHeader() const {
+    if (header.loaded) {  // Counts are refreshed from memory while loaded
+        header.appointmentCount = static_cast<uint32_t>(appointments.size());
+        header.prescriptionCount = static_cast<uint32_t>(prescriptions.size());
+        header.recordCount = static_cast<uint32_t>(medicalRecords.size());
+    }
+    return header;
+}
+
+// Serializes appointments, prescriptions and records as counted lists
+void Patient::writeCollections(vector<uint8_t>& out) const {
+    writeVarint(out, appointments.size());
+    for (const auto& appt : appointments) appt.writeTo(out);
+    writeVarint(out, prescriptions.size());
+    for (const auto& presc : prescriptions) presc.writeTo(out);
+    writeVarint(out, medicalRecords.size());
+    for (const auto& record : medicalRecords) record.writeTo(out);
+}
+
+// Segment file now matches the collections in memory
+void Patient::markSegmentWritten() const { header.dirty = false; }
+
+// Releases the collections, keeping only their counts
+void Patient::unloadCollections() const {
+    getSegmentHeader();  // Captures the counts
+    for (const auto& appt : appointments) appt.releaseColdText();  // Segment file holds the text now
+    for (const auto& record : medicalRecords) record.releaseColdText();
+    vector<Appointment>().swap(appointments);
+    vector<Prescription>().swap(prescriptions);
+    vector<MedicalRecord>().swap(medicalRecords);
+    header.loaded = false;
+}
+
+// Reads the collections back from a buffer written by writeCollections
+void Patient::loadCollections(const vector<uint8_t>& in) const {
+    size_t pos = 0;
+    size_t count = readVarint(in, pos);
+    appointments.reserve(count);
+    for (size_t i = 0; i < count; i++) appointments.push_back(Appointment::readFrom(in, pos));
+    count = readVarint(in, pos);
+    prescriptions.reserve(count);
+    for (size_t i = 0; i < count; i++) prescriptions.push_back(Prescription::readFrom(in, pos));
+    count = readVarint(in, pos);
+    medicalRecords.reserve(count);
+    for (size_t i = 0; i < count; i++) medicalRecords.push_back(MedicalRecord::readFrom(in, pos));
+    header.loaded = true;
+    header.dirty = false;  // Memory matches the segment it came from
+}
+
+// Serializes profile, conditions and room assignment
+void Patient::writeTo(vector<uint8_t>& out) const {
+    writePersonFields(out);
+    writeString(out, bloodGroup.str());
+    writeSigned(out, assignedDoctorId);
+    writeSigned(out, roomId);
+    writeVarint(out, diseases.size());
+    for (const auto& disease : diseases) writeString(out, disease.str());
+}
+
+// Reads a patient written by writeTo (collections are restored separately)
+Patient Patient::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    SavedPerson saved = readPersonFields(in, pos, false);
+    string bloodGroup = readString(in, pos);
+    int doctorId = static_cast<int>(readSigned(in, pos));
+    Patient patient(saved.id, saved.name, saved.age, saved.gender, saved.address, saved.contactNumber,
+                    bloodGroup, doctorId);
+    patient.roomId = static_cast<int>(readSigned(in, pos));
+    patient.diseases.resize(readVarint(in, pos));
+    for (auto& disease : patient.diseases) disease = readString(in, pos);
+    return patient;
+}
+
+// True if the collections were modified since the last checkpoint
+bool Patient::areCollectionsChanged() const { return collectionsChanged; }
+
+// Serializes the collections, loading them first if they were spilled
+void Patient::saveCollections(vector<uint8_t>& out) const {
+    ensureLoaded(false);
+    writeCollections(out);
+}
+
+// The last checkpoint now holds the collections
+void Patient::markCollectionsSaved() { collectionsChanged = false; }
+
 // ========== DOCTOR CLASS IMPLEMENTATION ========== //
 
 // Constructor for Doctor (inherits from Staff)
 Doctor::Doctor(int id, string name, int age, string gender, string address, string contactNumber,
        double salary, string department, string joinDate, string specialization, string licenseNumber)
-    : Staff(id, name, age, gender, address, contactNumber, salary, department, joinDate),  // Base Staff
-      doctorId(id),                // Doctor-specific ID
-      specialization(specialization),  // Medical specialty
-      licenseNumber(licenseNumber) {}  // Professional license
+    : Staff(id, move(name), age, move(gender), move(address), move(contactNumber), salary, move(department),
+            move(joinDate)),                 // Base Staff
+      doctorId(id),                          // Doctor-specific ID
+      specialization(move(specialization)),  // Medical specialty
+      licenseNumber(licenseNumber) {}        // Professional license (checked where entered)
 
 // Displays complete doctor information
 void Doctor::displayDetails() const {
     Staff::displayDetails();  // Shows base Staff info
     cout << "Specialization: " << specialization << "\n";
-    cout << "License Number: " << licenseNumber << "\n";
+    cout << "License Number: " << licenseNumber.view() << "\n";
     
     if (!availableSlots.empty()) {  // Shows available slots if any
         cout << "\nAvailable Slots:\n";
@@ -210,6 +600,19 @@ void Doctor::displayDetails() const {
     }
 }
 
+// Records doctor memory footprint, including appointments
+void Doctor::reportMemory(MemoryReport& report) const {
+    size_t bytes = sizeof(Doctor) + staffHeapBytes() + stringHeapBytes(specialization) +
+                   stringVectorHeapBytes(availableSlots);
+    report.record(Subsystem::Persons, "Doctor", bytes);
+
+    for (const auto& appt : appointments) {
+        report.record(Subsystem::Appointments, "Appointment", appt.memoryUsage());
+    }
+    report.addOverhead(Subsystem::Appointments,
+                       (appointments.capacity() - appointments.size()) * sizeof(Appointment));
+}
+
 // Creates medication prescription
 void Doctor::prescribeMedication(int patientId, const string &medication, const string& dosage) {
     cout << "\nPrescription created:\n";
@@ -221,9 +624,22 @@ void Doctor::prescribeMedication(int patientId, const string &medication, const
 // Adds available appointment slot
 void Doctor::addAvailableSlot(const string& slot) {
     availableSlots.push_back(slot);  // Stores time slot
+    changed = true;
     cout << "\nAdded available slot: " << slot << "\n";  // Confirmation
 }
 
+// Removes the most recent entry of a slot
+void Doctor::removeAvailableSlot(const string& slot) {
+    for (auto it = availableSlots.rbegin(); it != availableSlots.rend(); ++it) {
+        if (*it == slot) {
+            availableSlots.erase(next(it).base());
+            changed = true;
+            cout << "\nRemoved available slot: " << slot << "\n";  // Confirmation
+            return;
+        }
+    }
+}
+
 // Displays all doctor appointments
 void Doctor::viewAppointments() const {
     if (appointments.empty()) {  // Handles empty case
@@ -240,19 +656,33 @@ void Doctor::viewAppointments() const {
 }
 
 // Completes appointment with notes
-void Doctor::completeAppointment(int apptId, const string& notes) {
+bool Doctor::completeAppointment(int apptId, const string& notes) {
     for (auto& appt : appointments) {  // Finds appointment
-        if (appt.getId() == apptId && appt.getStatus() == "Pending") {
+        if (appt.getId() == apptId && appt.getStatus() == AppointmentStatus::Pending) {
             appt.completeAppointment(notes);  // Marks complete
-            return;
+            changed = true;
+            return true;
         }
     }
     cout << "\nAppointment not found or not pending!\n";  // Error message
+    return false;
+}
+
+// Returns a completed appointment to pending (undo of completing it)
+bool Doctor::reopenAppointment(int apptId) {
+    for (auto& appt : appointments) {
+        if (appt.getId() == apptId && appt.reopenAppointment()) {
+            changed = true;
+            return true;
+        }
+    }
+    return false;
 }
 
 // Adds new appointment
 void Doctor::addAppointment(int patientId, const string& dateTime) {
     appointments.emplace_back(patientId, doctorId, dateTime);  // Creates appointment
+    changed = true;
 }
 
 // Finds appointment by ID
@@ -266,23 +696,81 @@ void Doctor::getAppointment(int id, Appointment*& appt) {
     appt = nullptr;  // Returns null if not found
 }
 
+// Getter for specialization
+const string& Doctor::getSpecialization() const { return specialization; }
+
+// Getter for license number
+string_view Doctor::getLicenseNumber() const { return licenseNumber.view(); }
+
+// License as issued ("PMDC-1000001", "MD/2015/77")
+bool Doctor::isValidLicenseNumber(string_view license) {
+    if (license.empty() || !LicenseNumberText::fits(license)) return false;
+    for (char c : license) {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '/') return false;
+    }
+    return true;
+}
+
+// Getter for appointments
+const vector<Appointment>& Doctor::getAppointments() const { return appointments; }
+
+// Compresses appointment notes unused since idleSince
+size_t Doctor::freezeColdText(ColdTextStore& store, time_t idleSince) {
+    size_t frozen = 0;
+    for (auto& appt : appointments) frozen += appt.freezeText(store, idleSince);
+    return frozen;
+}
+
+// Serializes profile, staff details, slots and appointments
+void Doctor::writeTo(vector<uint8_t>& out) const {
+    writeStaffFields(out);
+    writeString(out, specialization);
+    writeString(out, licenseNumber.view());
+    writeVarint(out, availableSlots.size());
+    for (const auto& slot : availableSlots) writeString(out, slot);
+    writeVarint(out, appointments.size());
+    for (const auto& appt : appointments) appt.writeTo(out);
+}
+
+// Reads a doctor written by writeTo
+Doctor Doctor::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    SavedPerson saved = readPersonFields(in, pos, true);
+    string specialization = readString(in, pos);
+    string licenseNumber = readString(in, pos);
+    Doctor doctor(saved.id, saved.name, saved.age, saved.gender, saved.address, saved.contactNumber,
+                  saved.salary, saved.department, saved.joinDate, specialization, licenseNumber);
+    doctor.availableSlots.resize(readVarint(in, pos));
+    for (auto& slot : doctor.availableSlots) slot = readString(in, pos);
+    size_t count = static_cast<size_t>(readVarint(in, pos));
+    doctor.appointments.reserve(count);
+    for (size_t i = 0; i < count; i++) doctor.appointments.push_back(Appointment::readFrom(in, pos));
+    return doctor;
+}
+
 // ========== NURSE CLASS IMPLEMENTATION ========== //
 
 // Constructor for Nurse (inherits from Staff)
 Nurse::Nurse(int id, string name, int age, string gender, string address, string contactNumber,
       double salary, string department, string joinDate, string shiftTime, string qualification)
-    : Staff(id, name, age, gender, address, contactNumber, salary, department, joinDate),  // Base Staff
-      nurseId(id),            // Nurse-specific ID
-      shiftTime(shiftTime),   // Work schedule
-      qualification(qualification) {}  // Professional credentials
+    : Staff(id, move(name), age, move(gender), move(address), move(contactNumber), salary, move(department),
+            move(joinDate)),               // Base Staff
+      nurseId(id),                         // Nurse-specific ID
+      shiftTime(shiftTime),                // Work schedule (checked where entered)
+      qualification(move(qualification)) {}  // Professional credentials
 
 // Displays complete nurse information
 void Nurse::displayDetails() const {
     Staff::displayDetails();  // Shows base Staff info
-    cout << "Shift Time: " << shiftTime << "\n";
+    cout << "Shift Time: " << shiftTime.view() << "\n";
     cout << "Qualification: " << qualification << "\n";
 }
 
+// Records nurse memory footprint
+void Nurse::reportMemory(MemoryReport& report) const {
+    size_t bytes = sizeof(Nurse) + staffHeapBytes() + stringHeapBytes(qualification);
+    report.record(Subsystem::Persons, "Nurse", bytes);
+}
+
 // Simulates assisting a doctor
 void Nurse::assistDoctor(int doctorId) {
     cout << "\nNurse " << name << " is now assisting Doctor ID " << doctorId << "\n";
@@ -291,4 +779,35 @@ void Nurse::assistDoctor(int doctorId) {
 // Simulates monitoring a patient
 void Nurse::monitorPatient(int patientId) {
     cout << "\nNurse " << name << " is now monitoring Patient ID " << patientId << "\n";
+}
+
+// Getter for shift time
+string_view Nurse::getShiftTime() const { return shiftTime.view(); }
+
+// Shift name or hours ("Night", "08:00-16:00")
+bool Nurse::isValidShiftTime(string_view shift) {
+    if (shift.empty() || !ShiftTimeText::fits(shift)) return false;
+    for (char c : shift) {
+        if (!isprint(static_cast<unsigned char>(c))) return false;
+    }
+    return true;
+}
+
+// Getter for qualification
+const string& Nurse::getQualification() const { return qualification; }
+
+// Serializes profile, staff details, shift and qualification
+void Nurse::writeTo(vector<uint8_t>& out) const {
+    writeStaffFields(out);
+    writeString(out, shiftTime.view());
+    writeString(out, qualification);
+}
+
+// Reads a nurse written by writeTo
+Nurse Nurse::readFrom(const vector<uint8_t>& in, size_t& pos) {
+    SavedPerson saved = readPersonFields(in, pos, true);
+    string shiftTime = readString(in, pos);
+    string qualification = readString(in, pos);
+    return Nurse(saved.id, saved.name, saved.age, saved.gender, saved.address, saved.contactNumber,
+                 saved.salary, saved.department, saved.joinDate, shiftTime, qualification);
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <vector>     // For chunk list
+#include <memory>     // For unique_ptr chunk ownership
+#include <new>        // For placement new
+#include <utility>    // For std::forward
+#include <cstdint>    // For fixed-width handle fields
+#include <cstddef>    // For size_t
+using namespace std;
+
+// Stable reference to an object in an ObjectPool.
+// The generation detects use of a handle after its object was destroyed.
+struct PoolHandle {
+    uint32_t index = UINT32_MAX;  // Slot index inside the pool
+    uint32_t generation = 0;      // Slot generation when the handle was issued
+
+    bool isValid() const { return index != UINT32_MAX; }
+};
+
+// Type-specific pool allocator.
+// Objects live in fixed-size chunks that never move, so pointers and handles stay
+// valid until the object is destroyed. Allocation pops the free list or bumps the
+// high-water mark; releasing the pool frees every chunk at once.
+template <typename T, size_t ChunkSize = 64>
+class ObjectPool {
+private:
+    static const uint32_t NO_SLOT = UINT32_MAX;
+
+    // Storage for one object plus its bookkeeping
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];  // Object bytes (must stay first)
+        uint32_t index;       // Position of this slot in the pool
+        uint32_t generation;  // Incremented every time the slot is freed
+        uint32_t nextFree;    // Next slot in the free list
+        bool live;            // True while an object is constructed here
+    };
+
+    vector<unique_ptr<Slot[]>> chunks;  // Chunk storage, contiguous within a chunk
+    uint32_t highWater = 0;             // Slots handed out by bumping
+    uint32_t freeHead = NO_SLOT;        // First free slot available for reuse
+    size_t liveCount = 0;               // Number of constructed objects
+
+    // Returns slot at given index
+    Slot& slotAt(uint32_t index) const {
+        return chunks[index / ChunkSize][index % ChunkSize];
+    }
+
+    // Returns slot that holds the given object
+    static Slot* slotOf(const T* object) {
+        return reinterpret_cast<Slot*>(const_cast<T*>(object));
+    }
+
+    // Reserves a slot, reusing freed slots before growing
+    Slot& acquireSlot() {
+        if (freeHead != NO_SLOT) {
+            Slot& slot = slotAt(freeHead);
+            freeHead = slot.nextFree;
+            return slot;
+        }
+        if (highWater == chunks.size() * ChunkSize) {
+            chunks.emplace_back(new Slot[ChunkSize]);  // Grow by one chunk
+        }
+        Slot& slot = slotAt(highWater);
+        slot.index = highWater++;
+        slot.generation = 0;
+        slot.live = false;
+        return slot;
+    }
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;             // Pool owns its objects
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ~ObjectPool() { clear(); }
+
+    // Constructs a new object inside the pool
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot& slot = acquireSlot();
+        T* object = new (slot.storage) T(forward<Args>(args)...);
+        slot.live = true;
+        liveCount++;
+        return object;
+    }
+
+    // Destroys an object and returns its slot to the free list
+    void destroy(T* object) {
+        if (!object) return;
+        Slot* slot = slotOf(object);
+        object->~T();
+        slot->live = false;
+        slot->generation++;  // Invalidates outstanding handles
+        slot->nextFree = freeHead;
+        freeHead = slot->index;
+        liveCount--;
+    }
+
+    // Destroys every object and releases all chunks in one step
+    void clear() {
+        forEach([](T& object) { object.~T(); });
+        chunks.clear();
+        highWater = 0;
+        freeHead = NO_SLOT;
+        liveCount = 0;
+    }
+
+    // Returns stable handle for an object created by this pool
+    PoolHandle handleOf(const T* object) const {
+        PoolHandle handle;
+        if (object) {
+            const Slot* slot = slotOf(object);
+            handle.index = slot->index;
+            handle.generation = slot->generation;
+        }
+        return handle;
+    }
+
+    // Resolves a handle, returning nullptr if the object no longer exists
+    T* get(PoolHandle handle) const {
+        if (!handle.isValid() || handle.index >= highWater) return nullptr;
+        Slot& slot = slotAt(handle.index);
+        if (!slot.live || slot.generation != handle.generation) return nullptr;
+        return reinterpret_cast<T*>(slot.storage);
+    }
+
+    // Object in the slot at index, or nullptr if the slot is free
+    T* at(uint32_t index) const {
+        if (index >= highWater) return nullptr;
+        Slot& slot = slotAt(index);
+        return slot.live ? reinterpret_cast<T*>(slot.storage) : nullptr;
+    }
+
+    // Visits every live object in memory order
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (uint32_t i = 0; i < highWater; i++) {
+            Slot& slot = slotAt(i);
+            if (slot.live) visit(*reinterpret_cast<T*>(slot.storage));
+        }
+    }
+
+    // Accessor methods
+    size_t size() const { return liveCount; }
+    size_t reservedBytes() const { return chunks.size() * ChunkSize * sizeof(Slot); }
+    size_t overheadBytes() const { return reservedBytes() - liveCount * sizeof(T); }  // Free slots and bookkeeping
+};
@@ -0,0 +1,234 @@
+#include "replication.h"  // Log shipping declarations
+#include "varint.h"       // For frame encoding
+#include <chrono>         // For commit timestamps
+#include <cstring>        // For memcmp
+
+// Every log starts with this tag and format version, so stray files are rejected
+static const char LOG_MAGIC[4] = { 'H', 'L', 'O', 'G' };
+static const uint8_t LOG_VERSION = 1;
+static const size_t LOG_HEADER_SIZE = sizeof(LOG_MAGIC) + 1;
+
+// ========== HELPERS ========== //
+
+// 32-bit FNV-1a checksum of a frame body
+static uint32_t frameChecksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Display name of a mutation type
+const char* mutationTypeName(MutationType type) {
+    switch (type) {
+        case MutationType::RegisterPatient:     return "Register Patient";
+        case MutationType::RegisterDoctor:      return "Register Doctor";
+        case MutationType::RegisterNurse:       return "Register Nurse";
+        case MutationType::AddMedicine:         return "Add Medicine";
+        case MutationType::AddRoom:             return "Add Room";
+        case MutationType::CreateBill:          return "Create Bill";
+        case MutationType::UpdateContactInfo:   return "Update Contact Info";
+        case MutationType::UpdateBloodGroup:    return "Update Blood Group";
+        case MutationType::AddDisease:          return "Add Medical Condition";
+        case MutationType::ScheduleAppointment: return "Book Appointment";
+        case MutationType::AddMedicalRecord:    return "Create Medical Record";
+        case MutationType::AddTestResult:       return "Add Test Result";
+        case MutationType::UpdateTreatmentPlan: return "Update Treatment Plan";
+        case MutationType::CompleteAppointment: return "Complete Appointment";
+        case MutationType::AddAvailableSlot:    return "Add Available Slot";
+        case MutationType::AssignRoom:          return "Assign Room";
+        case MutationType::DischargePatient:    return "Discharge from Room";
+        case MutationType::UpdateStock:         return "Update Medicine Stock";
+        case MutationType::AddServiceToBill:    return "Add Service to Bill";
+        case MutationType::AddMedicineToBill:   return "Add Medicine to Bill";
+        case MutationType::ProcessPayment:      return "Process Payment";
+        case MutationType::TransferDepartment:  return "Transfer Department";
+        case MutationType::RemoveDisease:       return "Remove Medical Condition";
+        case MutationType::RemoveAppointment:   return "Remove Appointment";
+        case MutationType::RemoveMedicalRecord: return "Remove Medical Record";
+        case MutationType::RemoveTestResult:    return "Remove Test Result";
+        case MutationType::RevertTreatmentPlan: return "Revert Treatment Plan";
+        case MutationType::ReopenAppointment:   return "Reopen Appointment";
+        case MutationType::RemoveAvailableSlot: return "Remove Available Slot";
+        case MutationType::RemoveServiceFromBill:  return "Remove Service from Bill";
+        case MutationType::RemoveMedicineFromBill: return "Remove Medicine from Bill";
+        case MutationType::RefundPayment:       return "Refund Payment";
+    }
+    return "Unknown";
+}
+
+// Microseconds since the epoch on the wall clock
+int64_t wallClockMicros() {
+    return chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// ========== MUTATION IMPLEMENTATION ========== //
+
+Mutation& Mutation::addInt(int64_t value) {
+    writeSigned(arguments, value);
+    return *this;
+}
+
+Mutation& Mutation::addDouble(double value) {
+    writeDouble(arguments, value);
+    return *this;
+}
+
+Mutation& Mutation::addText(string_view value) {
+    writeString(arguments, value);
+    return *this;
+}
+
+int64_t MutationReader::nextInt() { return readSigned(bytes, pos); }
+
+double MutationReader::nextDouble() { return readDouble(bytes, pos); }
+
+string MutationReader::nextText() { return readString(bytes, pos); }
+
+// ========== LOG SHIPPER IMPLEMENTATION ========== //
+
+// Starts a new log (truncating any old one) or continues an existing one
+bool LogShipper::open(const string& logPath, bool append, uint64_t lastSequence) {
+    close();
+    file.open(logPath, ios::binary | (append ? ios::app : ios::trunc));
+    if (!file) return false;
+    if (!append) {
+        file.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+        file.put(static_cast<char>(LOG_VERSION));
+        file.flush();
+    }
+    path = logPath;
+    sequence = lastSequence;
+    records = 0;
+    bytes = 0;
+    return static_cast<bool>(file);
+}
+
+// Stops shipping (the file stays for standbys)
+void LogShipper::close() {
+    if (file.is_open()) file.close();
+    file.clear();
+}
+
+// Writes [varint length][type, sequence, commit time, arguments][checksum] and flushes
+bool LogShipper::ship(Mutation& mutation) {
+    if (!file.is_open()) return false;
+    mutation.sequence = ++sequence;
+    mutation.committedAt = wallClockMicros();
+
+    vector<uint8_t> body;
+    body.reserve(mutation.arguments.size() + 16);
+    body.push_back(static_cast<uint8_t>(mutation.type));
+    writeVarint(body, mutation.sequence);
+    writeSigned(body, mutation.committedAt);
+    body.insert(body.end(), mutation.arguments.begin(), mutation.arguments.end());
+
+    vector<uint8_t> frame;
+    frame.reserve(body.size() + 14);
+    writeVarint(frame, body.size());
+    frame.insert(frame.end(), body.begin(), body.end());
+    uint32_t checksum = frameChecksum(body.data(), body.size());
+    for (int i = 0; i < 4; i++) frame.push_back(static_cast<uint8_t>(checksum >> (8 * i)));
+
+    file.write(reinterpret_cast<const char*>(frame.data()), static_cast<streamsize>(frame.size()));
+    file.flush();  // The standby reads the file, not this process's buffer
+    records++;
+    bytes += frame.size();
+    return static_cast<bool>(file);
+}
+
+bool LogShipper::isOpen() const { return file.is_open(); }
+
+const string& LogShipper::getPath() const { return path; }
+
+uint64_t LogShipper::lastSequence() const { return sequence; }
+
+size_t LogShipper::recordCount() const { return records; }
+
+uint64_t LogShipper::bytesWritten() const { return bytes; }
+
+// ========== LOG FOLLOWER IMPLEMENTATION ========== //
+
+// Opens a log and checks its header
+bool LogFollower::open(const string& logPath) {
+    if (file.is_open()) file.close();
+    file.clear();
+    file.open(logPath, ios::binary);
+    if (!file) return false;
+    char header[LOG_HEADER_SIZE];
+    if (!file.read(header, LOG_HEADER_SIZE) || memcmp(header, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 ||
+        static_cast<uint8_t>(header[sizeof(LOG_MAGIC)]) != LOG_VERSION) {
+        file.close();
+        return false;
+    }
+    path = logPath;
+    position = LOG_HEADER_SIZE;
+    fileSize = LOG_HEADER_SIZE;
+    damaged = false;
+    return true;
+}
+
+// Decodes every complete frame between the last position and the end of the file
+size_t LogFollower::poll(vector<Mutation>& mutations) {
+    if (!file.is_open() || damaged) return 0;
+    file.clear();
+    file.seekg(0, ios::end);
+    uint64_t size = static_cast<uint64_t>(file.tellg());
+    if (size < position) {  // The primary started a new log
+        damaged = true;
+        return 0;
+    }
+    fileSize = size;
+    if (size == position) return 0;
+
+    vector<uint8_t> buffer(static_cast<size_t>(size - position));
+    file.seekg(static_cast<streamoff>(position));
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), static_cast<streamsize>(buffer.size()))) return 0;
+
+    size_t pos = 0, count = 0;
+    while (pos < buffer.size()) {
+        // Frame length, which may itself still be incomplete
+        uint64_t length = 0;
+        size_t next = pos;
+        bool complete = false;
+        for (int shift = 0; next < buffer.size() && shift < 64; shift += 7) {
+            uint8_t byte = buffer[next++];
+            length |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                complete = true;
+                break;
+            }
+        }
+        if (!complete || buffer.size() - next < length + 4) break;  // Rest arrives later
+
+        const uint8_t* data = buffer.data() + next;
+        uint32_t stored = 0;
+        for (int i = 0; i < 4; i++) stored |= static_cast<uint32_t>(data[length + i]) << (8 * i);
+        if (length == 0 || stored != frameChecksum(data, static_cast<size_t>(length))) {
+            damaged = true;
+            break;
+        }
+
+        vector<uint8_t> body(data, data + length);
+        size_t at = 0;
+        Mutation mutation(static_cast<MutationType>(body[at++]));
+        mutation.sequence = readVarint(body, at);
+        mutation.committedAt = readSigned(body, at);
+        mutation.arguments.assign(body.begin() + static_cast<ptrdiff_t>(at), body.end());
+        mutations.push_back(move(mutation));
+        pos = next + static_cast<size_t>(length) + 4;
+        count++;
+    }
+    position += pos;
+    return count;
+}
+
+uint64_t LogFollower::validBytes() const { return position; }
+
+uint64_t LogFollower::bytesBehind() const { return fileSize > position ? fileSize - position : 0; }
+
+bool LogFollower::isDamaged() const { return damaged; }
+
+const string& LogFollower::getPath() const { return path; }
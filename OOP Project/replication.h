@@ -0,0 +1,133 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>    // For log paths and text arguments
+#include <string_view> // For text arguments held outside a string
+#include <vector>    // For encoded arguments
+#include <fstream>   // For the shared log file
+#include <cstdint>   // For fixed-width types
+using namespace std;
+
+// Kinds of change a primary ships to its standby
+enum class MutationType : uint8_t {
+    RegisterPatient = 1,
+    RegisterDoctor,
+    RegisterNurse,
+    AddMedicine,
+    AddRoom,
+    CreateBill,
+    UpdateContactInfo,
+    UpdateBloodGroup,
+    AddDisease,
+    ScheduleAppointment,
+    AddMedicalRecord,
+    AddTestResult,
+    UpdateTreatmentPlan,
+    CompleteAppointment,
+    AddAvailableSlot,
+    AssignRoom,
+    DischargePatient,
+    UpdateStock,
+    AddServiceToBill,
+    AddMedicineToBill,
+    ProcessPayment,
+    TransferDepartment,
+    // Reversals made by undo
+    RemoveDisease,
+    RemoveAppointment,
+    RemoveMedicalRecord,
+    RemoveTestResult,
+    RevertTreatmentPlan,
+    ReopenAppointment,
+    RemoveAvailableSlot,
+    RemoveServiceFromBill,
+    RemoveMedicineFromBill,
+    RefundPayment
+};
+
+// Display name of a mutation type
+const char* mutationTypeName(MutationType type);
+
+// One logged change: what happened, its place in the log, when it was committed
+// and its arguments (added and read back in the same order)
+struct Mutation {
+    MutationType type;
+    uint64_t sequence = 0;      // Position in the log (1, 2, ...)
+    int64_t committedAt = 0;    // Primary wall clock, microseconds since the epoch
+    vector<uint8_t> arguments;  // Encoded arguments
+
+    explicit Mutation(MutationType type) : type(type) {}
+
+    // Argument encoding (calls chain)
+    Mutation& addInt(int64_t value);
+    Mutation& addDouble(double value);
+    Mutation& addText(string_view value);
+};
+
+// Reads a mutation's arguments in the order they were added
+class MutationReader {
+private:
+    const vector<uint8_t>& bytes;  // Encoded arguments
+    size_t pos = 0;                // Next unread byte
+
+public:
+    explicit MutationReader(const Mutation& mutation) : bytes(mutation.arguments) {}
+
+    int64_t nextInt();
+    double nextDouble();
+    string nextText();
+};
+
+// Microseconds since the epoch on the wall clock (shared by local processes)
+int64_t wallClockMicros();
+
+// Primary side of log shipping: appends each mutation to a shared file as a
+// length-prefixed, checksummed frame and flushes it, so a standby process
+// tailing the file sees it at once.
+class LogShipper {
+private:
+    ofstream file;              // Open log
+    string path;                // Log file
+    uint64_t sequence = 0;      // Last sequence number handed out
+    size_t records = 0;         // Mutations shipped since opening
+    uint64_t bytes = 0;         // Bytes appended since opening
+
+public:
+    // Starts a new log, or continues one (a promoted standby) after lastSequence
+    bool open(const string& logPath, bool append = false, uint64_t lastSequence = 0);
+    void close();
+
+    // Stamps the mutation with the next sequence number and commit time, then writes it
+    bool ship(Mutation& mutation);
+
+    // Accessor methods
+    bool isOpen() const;
+    const string& getPath() const;
+    uint64_t lastSequence() const;
+    size_t recordCount() const;
+    uint64_t bytesWritten() const;
+};
+
+// Standby side of log shipping: reads frames appended since the last poll.
+// A frame still being written is left for the next poll.
+class LogFollower {
+private:
+    ifstream file;              // Log being followed
+    string path;                // Log file
+    uint64_t position = 0;      // End of the last complete frame
+    uint64_t fileSize = 0;      // Size seen by the last poll
+    bool damaged = false;       // A frame failed its checksum or the log was restarted
+
+public:
+    // Opens a log written by a primary (false if it is missing or not a log)
+    bool open(const string& logPath);
+
+    // Appends every complete frame written since the last call; returns how many
+    size_t poll(vector<Mutation>& mutations);
+
+    // Accessor methods
+    uint64_t validBytes() const;   // End of the last complete frame
+    uint64_t bytesBehind() const;  // Bytes written but not yet read
+    bool isDamaged() const;
+    const string& getPath() const;
+};
@@ -0,0 +1,137 @@
+#include "segment_store.h"  // Segment store declarations
+#include "compression.h"    // For segment compression
+#include "varint.h"         // For segment headers
+#include <fstream>          // For segment files
+#include <filesystem>       // For directory management
+#include <cstring>          // For memcmp
+
+namespace fs = std::filesystem;
+
+// Every segment starts with this tag, so stray or truncated files are rejected
+static const char SEGMENT_MAGIC[4] = { 'P', 'S', 'E', 'G' };
+
+// ========== SEGMENT STORE IMPLEMENTATION ========== //
+
+// Deletes the segments on destruction
+SegmentStore::~SegmentStore() { close(); }
+
+// File name of a segment
+string SegmentStore::pathOf(uint32_t segment) const {
+    return directory + "/patient_" + to_string(segment) + ".seg";
+}
+
+// Size of an existing segment file (0 if absent)
+uint64_t SegmentStore::sizeOf(uint32_t segment) const {
+    error_code error;
+    uint64_t size = fs::file_size(pathOf(segment), error);
+    return error ? 0 : size;
+}
+
+// Creates the directory if needed
+bool SegmentStore::open(const string& directoryPath) {
+    close();
+    error_code error;
+    fs::create_directories(directoryPath, error);
+    if (!fs::is_directory(directoryPath, error)) return false;
+    directory = directoryPath;
+    active = true;
+    segments = 0;
+    diskBytes = 0;
+    segmentsWritten = segmentsRead = 0;
+    rawWritten = bytesWritten = 0;
+    return true;
+}
+
+// Deletes every segment file, then the directory once empty
+void SegmentStore::close() {
+    if (!active) return;
+    error_code error;
+    vector<fs::path> files;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        string name = it->path().filename().string();
+        if (name.rfind("patient_", 0) == 0 && it->path().extension() == ".seg") files.push_back(it->path());
+    }
+    for (const auto& file : files) fs::remove(file, error);
+    fs::remove(directory, error);  // Only succeeds if nothing else was put there
+    active = false;
+    segments = 0;
+    diskBytes = 0;
+}
+
+// Writes a segment as [magic][varint raw length][compressed bytes]
+bool SegmentStore::write(uint32_t segment, const vector<uint8_t>& blob) {
+    if (!active) return false;
+    vector<uint8_t> bytes(SEGMENT_MAGIC, SEGMENT_MAGIC + sizeof(SEGMENT_MAGIC));
+    writeVarint(bytes, blob.size());
+    lzCompress(reinterpret_cast<const char*>(blob.data()), blob.size(), bytes);
+
+    uint64_t previous = sizeOf(segment);
+    ofstream file(pathOf(segment), ios::binary | ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+    file.close();
+    if (!file) return false;
+
+    if (previous) diskBytes -= previous;
+    else segments++;
+    diskBytes += bytes.size();
+    segmentsWritten++;
+    rawWritten += blob.size();
+    bytesWritten += bytes.size();
+    return true;
+}
+
+// Reads and decompresses a segment
+bool SegmentStore::read(uint32_t segment, vector<uint8_t>& blob) {
+    if (!active) return false;
+    ifstream file(pathOf(segment), ios::binary | ios::ate);
+    if (!file) return false;
+    vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+    if (!file || bytes.size() <= sizeof(SEGMENT_MAGIC) ||
+        memcmp(bytes.data(), SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0) {
+        return false;
+    }
+
+    size_t pos = sizeof(SEGMENT_MAGIC);
+    size_t rawSize = readVarint(bytes, pos);
+    string raw;
+    raw.reserve(rawSize);
+    if (!lzDecompress(bytes.data() + pos, bytes.size() - pos, raw) || raw.size() != rawSize) return false;
+    blob.assign(raw.begin(), raw.end());
+    segmentsRead++;
+    return true;
+}
+
+// Deletes a segment file
+void SegmentStore::erase(uint32_t segment) {
+    uint64_t size = sizeOf(segment);
+    error_code error;
+    if (!active || !fs::remove(pathOf(segment), error)) return;
+    diskBytes -= size;
+    segments--;
+}
+
+// True between open and close
+bool SegmentStore::isOpen() const { return active; }
+
+// Folder holding the segment files
+const string& SegmentStore::getDirectory() const { return directory; }
+
+// Segment files present
+size_t SegmentStore::segmentCount() const { return segments; }
+
+// Bytes in segment files
+uint64_t SegmentStore::bytesOnDisk() const { return diskBytes; }
+
+// Raw bytes written so far
+uint64_t SegmentStore::uncompressedBytes() const { return rawWritten; }
+
+// File bytes written so far
+uint64_t SegmentStore::compressedBytes() const { return bytesWritten; }
+
+// Number of segment writes
+size_t SegmentStore::writeCount() const { return segmentsWritten; }
+
+// Number of segment reads
+size_t SegmentStore::readCount() const { return segmentsRead; }
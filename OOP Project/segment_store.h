@@ -0,0 +1,62 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For directory and file names
+#include <vector>   // For blob buffers
+#include <cstdint>  // For fixed-width types
+using namespace std;
+
+// Directory of per-owner segment files.
+// Each segment holds one owner's data as a single LZ-compressed blob, so it is
+// read or rewritten without touching anyone else's and never needs compacting.
+// Only running totals stay in memory; segment numbers are kept by the owners.
+class SegmentStore {
+private:
+    string directory;        // Folder holding the segment files
+    bool active = false;     // True between open and close
+
+    // Totals and I/O statistics
+    size_t segments = 0;          // Segment files present
+    uint64_t diskBytes = 0;       // Bytes in segment files
+    size_t segmentsWritten = 0;   // Segment writes
+    size_t segmentsRead = 0;      // Segment reads
+    uint64_t rawWritten = 0;      // Uncompressed bytes written
+    uint64_t bytesWritten = 0;    // File bytes written
+
+    // File name of a segment
+    string pathOf(uint32_t segment) const;
+
+    // Size of an existing segment file (0 if absent)
+    uint64_t sizeOf(uint32_t segment) const;
+
+public:
+    SegmentStore() = default;
+    SegmentStore(const SegmentStore&) = delete;             // Owns its files
+    SegmentStore& operator=(const SegmentStore&) = delete;
+    ~SegmentStore();
+
+    // Creates the directory if needed; returns false if it cannot be used
+    bool open(const string& directoryPath);
+
+    // Deletes every segment file (and the directory once empty)
+    void close();
+
+    // Writes (or replaces) a segment; returns false on I/O failure
+    bool write(uint32_t segment, const vector<uint8_t>& blob);
+
+    // Reads a segment back; returns false if it is missing or damaged
+    bool read(uint32_t segment, vector<uint8_t>& blob);
+
+    // Deletes a segment file
+    void erase(uint32_t segment);
+
+    // Accessor methods
+    bool isOpen() const;
+    const string& getDirectory() const;
+    size_t segmentCount() const;
+    uint64_t bytesOnDisk() const;
+    uint64_t uncompressedBytes() const;  // Raw bytes written so far
+    uint64_t compressedBytes() const;    // File bytes written so far
+    size_t writeCount() const;
+    size_t readCount() const;
+};
@@ -0,0 +1,269 @@
+#include "session.h"  // Session record and replay declarations
+#include <iostream>   // For the console being redirected
+#include <iomanip>    // For formatted timings
+#include <algorithm>  // For sorting operations
+#include <cctype>     // For character classes
+#include <cstdlib>    // For atoll
+
+// First line of every session file
+static const string SESSION_TAG = "# hospital session";
+
+// Saved instead of a line typed at a password prompt
+static const string PASSWORD_PLACEHOLDER = "<password not recorded>";
+
+// A session that ends inside a menu is backed out with this many "0" lines at most
+static const size_t MAX_BACK_OUT_LINES = 1000;
+
+// ========== HELPERS ========== //
+
+// Text without surrounding spaces, tabs and the main menu's "||" borders
+static string trimmed(const string& text) {
+    size_t first = text.find_first_not_of(" \t\r|");
+    if (first == string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r|");
+    return text.substr(first, last - first + 1);
+}
+
+// True for the rule lines displayHeader draws above and below a title (with the
+// screen not cleared, the upper rule follows the previous prompt on its line)
+static bool isHeaderRule(const string& text) {
+    size_t last = text.find_last_not_of('=');
+    return text.size() - (last == string::npos ? 0 : last + 1) >= 40;
+}
+
+// True if the output just before a read asked for a menu choice
+static bool asksForChoice(string prompt) {
+    for (char& c : prompt) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return prompt.find("choice") != string::npos;
+}
+
+// True if the last output line before a read asks for a password
+static bool asksForPassword(const string& prompt) {
+    string last = prompt.substr(prompt.find_last_of('\n') + 1);  // Menus above it may offer "Reset Password"
+    for (char& c : last) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return last.find("password") != string::npos;
+}
+
+// ========== SESSION RECORDER IMPLEMENTATION ========== //
+
+SessionRecorder::~SessionRecorder() { stop(); }
+
+bool SessionRecorder::start(const string& path) {
+    file.open(path, ios::trunc);
+    if (!file) return false;
+    file << SESSION_TAG << "\n";
+    began = chrono::steady_clock::now();
+    source = cin.rdbuf(this);
+    console = cout.rdbuf(&output);
+    return true;
+}
+
+void SessionRecorder::stop() {
+    if (!source) return;
+    cin.rdbuf(source);
+    cout.rdbuf(console);
+    source = nullptr;
+    console = nullptr;
+    file.close();
+}
+
+// Reads the next keyboard line, appends it to the file (a password as the
+// placeholder) and serves it to cin
+int SessionRecorder::underflow() {
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    line.clear();
+    int c;
+    while ((c = source->sbumpc()) != traits_type::eof()) {
+        line += static_cast<char>(c);
+        if (c == '\n') break;
+    }
+    if (line.empty()) return traits_type::eof();
+
+    string text = line.substr(0, line.find_last_not_of("\r\n") + 1);
+    long long elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - began).count();
+    file << elapsed << '\t' << (asksForPassword(prompt) ? PASSWORD_PLACEHOLDER : text) << '\n' << flush;
+    prompt.clear();
+    lines++;
+    setg(&line[0], &line[0], &line[0] + line.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+size_t SessionRecorder::lineCount() const { return lines; }
+
+int SessionRecorder::Output::overflow(int c) {
+    if (c == traits_type::eof()) return traits_type::not_eof(c);
+    owner.prompt += static_cast<char>(c);
+    if (owner.prompt.size() > 256) owner.prompt.erase(0, owner.prompt.size() - 128);  // Only the tail matters
+    return owner.console->sputc(static_cast<char>(c));
+}
+
+streamsize SessionRecorder::Output::xsputn(const char* text, streamsize count) {
+    owner.prompt.append(text, static_cast<size_t>(count));
+    if (owner.prompt.size() > 256) owner.prompt.erase(0, owner.prompt.size() - 128);
+    return owner.console->sputn(text, count);
+}
+
+int SessionRecorder::Output::sync() { return owner.console->pubsync(); }
+
+// ========== SESSION REPLAYER IMPLEMENTATION ========== //
+
+SessionReplayer::~SessionReplayer() {
+    if (savedInput) {
+        cin.rdbuf(savedInput);
+        cout.rdbuf(savedOutput);
+    }
+}
+
+bool SessionReplayer::load(const string& path) {
+    ifstream file(path);
+    string text;
+    if (!getline(file, text) || text != SESSION_TAG) return false;
+    lines.clear();
+    while (getline(file, text)) {
+        size_t tab = text.find('\t');
+        if (tab == string::npos) return false;  // Damaged line
+        recordedMs = atoll(text.substr(0, tab).c_str());
+        lines.push_back(text.substr(tab + 1));
+    }
+    return true;
+}
+
+void SessionReplayer::setPassword(const string& text) { password = text; }
+
+void SessionReplayer::start() {
+    started = lastServed = chrono::steady_clock::now();
+    savedInput = cin.rdbuf(&input);
+    savedOutput = cout.rdbuf(&output);
+}
+
+// Next recorded line; past the end, "0" backs out of whatever menu is open
+bool SessionReplayer::serveLine(string& text) {
+    auto now = chrono::steady_clock::now();
+    operationSeconds += chrono::duration<double>(now - lastServed).count();
+
+    if (nextLine < lines.size()) {
+        text = lines[nextLine++];
+        if (text == PASSWORD_PLACEHOLDER && !password.empty()) text = password;
+    } else if (backOutLines < MAX_BACK_OUT_LINES) {
+        text = "0";
+        backOutLines++;
+    } else {
+        return false;
+    }
+
+    // A blank line leaves a menu waiting for its choice (cin >> skips it)
+    string choice = trimmed(text);
+    if (!choice.empty()) {
+        if (asksForChoice(prompt)) {
+            finishOperation();
+            auto option = options.find(choice);
+            operation = (menu.empty() ? title : menu) + " > " + choice +
+                        (option != options.end() ? ". " + option->second : "");
+        }
+        prompt.clear();
+    }
+    text += '\n';
+    lastServed = chrono::steady_clock::now();  // Labelling is not charged to the program
+    return true;
+}
+
+void SessionReplayer::finishOperation() {
+    ReplayTiming& timing = timings[operation];
+    timing.count++;
+    timing.total += operationSeconds;
+    timing.longest = max(timing.longest, operationSeconds);
+    operationSeconds = 0;
+}
+
+// Tracks headers and numbered options; the first option of a menu names it,
+// so a menu is still labelled by its own title after a report replaced the header
+void SessionReplayer::readOutputLine(const string& text) {
+    string line = trimmed(text);
+    if (isHeaderRule(line)) {
+        inHeader = !inHeader;
+        return;
+    }
+    if (inHeader) {
+        title = line;
+        return;
+    }
+    size_t digits = 0;
+    while (digits < line.size() && isdigit(static_cast<unsigned char>(line[digits]))) digits++;
+    if (digits == 0 || digits + 1 >= line.size() || line[digits] != '.' || line[digits + 1] != ' ') return;
+    string number = line.substr(0, digits);
+    string label = trimmed(line.substr(digits + 2));
+    if (number == "1") {
+        menu = menus.emplace(label, title).first->second;
+        options.clear();
+    }
+    options[number] = label;
+}
+
+void SessionReplayer::finish() {
+    if (!savedInput) return;
+    auto now = chrono::steady_clock::now();
+    operationSeconds += chrono::duration<double>(now - lastServed).count();
+    finishOperation();
+    replaySeconds = chrono::duration<double>(now - started).count();
+    cin.rdbuf(savedInput);
+    cout.rdbuf(savedOutput);
+    cin.clear();
+    savedInput = savedOutput = nullptr;
+
+    vector<pair<string, ReplayTiming>> sorted(timings.begin(), timings.end());
+    sort(sorted.begin(), sorted.end(), [](const pair<string, ReplayTiming>& a, const pair<string, ReplayTiming>& b) {
+        return a.second.total > b.second.total;
+    });
+
+    cout << fixed << setprecision(3);
+    cout << "\nReplayed " << nextLine << " input lines in " << replaySeconds * 1000 << " ms (recorded session: "
+         << recordedMs / 1000.0 << " s)\n";
+    if (backOutLines) {
+        cout << "The recording ended inside a menu; " << backOutLines << " \"0\" lines were added to exit.\n";
+    }
+    size_t width = 9;  // Widest label, up to 80 characters
+    for (const auto& entry : sorted) width = max(width, min<size_t>(entry.first.size(), 80));
+    cout << "\n" << left << setw(width + 2) << "Operation" << right << setw(7) << "Count" << setw(12) << "Total ms"
+         << setw(11) << "Mean ms" << setw(11) << "Max ms" << "\n";
+    cout << string(width + 43, '-') << "\n";
+    for (const auto& entry : sorted) {
+        string label = entry.first.size() > width ? entry.first.substr(0, width - 3) + "..." : entry.first;
+        const ReplayTiming& timing = entry.second;
+        cout << left << setw(width + 2) << label << right << setw(7) << timing.count << setw(12) << timing.total * 1000
+             << setw(11) << timing.total * 1000 / timing.count << setw(11) << timing.longest * 1000 << "\n";
+    }
+    cout.unsetf(ios::adjustfield);
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+size_t SessionReplayer::lineCount() const { return lines.size(); }
+
+// ========== CONSOLE BUFFERS ========== //
+
+int SessionReplayer::Input::underflow() {
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    if (!owner.serveLine(line)) return traits_type::eof();
+    setg(&line[0], &line[0], &line[0] + line.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+void SessionReplayer::Output::endLine() {
+    owner.readOutputLine(current);
+    current.clear();
+}
+
+int SessionReplayer::Output::overflow(int c) {
+    if (c == traits_type::eof()) return traits_type::not_eof(c);
+    char ch = static_cast<char>(c);
+    if (ch == '\n') endLine();
+    else current += ch;
+    owner.prompt += ch;
+    if (owner.prompt.size() > 256) owner.prompt.erase(0, owner.prompt.size() - 128);  // Only the tail matters
+    return c;
+}
+
+streamsize SessionReplayer::Output::xsputn(const char* text, streamsize count) {
+    for (streamsize i = 0; i < count; i++) overflow(traits_type::to_int_type(text[i]));
+    return count;
+}
@@ -0,0 +1,160 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>     // For recorded lines and labels
+#include <vector>     // For the loaded session
+#include <map>        // For per-operation statistics
+#include <fstream>    // For session files
+#include <streambuf>  // For console redirection
+#include <chrono>     // For timing
+using namespace std;
+
+// Session file format: a "# hospital session" line, then one line per line of
+// console input: milliseconds since the session started, a tab, the text.
+// A line typed at a password prompt is saved as a placeholder instead.
+
+// Sits between cin and the keyboard and appends every line typed to a session
+// file (flushed per line, so a session that ends abruptly is still kept)
+class SessionRecorder : public streambuf {
+private:
+    // Passes console output through, keeping the prompt before each read
+    class Output : public streambuf {
+    private:
+        SessionRecorder& owner;
+
+    protected:
+        int overflow(int c) override;
+        streamsize xsputn(const char* text, streamsize count) override;
+        int sync() override;
+
+    public:
+        explicit Output(SessionRecorder& owner) : owner(owner) {}
+    };
+
+    Output output;
+    streambuf* source = nullptr;          // Keyboard input
+    streambuf* console = nullptr;         // cout's own buffer while recording
+    ofstream file;                        // Session being written
+    string line;                          // Line currently served to cin
+    string prompt;                        // Output since the last line was read
+    chrono::steady_clock::time_point began;  // When recording started
+    size_t lines = 0;                     // Lines recorded
+
+protected:
+    int underflow() override;
+
+public:
+    SessionRecorder() : output(*this) {}
+    SessionRecorder(const SessionRecorder&) = delete;             // Owns the console
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+    ~SessionRecorder();
+
+    // Creates the session file and starts recording cin; false if it cannot be written
+    bool start(const string& path);
+
+    // Gives cin and cout back their own buffers
+    void stop();
+
+    size_t lineCount() const;
+};
+
+// Time spent on one kind of menu operation during a replay
+struct ReplayTiming {
+    size_t count = 0;      // Times the operation was chosen
+    double total = 0;      // Seconds spent in it
+    double longest = 0;    // Slowest single run
+};
+
+// Feeds a recorded session to cin as fast as the program reads it, with
+// console output discarded. Each menu choice starts an operation, labelled
+// with the menu it was made in and the option text; the operation runs until
+// the next menu choice, so it includes its prompts and its result.
+class SessionReplayer {
+private:
+    // Serves recorded lines to cin and times the work done between them
+    class Input : public streambuf {
+    private:
+        SessionReplayer& owner;
+        string line;  // Line currently served
+
+    protected:
+        int underflow() override;
+
+    public:
+        explicit Input(SessionReplayer& owner) : owner(owner) {}
+    };
+
+    // Discards console output, keeping what labels operations: the screen
+    // title, the numbered options on screen and the prompt before a read
+    class Output : public streambuf {
+    private:
+        SessionReplayer& owner;
+        string current;  // Output line being written
+
+        void endLine();
+
+    protected:
+        int overflow(int c) override;
+        streamsize xsputn(const char* text, streamsize count) override;
+
+    public:
+        explicit Output(SessionReplayer& owner) : owner(owner) {}
+    };
+
+    Input input;
+    Output output;
+    streambuf* savedInput = nullptr;   // cin's own buffer while replaying
+    streambuf* savedOutput = nullptr;  // cout's own buffer while replaying
+
+    // Loaded session
+    vector<string> lines;       // Recorded input lines
+    string password;            // Typed where the recording has a password placeholder
+    long long recordedMs = 0;   // Length of the recorded session
+    size_t nextLine = 0;        // Next line to serve
+    size_t backOutLines = 0;    // "0" lines served after the recording ended
+
+    // Screen state read from the output
+    string title;                   // Last header shown
+    bool inHeader = false;          // Between a header's two rules
+    map<string, string> menus;      // First option of each menu -> the title it appeared under
+    string menu;                    // Title of the menu on screen
+    map<string, string> options;    // Option number -> text for the menu on screen
+    string prompt;                  // Output since the last line was read
+
+    // Timing
+    chrono::steady_clock::time_point started;     // Replay start
+    chrono::steady_clock::time_point lastServed;  // When the previous line was served
+    string operation = "Startup";                 // Operation in progress
+    double operationSeconds = 0;                  // Time spent in it so far
+    map<string, ReplayTiming> timings;            // Completed operations by label
+    double replaySeconds = 0;                     // Whole replay
+
+    // Returns the next line to serve (false once the session is over)
+    bool serveLine(string& text);
+
+    // Adds the operation in progress to the statistics
+    void finishOperation();
+
+    // Reads one complete output line
+    void readOutputLine(const string& text);
+
+public:
+    SessionReplayer() : input(*this), output(*this) {}
+    SessionReplayer(const SessionReplayer&) = delete;             // Owns the console
+    SessionReplayer& operator=(const SessionReplayer&) = delete;
+    ~SessionReplayer();
+
+    // Loads a session file; false if it is missing or not a session
+    bool load(const string& path);
+
+    // Sets the test password typed at recorded password prompts
+    void setPassword(const string& text);
+
+    // Redirects cin and cout to the replay
+    void start();
+
+    // Restores the console and prints the per-operation timings
+    void finish();
+
+    size_t lineCount() const;
+};
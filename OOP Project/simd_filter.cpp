@@ -0,0 +1,261 @@
+#include "simd_filter.h"  // Filter kernel declarations
+#include <iostream>       // For benchmark output
+#include <iomanip>        // For formatted benchmark columns
+#include <chrono>         // For benchmark timing
+using namespace std;
+
+// Vector kernels are compiled per function with target attributes, so the
+// program still runs on CPUs without AVX2 (runtime dispatch picks the path).
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FILTER_HAS_X86 1
+#include <immintrin.h>  // SSE2/AVX2 intrinsics
+#else
+#define FILTER_HAS_X86 0
+#endif
+
+// ========== SCALAR KERNELS ========== //
+
+// Range filter, one row at a time
+static void rangeScalar(const int32_t* values, size_t rows, int32_t lo, int32_t hi, uint64_t* bits) {
+    for (size_t w = 0; w < bitmapWords(rows); w++) {
+        uint64_t word = 0;
+        size_t base = w * 64;
+        size_t end = base + 64 < rows ? base + 64 : rows;
+        for (size_t i = base; i < end; i++) {
+            uint64_t match = (values[i] >= lo) & (values[i] <= hi);
+            word |= match << (i - base);
+        }
+        bits[w] = word;
+    }
+}
+
+// Equality filter, one row at a time
+static void equalsScalar(const uint16_t* codes, size_t rows, uint16_t code, uint64_t* bits) {
+    for (size_t w = 0; w < bitmapWords(rows); w++) {
+        uint64_t word = 0;
+        size_t base = w * 64;
+        size_t end = base + 64 < rows ? base + 64 : rows;
+        for (size_t i = base; i < end; i++) {
+            uint64_t match = codes[i] == code;
+            word |= match << (i - base);
+        }
+        bits[w] = word;
+    }
+}
+
+#if FILTER_HAS_X86
+
+// ========== SSE2 KERNELS ========== //
+
+// Range filter, 4 rows per compare
+__attribute__((target("sse2")))
+static void rangeSSE2(const int32_t* values, size_t rows, int32_t lo, int32_t hi, uint64_t* bits) {
+    const __m128i vlo = _mm_set1_epi32(lo);
+    const __m128i vhi = _mm_set1_epi32(hi);
+    size_t fullWords = rows / 64;
+    for (size_t w = 0; w < fullWords; w++) {
+        const int32_t* block = values + w * 64;
+        uint64_t word = 0;
+        for (int j = 0; j < 16; j++) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + j * 4));
+            // Outside range when lo > v or v > hi
+            __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(vlo, v), _mm_cmpgt_epi32(v, vhi));
+            uint64_t mask = static_cast<unsigned>(~_mm_movemask_ps(_mm_castsi128_ps(outside))) & 0xF;
+            word |= mask << (j * 4);
+        }
+        bits[w] = word;
+    }
+    if (rows % 64) {  // Tail handled by scalar kernel
+        rangeScalar(values + fullWords * 64, rows % 64, lo, hi, bits + fullWords);
+    }
+}
+
+// Equality filter, 16 rows per pack
+__attribute__((target("sse2")))
+static void equalsSSE2(const uint16_t* codes, size_t rows, uint16_t code, uint64_t* bits) {
+    const __m128i key = _mm_set1_epi16(static_cast<short>(code));
+    size_t fullWords = rows / 64;
+    for (size_t w = 0; w < fullWords; w++) {
+        const uint16_t* block = codes + w * 64;
+        uint64_t word = 0;
+        for (int j = 0; j < 4; j++) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + j * 16));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + j * 16 + 8));
+            __m128i packed = _mm_packs_epi16(_mm_cmpeq_epi16(a, key), _mm_cmpeq_epi16(b, key));
+            uint64_t mask = static_cast<unsigned>(_mm_movemask_epi8(packed)) & 0xFFFF;
+            word |= mask << (j * 16);
+        }
+        bits[w] = word;
+    }
+    if (rows % 64) {
+        equalsScalar(codes + fullWords * 64, rows % 64, code, bits + fullWords);
+    }
+}
+
+// ========== AVX2 KERNELS ========== //
+
+// Range filter, 8 rows per compare
+__attribute__((target("avx2")))
+static void rangeAVX2(const int32_t* values, size_t rows, int32_t lo, int32_t hi, uint64_t* bits) {
+    const __m256i vlo = _mm256_set1_epi32(lo);
+    const __m256i vhi = _mm256_set1_epi32(hi);
+    size_t fullWords = rows / 64;
+    for (size_t w = 0; w < fullWords; w++) {
+        const int32_t* block = values + w * 64;
+        uint64_t word = 0;
+        for (int j = 0; j < 8; j++) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + j * 8));
+            __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(vlo, v), _mm256_cmpgt_epi32(v, vhi));
+            uint64_t mask = static_cast<unsigned>(~_mm256_movemask_ps(_mm256_castsi256_ps(outside))) & 0xFF;
+            word |= mask << (j * 8);
+        }
+        bits[w] = word;
+    }
+    if (rows % 64) {
+        rangeScalar(values + fullWords * 64, rows % 64, lo, hi, bits + fullWords);
+    }
+}
+
+// Equality filter, 32 rows per pack
+__attribute__((target("avx2")))
+static void equalsAVX2(const uint16_t* codes, size_t rows, uint16_t code, uint64_t* bits) {
+    const __m256i key = _mm256_set1_epi16(static_cast<short>(code));
+    size_t fullWords = rows / 64;
+    for (size_t w = 0; w < fullWords; w++) {
+        const uint16_t* block = codes + w * 64;
+        uint64_t word = 0;
+        for (int j = 0; j < 2; j++) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + j * 32));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + j * 32 + 16));
+            __m256i packed = _mm256_packs_epi16(_mm256_cmpeq_epi16(a, key), _mm256_cmpeq_epi16(b, key));
+            packed = _mm256_permute4x64_epi64(packed, 0xD8);  // Undo per-lane interleaving of pack
+            uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(packed));
+            word |= mask << (j * 32);
+        }
+        bits[w] = word;
+    }
+    if (rows % 64) {
+        equalsScalar(codes + fullWords * 64, rows % 64, code, bits + fullWords);
+    }
+}
+
+#endif  // FILTER_HAS_X86
+
+// ========== DISPATCH ========== //
+
+// Detects best supported instruction set once
+FilterIsa activeFilterIsa() {
+#if FILTER_HAS_X86
+    static const FilterIsa detected = __builtin_cpu_supports("avx2") ? FilterIsa::AVX2
+                                    : __builtin_cpu_supports("sse2") ? FilterIsa::SSE2
+                                    : FilterIsa::Scalar;
+    return detected;
+#else
+    return FilterIsa::Scalar;
+#endif
+}
+
+// Returns display name of an instruction set
+const char* filterIsaName(FilterIsa isa) {
+    switch (isa) {
+        case FilterIsa::AVX2: return "AVX2";
+        case FilterIsa::SSE2: return "SSE2";
+        default:              return "Scalar";
+    }
+}
+
+// Range filter entry point
+void filterRangeI32(const int32_t* values, size_t rows, int32_t lo, int32_t hi,
+                    uint64_t* bits, FilterIsa isa) {
+#if FILTER_HAS_X86
+    if (isa == FilterIsa::AVX2) { rangeAVX2(values, rows, lo, hi, bits); return; }
+    if (isa == FilterIsa::SSE2) { rangeSSE2(values, rows, lo, hi, bits); return; }
+#endif
+    rangeScalar(values, rows, lo, hi, bits);
+}
+
+// Equality filter entry point
+void filterEqualsU16(const uint16_t* codes, size_t rows, uint16_t code,
+                     uint64_t* bits, FilterIsa isa) {
+#if FILTER_HAS_X86
+    if (isa == FilterIsa::AVX2) { equalsAVX2(codes, rows, code, bits); return; }
+    if (isa == FilterIsa::SSE2) { equalsSSE2(codes, rows, code, bits); return; }
+#endif
+    equalsScalar(codes, rows, code, bits);
+}
+
+// Intersects dst with src
+void bitmapAnd(uint64_t* dst, const uint64_t* src, size_t words) {
+    for (size_t w = 0; w < words; w++) {
+        dst[w] &= src[w];  // Compiler auto-vectorises this loop
+    }
+}
+
+// Appends ids[i] for every set bit i
+void collectSelected(const uint64_t* bits, size_t rows, const int32_t* ids, vector<int>& out) {
+    for (size_t w = 0; w < bitmapWords(rows); w++) {
+        uint64_t word = bits[w];
+        if (w * 64 + 64 > rows) {
+            word &= (1ULL << (rows % 64)) - 1;  // Ignore bits past the last row
+        }
+        while (word) {
+            int bit = __builtin_ctzll(word);  // Lowest set bit
+            out.push_back(ids[w * 64 + bit]);
+            word &= word - 1;                 // Clear it
+        }
+    }
+}
+
+// ========== BENCHMARK ========== //
+
+// Times one kernel run and prints throughput
+template <typename Kernel>
+static double timeKernel(const char* label, FilterIsa isa, size_t rows, Kernel kernel) {
+    auto start = chrono::steady_clock::now();
+    kernel(isa);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << left << setw(14) << label << setw(8) << filterIsaName(isa) << right
+         << setw(12) << fixed << setprecision(2) << seconds * 1000 << " ms"
+         << setw(14) << (rows / seconds) / 1e6 << " Mrows/s\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6) << left;
+    return seconds;
+}
+
+// Compares scalar and vector kernel throughput on generated columns
+void runFilterBenchmark(size_t rows) {
+    cout << "\nGenerating " << rows << " rows ("
+         << rows * (sizeof(int32_t) + sizeof(uint16_t)) / (1024 * 1024) << " MB of columns)...\n";
+    vector<int32_t> ages(rows);
+    vector<uint16_t> bloodGroups(rows);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < rows; i++) {
+        seed = seed * 1664525u + 1013904223u;  // Linear congruential generator
+        ages[i] = static_cast<int32_t>((seed >> 8) % 100);
+        bloodGroups[i] = static_cast<uint16_t>((seed >> 20) % 8);
+    }
+    SelectionBitmap bits(bitmapWords(rows));
+
+    vector<FilterIsa> isas = { FilterIsa::Scalar };
+    if (activeFilterIsa() != FilterIsa::Scalar) isas.push_back(FilterIsa::SSE2);
+    if (activeFilterIsa() == FilterIsa::AVX2) isas.push_back(FilterIsa::AVX2);
+
+    cout << "\n=== FILTER KERNEL THROUGHPUT ===\n";
+    double scalarRange = 0, scalarEquals = 0;
+    for (FilterIsa isa : isas) {
+        double range = timeKernel("age 60-120", isa, rows, [&](FilterIsa k) {
+            filterRangeI32(ages.data(), rows, 60, 120, bits.data(), k);
+        });
+        double equals = timeKernel("blood == 7", isa, rows, [&](FilterIsa k) {
+            filterEqualsU16(bloodGroups.data(), rows, 7, bits.data(), k);
+        });
+        if (isa == FilterIsa::Scalar) {
+            scalarRange = range;
+            scalarEquals = equals;
+        } else {
+            cout << "  speedup vs scalar: range " << scalarRange / range
+                 << "x, equality " << scalarEquals / equals << "x\n";
+        }
+    }
+    cout << right;
+}
@@ -0,0 +1,43 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <vector>    // For bitmap storage
+#include <cstdint>   // For fixed-width column types
+#include <cstddef>   // For size_t
+using namespace std;
+
+// Instruction sets the filter kernels can run on
+enum class FilterIsa {
+    Scalar,  // Portable C++ loop
+    SSE2,    // 128-bit vectors
+    AVX2     // 256-bit vectors
+};
+
+// Best instruction set supported by this CPU (detected once at first call)
+FilterIsa activeFilterIsa();
+
+// Returns display name of an instruction set
+const char* filterIsaName(FilterIsa isa);
+
+// Selection bitmap: bit i is set when row i matches
+typedef vector<uint64_t> SelectionBitmap;
+
+// Number of 64-bit words needed for a bitmap over n rows
+inline size_t bitmapWords(size_t rows) { return (rows + 63) / 64; }
+
+// Sets bits for rows whose value lies in [lo, hi]
+void filterRangeI32(const int32_t* values, size_t rows, int32_t lo, int32_t hi,
+                    uint64_t* bits, FilterIsa isa = activeFilterIsa());
+
+// Sets bits for rows whose dictionary code equals code
+void filterEqualsU16(const uint16_t* codes, size_t rows, uint16_t code,
+                     uint64_t* bits, FilterIsa isa = activeFilterIsa());
+
+// Intersects dst with src (dst &= src)
+void bitmapAnd(uint64_t* dst, const uint64_t* src, size_t words);
+
+// Appends ids[i] for every set bit i
+void collectSelected(const uint64_t* bits, size_t rows, const int32_t* ids, vector<int>& out);
+
+// Compares scalar and vector kernel throughput on generated columns
+void runFilterBenchmark(size_t rows);
@@ -0,0 +1,264 @@
+#include "snapshot.h"  // Snapshot declarations
+#include <iostream>    // For benchmark output
+#include <iomanip>     // For formatted figures
+#include <chrono>      // For latency
+#include <random>      // For generated writes
+#include <thread>      // For reader threads
+#include <mutex>       // For the locked baseline
+#include <vector>      // For benchmark rows
+#include <algorithm>   // For sorting latencies
+
+// ========== EPOCH MANAGER IMPLEMENTATION ========== //
+
+// Constructor marks every reader slot free
+EpochManager::EpochManager() {
+    for (auto& slot : pinned) slot.store(NOT_PINNED);
+}
+
+// Frees versions still waiting
+EpochManager::~EpochManager() { drain(); }
+
+// Opens a write; nested writes share one timestamp
+uint64_t EpochManager::beginWrite() {
+    if (writeDepth++ == 0) pending = clock.load() + 1;
+    return pending;
+}
+
+// The outermost call publishes every version of the write at once
+void EpochManager::endWrite() {
+    if (writeDepth == 0 || --writeDepth > 0) return;
+    clock.store(pending);
+    pending = 0;
+    reclaim();
+}
+
+// Queues a superseded version; the list stays in commit order
+void EpochManager::retire(uint64_t supersededAt, void (*release)(void*, void*), void* newer, void* old) {
+    retired.push_back({ supersededAt, release, newer, old });
+    peakRetired = max(peakRetired, retired.size());
+}
+
+// Frees every version superseded at or before the oldest reader's start
+size_t EpochManager::reclaim() {
+    if (retired.empty()) return 0;
+    uint64_t oldest = min(clock.load(), oldestReader());
+    size_t freed = 0;
+    while (!retired.empty() && retired.front().supersededAt <= oldest) {
+        const Retired& entry = retired.front();
+        entry.release(entry.newer, entry.old);
+        retired.pop_front();
+        freed++;
+    }
+    reclaimedCount += freed;
+    return freed;
+}
+
+// Frees everything regardless of readers
+void EpochManager::drain() {
+    for (const auto& entry : retired) entry.release(entry.newer, entry.old);
+    reclaimedCount += retired.size();
+    retired.clear();
+}
+
+// Claims a free slot and pins the current timestamp. The clock is re-read after
+// pinning: if a commit slipped in between, the writer may already have freed a
+// version this timestamp needs, so the reader pins the newer time instead.
+size_t EpochManager::pin(uint64_t& timestamp) {
+    for (;;) {
+        for (size_t slot = 0; slot < MAX_READERS; slot++) {
+            uint64_t expected = NOT_PINNED;
+            timestamp = clock.load();
+            if (!pinned[slot].compare_exchange_strong(expected, timestamp)) continue;
+            while (clock.load() != timestamp) {
+                timestamp = clock.load();
+                pinned[slot].store(timestamp);
+            }
+            return slot;
+        }
+        this_thread::yield();  // Every slot is taken; wait for a reader to finish
+    }
+}
+
+// Releases a reader slot
+void EpochManager::unpin(size_t slot) { pinned[slot].store(NOT_PINNED); }
+
+// Last committed timestamp
+uint64_t EpochManager::now() const { return clock.load(); }
+
+// Readers holding a snapshot
+size_t EpochManager::activeReaders() const {
+    size_t count = 0;
+    for (const auto& slot : pinned) count += slot.load() != NOT_PINNED;
+    return count;
+}
+
+// Start timestamp of the oldest reader
+uint64_t EpochManager::oldestReader() const {
+    uint64_t oldest = NOT_PINNED;
+    for (const auto& slot : pinned) oldest = min(oldest, slot.load());
+    return oldest;
+}
+
+// Superseded versions not yet freed
+size_t EpochManager::retainedVersions() const { return retired.size(); }
+
+// Versions freed so far
+size_t EpochManager::reclaimedVersions() const { return reclaimedCount; }
+
+// Most versions waiting at once
+size_t EpochManager::peakRetainedVersions() const { return peakRetired; }
+
+// ========== BENCHMARK ========== //
+
+// One stock level; transfers between rows keep the total constant
+struct StockRow {
+    int id;
+    int quantity;
+};
+
+// Writer throughput and latency for one reader configuration
+struct WriterFigures {
+    double seconds = 0;
+    double p50 = 0, p99 = 0, worst = 0;  // Microseconds per write
+    size_t scans = 0;                    // Full reads completed by readers
+    size_t inconsistent = 0;             // Reads whose total was wrong
+};
+
+// Sorts latencies and fills the percentiles
+static void summarize(vector<float>& latencies, WriterFigures& figures) {
+    if (latencies.empty()) return;
+    sort(latencies.begin(), latencies.end());
+    figures.p50 = latencies[latencies.size() / 2];
+    figures.p99 = latencies[latencies.size() * 99 / 100];
+    figures.worst = latencies.back();
+}
+
+// Prints one result line
+static void printFigures(const string& label, size_t writes, const WriterFigures& figures) {
+    cout << left << setw(20) << label << right << fixed << setprecision(0)
+         << setw(12) << writes / max(figures.seconds, 1e-9)
+         << setprecision(2) << setw(9) << figures.p50 << setw(9) << figures.p99 << setw(10) << figures.worst
+         << setw(10) << figures.scans << setw(14) << figures.inconsistent << "\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6) << left;
+}
+
+// Moves stock between random rows; readers check that every view sums to the
+// starting total, which only holds if both halves of a transfer appear together
+void runSnapshotBenchmark(size_t rows, size_t writes, unsigned readers) {
+    rows = max<size_t>(rows, 2);
+    const int startQuantity = 1000;
+    const long long expected = static_cast<long long>(rows) * startQuantity;
+
+    // Snapshot readers (and the writer-only baseline)
+    auto runVersioned = [&](unsigned readerCount) {
+        EpochManager epochs;
+        VersionedTable<StockRow> table(epochs);
+        vector<StockRow> live(rows);
+        for (size_t i = 0; i < rows; i++) {
+            live[i] = { static_cast<int>(i + 1), startQuantity };
+            table.insert(live[i]);
+        }
+        WriterFigures figures;
+        atomic<bool> done{false};
+        atomic<size_t> scans{0}, inconsistent{0};
+        vector<thread> threads;
+        for (unsigned r = 0; r < readerCount; r++) {
+            threads.emplace_back([&]() {
+                while (!done.load()) {
+                    ReadSnapshot snapshot(epochs);
+                    long long total = 0;
+                    table.forEachAt(snapshot.getTimestamp(), [&total](const StockRow& row) { total += row.quantity; });
+                    scans++;
+                    if (total != expected) inconsistent++;
+                }
+            });
+        }
+        mt19937 generator(2024);
+        vector<float> latencies;
+        latencies.reserve(writes);
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < writes; i++) {
+            auto opStart = chrono::steady_clock::now();
+            size_t from = generator() % rows, to = generator() % rows;
+            int units = 1 + static_cast<int>(generator() % 5);
+            live[from].quantity -= units;
+            live[to].quantity += units;
+            epochs.beginWrite();  // Both rows commit together
+            table.update(static_cast<uint32_t>(from), live[from]);
+            table.update(static_cast<uint32_t>(to), live[to]);
+            epochs.endWrite();
+            latencies.push_back(chrono::duration<float, micro>(chrono::steady_clock::now() - opStart).count());
+        }
+        figures.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        done = true;
+        for (auto& t : threads) t.join();
+        figures.scans = scans;
+        figures.inconsistent = inconsistent;
+        summarize(latencies, figures);
+        if (readerCount) {
+            cout << "(" << epochs.reclaimedVersions() << " versions reclaimed, at most "
+                 << epochs.peakRetainedVersions() << " waiting for readers)\n";
+        }
+        return figures;
+    };
+
+    // Readers lock the table for the whole scan; the writer locks per transfer
+    auto runLocked = [&](unsigned readerCount) {
+        vector<StockRow> live(rows);
+        for (size_t i = 0; i < rows; i++) live[i] = { static_cast<int>(i + 1), startQuantity };
+        mutex tableLock;
+        WriterFigures figures;
+        atomic<bool> done{false};
+        atomic<size_t> scans{0}, inconsistent{0};
+        vector<thread> threads;
+        for (unsigned r = 0; r < readerCount; r++) {
+            threads.emplace_back([&]() {
+                while (!done.load()) {
+                    long long total = 0;
+                    {
+                        lock_guard<mutex> guard(tableLock);
+                        for (const auto& row : live) total += row.quantity;
+                    }
+                    scans++;
+                    if (total != expected) inconsistent++;
+                }
+            });
+        }
+        mt19937 generator(2024);
+        vector<float> latencies;
+        latencies.reserve(writes);
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < writes; i++) {
+            auto opStart = chrono::steady_clock::now();
+            size_t from = generator() % rows, to = generator() % rows;
+            int units = 1 + static_cast<int>(generator() % 5);
+            {
+                lock_guard<mutex> guard(tableLock);
+                live[from].quantity -= units;
+                live[to].quantity += units;
+            }
+            latencies.push_back(chrono::duration<float, micro>(chrono::steady_clock::now() - opStart).count());
+        }
+        figures.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        done = true;
+        for (auto& t : threads) t.join();
+        figures.scans = scans;
+        figures.inconsistent = inconsistent;
+        summarize(latencies, figures);
+        return figures;
+    };
+
+    cout << "\n" << rows << " rows, " << writes << " two-row transfers, " << readers << " reader thread(s) on "
+         << thread::hardware_concurrency() << " hardware thread(s)\n";
+    WriterFigures alone = runVersioned(0);
+    WriterFigures snapshot = runVersioned(readers);
+    WriterFigures locked = runLocked(readers);
+    cout << "\n" << left << setw(20) << "Readers" << right << setw(12) << "Writes/s" << setw(9) << "p50 us"
+         << setw(9) << "p99 us" << setw(10) << "max us" << setw(10) << "Scans" << setw(14) << "Inconsistent" << "\n";
+    printFigures("None", writes, alone);
+    printFigures("Snapshot", writes, snapshot);
+    printFigures("Locked", writes, locked);
+    cout << right;
+    if (snapshot.inconsistent) cout << "WARNING: snapshot readers saw partial transfers!\n";
+}
@@ -0,0 +1,217 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <atomic>    // For lock-free publication
+#include <deque>     // For the retire list
+#include <cstdint>   // For timestamps
+#include <cstddef>   // For size_t
+using namespace std;
+
+// Commit clock and epoch-based reclamation for multi-version tables.
+// Every committed write advances the clock. A reader pins the clock value it
+// started at and sees exactly the writes committed up to then; a superseded
+// version is freed only once every pinned reader started after the write that
+// replaced it. Writes are serialized by the caller (one writer at a time);
+// readers never block and never take a lock.
+class EpochManager {
+public:
+    static const size_t MAX_READERS = 64;        // Snapshots open at the same time
+    static const uint64_t NOT_PINNED = UINT64_MAX;
+
+private:
+    // Superseded version waiting for older readers to finish
+    struct Retired {
+        uint64_t supersededAt;             // Commit that replaced it
+        void (*release)(void*, void*);     // Unlinks and frees it
+        void* newer;                       // Version that replaced it
+        void* old;                         // Version to free
+    };
+
+    atomic<uint64_t> clock{0};                 // Last committed timestamp
+    atomic<uint64_t> pinned[MAX_READERS];      // Start timestamp per reader slot
+    deque<Retired> retired;                    // Oldest first (writer only)
+    uint64_t pending = 0;                      // Timestamp of the open write
+    int writeDepth = 0;                        // Nested beginWrite calls
+
+    // Statistics (writer only)
+    size_t reclaimedCount = 0;   // Versions freed
+    size_t peakRetired = 0;      // Most versions waiting at once
+
+public:
+    EpochManager();
+    EpochManager(const EpochManager&) = delete;             // Owns retired versions
+    EpochManager& operator=(const EpochManager&) = delete;
+    ~EpochManager();
+
+    // Opens a write (nested calls join it); returns the timestamp it commits at
+    uint64_t beginWrite();
+
+    // Closes a write; the outermost call commits and reclaims
+    void endWrite();
+
+    // Hands a superseded version over for freeing once no reader needs it
+    void retire(uint64_t supersededAt, void (*release)(void*, void*), void* newer, void* old);
+
+    // Frees versions no pinned reader can reach; returns how many
+    size_t reclaim();
+
+    // Frees every retired version (only when no reader is active)
+    void drain();
+
+    // Reader side: claims a slot and the timestamp to read at
+    size_t pin(uint64_t& timestamp);
+    void unpin(size_t slot);
+
+    // Accessor methods
+    uint64_t now() const;            // Last committed timestamp
+    size_t activeReaders() const;
+    uint64_t oldestReader() const;   // NOT_PINNED if none
+    size_t retainedVersions() const; // Superseded versions not yet freed
+    size_t reclaimedVersions() const;
+    size_t peakRetainedVersions() const;
+};
+
+// Read-only point-in-time view; pins its timestamp until destroyed
+class ReadSnapshot {
+private:
+    EpochManager& epochs;  // Clock the snapshot was taken from
+    size_t slot;           // Reader slot held
+    uint64_t timestamp;    // Writes committed up to here are visible
+
+public:
+    explicit ReadSnapshot(EpochManager& epochs) : epochs(epochs) { slot = epochs.pin(timestamp); }
+    ReadSnapshot(const ReadSnapshot&) = delete;             // Holds a reader slot
+    ReadSnapshot& operator=(const ReadSnapshot&) = delete;
+    ~ReadSnapshot() { epochs.unpin(slot); }
+
+    uint64_t getTimestamp() const { return timestamp; }
+};
+
+// Append-only table of rows, each a chain of immutable versions (newest first).
+// The writer publishes a full copy of a row on every change; readers walk each
+// chain to the newest version committed at their snapshot timestamp. Row heads
+// live in chunks that double in size and never move, so readers can scan while
+// the writer appends.
+template <typename T>
+class VersionedTable {
+private:
+    struct Version {
+        T value;                 // Row contents at this commit
+        uint64_t committed;      // Commit timestamp
+        atomic<Version*> older;  // Previous version (nullptr once freed)
+
+        Version(const T& value, uint64_t committed, Version* older)
+            : value(value), committed(committed), older(older) {}
+    };
+
+    static const size_t FIRST_CHUNK = 64;  // Rows in chunk 0; chunk k holds FIRST_CHUNK << k
+    static const size_t CHUNKS = 32;
+
+    EpochManager& epochs;                         // Clock and reclamation
+    atomic<atomic<Version*>*> chunks[CHUNKS];     // Row heads
+    atomic<size_t> rows{0};                       // Rows published to readers
+
+    // Chunk and offset of a row
+    static void locate(size_t row, size_t& chunk, size_t& offset) {
+        size_t block = row / FIRST_CHUNK + 1;
+        chunk = 0;
+        while ((size_t(2) << chunk) <= block) chunk++;
+        offset = row - FIRST_CHUNK * ((size_t(1) << chunk) - 1);
+    }
+
+    // Head pointer of a row
+    atomic<Version*>& headAt(size_t row) const {
+        size_t chunk, offset;
+        locate(row, chunk, offset);
+        return chunks[chunk].load()[offset];
+    }
+
+    // Called by the epoch manager once no reader can reach the old version
+    static void releaseVersion(void* newer, void* old) {
+        static_cast<Version*>(newer)->older.store(nullptr);
+        delete static_cast<Version*>(old);
+    }
+
+public:
+    explicit VersionedTable(EpochManager& epochs) : epochs(epochs) {
+        for (auto& chunk : chunks) chunk.store(nullptr);
+    }
+    VersionedTable(const VersionedTable&) = delete;             // Owns its versions
+    VersionedTable& operator=(const VersionedTable&) = delete;
+    ~VersionedTable() { clear(); }
+
+    // Appends a row; returns its row number
+    uint32_t insert(const T& value) {
+        uint64_t timestamp = epochs.beginWrite();
+        size_t row = rows.load(), chunk, offset;
+        locate(row, chunk, offset);
+        if (!chunks[chunk].load()) {
+            size_t size = FIRST_CHUNK << chunk;
+            atomic<Version*>* heads = new atomic<Version*>[size];
+            for (size_t i = 0; i < size; i++) heads[i].store(nullptr);
+            chunks[chunk].store(heads);
+        }
+        chunks[chunk].load()[offset].store(new Version(value, timestamp, nullptr));
+        rows.store(row + 1);  // Readers whose snapshot predates the commit skip it
+        epochs.endWrite();
+        return static_cast<uint32_t>(row);
+    }
+
+    // Publishes a new version of a row
+    void update(uint32_t row, const T& value) {
+        uint64_t timestamp = epochs.beginWrite();
+        atomic<Version*>& head = headAt(row);
+        Version* old = head.load();
+        Version* newer = new Version(value, timestamp, old);
+        head.store(newer);
+        if (old) epochs.retire(timestamp, &VersionedTable::releaseVersion, newer, old);
+        epochs.endWrite();
+    }
+
+    // Visits the version of every row visible at the timestamp, in insertion order
+    template <typename Visitor>
+    void forEachAt(uint64_t timestamp, Visitor visit) const {
+        size_t count = rows.load();
+        for (size_t row = 0; row < count; row++) {
+            const Version* version = headAt(row).load();
+            while (version && version->committed > timestamp) version = version->older.load();
+            if (version) visit(version->value);
+        }
+    }
+
+    // Frees every row and version (only when no reader is active)
+    void clear() {
+        epochs.drain();  // Unlinks superseded versions first, so each is freed once
+        for (size_t chunk = 0; chunk < CHUNKS; chunk++) {
+            atomic<Version*>* heads = chunks[chunk].load();
+            if (!heads) continue;
+            size_t size = FIRST_CHUNK << chunk;
+            for (size_t i = 0; i < size; i++) delete heads[i].load();
+            delete[] heads;
+            chunks[chunk].store(nullptr);
+        }
+        rows.store(0);
+    }
+
+    // Rows published
+    size_t size() const { return rows.load(); }
+
+    // Heap bytes held by row heads and current versions (writer side only);
+    // superseded versions are counted by the epoch manager
+    size_t memoryUsage() const {
+        size_t bytes = 0;
+        for (size_t chunk = 0; chunk < CHUNKS; chunk++) {
+            if (chunks[chunk].load()) bytes += (FIRST_CHUNK << chunk) * sizeof(atomic<Version*>);
+        }
+        size_t count = rows.load();
+        for (size_t row = 0; row < count; row++) {
+            const Version* version = headAt(row).load();
+            if (version) bytes += sizeof(Version) - sizeof(T) + version->value.memoryUsage();
+        }
+        return bytes;
+    }
+};
+
+// Measures writer throughput and latency with concurrent full-table readers,
+// comparing snapshot reads with readers holding a lock
+void runSnapshotBenchmark(size_t rows, size_t writes, unsigned readers);
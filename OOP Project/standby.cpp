@@ -0,0 +1,268 @@
+#include "hospital.h"  // Includes the main hospital system header
+#include "workload.h"  // For generated patients and a quiet console
+#include <iomanip>     // For formatted figures
+#include <chrono>      // For lag and promote timing
+#include <thread>      // For the applier thread
+#include <mutex>       // For the shared replication figures
+#include <atomic>      // For stop flags
+#include <algorithm>   // For sorting lags
+#include <filesystem>  // For truncating and removing logs
+
+// ========== HELPERS ========== //
+
+// Figures shared between the applier thread and the console
+struct ReplicationProgress {
+    mutex lock;                 // Guards everything below
+    size_t applied = 0;         // Mutations replayed
+    size_t skipped = 0;         // Mutations whose target did not exist
+    uint64_t lastSequence = 0;  // Last sequence number replayed
+    int64_t lastLag = 0;        // Microseconds from commit to replay
+    int64_t maxLag = 0;
+    double totalLag = 0;
+    vector<int64_t> lags;       // Every lag (benchmark only)
+    bool keepLags = false;
+};
+
+// Replays a batch and records how far behind the primary each change was
+static void applyBatch(HospitalSystem& hospital, vector<Mutation>& batch, ReplicationProgress& progress) {
+    for (const auto& mutation : batch) {
+        bool ok = hospital.applyMutation(mutation);
+        int64_t lag = max<int64_t>(wallClockMicros() - mutation.committedAt, 0);
+        lock_guard<mutex> guard(progress.lock);
+        ok ? progress.applied++ : progress.skipped++;
+        progress.lastSequence = mutation.sequence;
+        progress.lastLag = lag;
+        progress.maxLag = max(progress.maxLag, lag);
+        progress.totalLag += static_cast<double>(lag);
+        if (progress.keepLags) progress.lags.push_back(lag);
+    }
+    batch.clear();
+}
+
+// Polls the log until told to stop, sleeping briefly when there is nothing new
+static void followLog(HospitalSystem& hospital, LogFollower& follower, ReplicationProgress& progress,
+                      atomic<bool>& stop) {
+    vector<Mutation> batch;
+    unsigned idle = 0;
+    while (!stop.load()) {
+        if (follower.poll(batch)) {
+            applyBatch(hospital, batch, progress);
+            idle = 0;
+        } else {
+            this_thread::sleep_for(chrono::milliseconds(idle++ < 100 ? 1 : 5));
+        }
+    }
+}
+
+// ========== STANDBY ========== //
+
+// Follows the primary's log with a background thread. The console keeps the
+// original output buffer while cout is silenced for the replayed changes.
+bool runStandby(HospitalSystem& hospital, const string& logPath) {
+    ostream console(cout.rdbuf());
+    console << "\nStandby: waiting for primary log " << logPath << "...\n";
+    LogFollower follower;
+    auto waitStart = chrono::steady_clock::now();
+    while (!follower.open(logPath)) {
+        if (chrono::steady_clock::now() - waitStart > chrono::seconds(30)) {
+            console << "Error: no replication log found at " << logPath << "\n";
+            return false;
+        }
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+
+    ConsoleSilencer quiet;
+    ReplicationProgress progress;
+    atomic<bool> stop{false};
+    thread applier(followLog, ref(hospital), ref(follower), ref(progress), ref(stop));
+
+    bool promoted = false;
+    int choice;
+    do {
+        console << "\n========== STANDBY (" << logPath << ") ==========\n";
+        console << "1. Replication Status\n";
+        console << "2. Promote to Primary (stop the primary first)\n";
+        console << "0. Exit\n";
+        console << "Enter your choice: ";
+        if (!(cin >> choice)) choice = 0;
+        cin.ignore();
+
+        switch (choice) {
+            case 1: {
+                lock_guard<mutex> guard(progress.lock);
+                size_t replayed = progress.applied + progress.skipped;
+                console << "\nApplied: " << progress.applied << " (" << progress.skipped << " skipped), up to sequence "
+                        << progress.lastSequence << "\n";
+                console << fixed << setprecision(2);
+                console << "Lag: last " << progress.lastLag / 1000.0 << " ms, average "
+                        << (replayed ? progress.totalLag / replayed / 1000.0 : 0.0) << " ms, worst "
+                        << progress.maxLag / 1000.0 << " ms\n";
+                console.unsetf(ios::floatfield);
+                console << "Log bytes not yet read: " << follower.bytesBehind() << "\n";
+                if (follower.isDamaged()) {
+                    console << "WARNING: the log failed its checksum or was restarted; replication stopped.\n";
+                }
+                break;
+            }
+            case 2: {
+                auto start = chrono::steady_clock::now();
+                stop = true;
+                applier.join();
+                vector<Mutation> batch;
+                follower.poll(batch);  // Anything written before the primary stopped
+                applyBatch(hospital, batch, progress);
+
+                // A frame the primary died writing is cut off, so new frames follow a valid one
+                error_code error;
+                filesystem::resize_file(logPath, follower.validBytes(), error);
+                if (error || !hospital.resumeShipping(logPath, progress.lastSequence)) {
+                    console << "\nWarning: could not reopen " << logPath << "; changes will not be shipped.\n";
+                }
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                quiet.restore();
+                console << "\nPromoted to primary in " << fixed << setprecision(1) << seconds * 1000 << " ms after "
+                        << progress.applied << " changes (last sequence " << progress.lastSequence << ").\n";
+                console.unsetf(ios::floatfield);
+                promoted = true;
+                break;
+            }
+            case 0:
+                break;
+            default:
+                console << "\nInvalid choice!\n";
+        }
+    } while (choice != 0 && !promoted);
+
+    if (!promoted) {
+        stop = true;
+        applier.join();
+        quiet.restore();
+    }
+    return promoted;
+}
+
+// ========== BENCHMARK ========== //
+
+// Primary and standby run in this process on one log file. Setup registers
+// patients, medicines and bills; the paced load then only changes existing
+// entities, because both systems share the entity ID counters.
+void runReplicationBenchmark(size_t mutations, size_t ratePerSecond) {
+    const string logPath = "replication_benchmark.log";
+    const int patients = 200, medicineCount = 20;
+    PopulationBuilder people(2024);
+    auto pick = [&people](size_t n) { return people.pick(n); };
+
+    HospitalSystem primary, standby;
+    if (!primary.startShipping(logPath)) {
+        cout << "\nError: could not create " << logPath << "\n";
+        return;
+    }
+    vector<int> medicineIds;
+    vector<Billing*> primaryBills;
+    {
+        ConsoleSilencer quiet;
+        for (Medicine* medicine : people.addMedicines(primary, medicineCount, 1000000)) {
+            medicineIds.push_back(medicine->getId());
+        }
+        for (int i = 0; i < patients; i++) {
+            int id = 10000 + i;
+            primary.addPatient(primary.newPatient(people.patient(id, 1)));
+            Billing* bill;
+            primary.createBill(id, bill);
+            primaryBills.push_back(bill);
+        }
+    }
+    uint64_t setupRecords = primary.getReplicationLog().lastSequence();
+
+    // Standby replays the setup backlog first
+    LogFollower follower;
+    follower.open(logPath);
+    ReplicationProgress progress;
+    atomic<bool> stop{false};
+    ConsoleSilencer quiet;
+    auto start = chrono::steady_clock::now();
+    thread applier(followLog, ref(standby), ref(follower), ref(progress), ref(stop));
+    auto caughtUp = [&progress](uint64_t sequence) {
+        lock_guard<mutex> guard(progress.lock);
+        return progress.lastSequence >= sequence;
+    };
+    while (!caughtUp(setupRecords)) this_thread::sleep_for(chrono::microseconds(200));
+    double catchUpSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    {
+        lock_guard<mutex> guard(progress.lock);
+        progress.keepLags = true;
+    }
+
+    // Paced load: stock movements, charges, contact changes and new conditions
+    static const char* conditions[] = { "Hypertension", "Asthma", "Migraine", "Type 2 diabetes" };
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < mutations; i++) {
+        if (ratePerSecond) {
+            this_thread::sleep_until(start + chrono::microseconds(static_cast<int64_t>(i * 1000000 / ratePerSecond)));
+        }
+        size_t kind = pick(4);
+        if (kind == 0) {
+            Medicine* medicine;
+            primary.findMedicine(medicineIds[pick(medicineIds.size())], medicine);
+            primary.updateStock(medicine, static_cast<int>(pick(20)) - 10);
+        } else if (kind == 1) {
+            primary.addServiceToBill(primaryBills[pick(primaryBills.size())], "Consultation", 25.0 + pick(100));
+        } else {
+            Patient* patient;
+            primary.findPatient(10000 + static_cast<int>(pick(patients)), patient);
+            if (kind == 2) {
+                primary.updateContactInfo(patient, people.address(), people.phone());
+            } else {
+                primary.addDisease(patient, conditions[pick(4)]);
+            }
+        }
+    }
+    double loadSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    uint64_t lastRecord = primary.getReplicationLog().lastSequence();
+    while (!caughtUp(lastRecord)) this_thread::sleep_for(chrono::microseconds(200));
+    double drainSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() - loadSeconds;
+    stop = true;
+    applier.join();
+    quiet.restore();
+
+    // Both sides must agree on stock and bill totals
+    long long primaryStock = 0, standbyStock = 0;
+    for (int id : medicineIds) {
+        Medicine *a, *b;
+        primary.findMedicine(id, a);
+        standby.findMedicine(id, b);
+        primaryStock += a ? a->getQuantity() : 0;
+        standbyStock += b ? b->getQuantity() : 0;
+    }
+    double primaryTotal = 0, standbyTotal = 0;
+    for (int i = 0; i < patients; i++) {
+        Billing *a, *b;
+        primary.findPatientBill(10000 + i, a);
+        standby.findPatientBill(10000 + i, b);
+        primaryTotal += a ? a->getTotalAmount() : 0;
+        standbyTotal += b ? b->getTotalAmount() : 0;
+    }
+
+    vector<int64_t>& lags = progress.lags;
+    sort(lags.begin(), lags.end());
+    auto percentile = [&lags](size_t p) { return lags.empty() ? 0.0 : lags[lags.size() * p / 100] / 1000.0; };
+    cout << "\n" << setupRecords << " setup changes replayed in " << fixed << setprecision(1)
+         << catchUpSeconds * 1000 << " ms; log " << primary.getReplicationLog().bytesWritten() << " bytes\n";
+    cout << mutations << " changes in " << loadSeconds * 1000 << " ms ("
+         << setprecision(0) << mutations / max(loadSeconds, 1e-9) << " per second, target "
+         << (ratePerSecond ? to_string(ratePerSecond) : string("unlimited")) << ")\n";
+    cout << setprecision(3) << "Replication lag: p50 " << percentile(50) << " ms, p99 " << percentile(99)
+         << " ms, max " << (lags.empty() ? 0.0 : lags.back() / 1000.0) << " ms; standby caught up "
+         << drainSeconds * 1000 << " ms after the last change\n";
+    cout << setprecision(2) << "Stock: " << primaryStock << " / " << standbyStock << "   Bill totals: $"
+         << primaryTotal << " / $" << standbyTotal << "   Skipped: " << progress.skipped << "\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+    if (primaryStock != standbyStock || primaryTotal != standbyTotal || progress.skipped) {
+        cout << "WARNING: the standby does not match the primary!\n";
+    }
+
+    primary.stopShipping();
+    error_code error;
+    filesystem::remove(logPath, error);
+}
@@ -0,0 +1,285 @@
+#include "text_index.h"  // Text index declarations
+#include "memory.h"      // For footprint helpers
+#include "varint.h"      // For posting compression
+#include <cctype>        // For character classification
+#include <algorithm>     // For binary_search
+
+// ========== HELPERS ========== //
+
+// Retired posting bytes below which a compaction pass is not worth making
+static const size_t MIN_COMPACT_BYTES = 64 * 1024;
+
+// Key identifying an indexed source: the kind in the high 32 bits, the source ID
+// in the low 32. Record and appointment IDs are unique system-wide and the
+// condition list uses the patient ID, so the pair names one source.
+static uint64_t sourceKey(TextSourceKind kind, int sourceId) {
+    return (static_cast<uint64_t>(static_cast<unsigned char>(kind)) << 32) |
+           static_cast<uint32_t>(sourceId);
+}
+
+// Splits text into lowercase alphanumeric tokens
+void tokenize(const string& text, vector<string>& tokens) {
+    string token;
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (isalnum(uc)) {
+            token += static_cast<char>(tolower(uc));
+        } else if (!token.empty()) {
+            tokens.push_back(token);
+            token.clear();
+        }
+    }
+    if (!token.empty()) tokens.push_back(token);
+}
+
+// ========== INDEXING ========== //
+
+// Indexes (or re-indexes) the text of one source
+void TextIndex::indexText(int patientId, TextSourceKind kind, int sourceId, const vector<string>& fields) {
+    // Retire the previous version of this source
+    uint64_t key = sourceKey(kind, sourceId);
+    auto previous = currentDocument.find(key);
+    if (previous != currentDocument.end()) {
+        liveDocuments.remove(previous->second);
+        liveBytes -= documentBytes[previous->second];
+        retiredBytes += documentBytes[previous->second];
+    }
+
+    uint32_t doc = static_cast<uint32_t>(documents.size());
+    documents.push_back({ patientId, kind, sourceId });
+    currentDocument[key] = doc;
+    liveDocuments.add(doc);
+
+    // Gather positions per term; a gap between fields stops phrases spanning them
+    unordered_map<string, vector<uint32_t>> positions;
+    uint32_t position = 0;
+    vector<string> tokens;
+    for (const auto& field : fields) {
+        tokens.clear();
+        tokenize(field, tokens);
+        for (const auto& token : tokens) positions[token].push_back(position++);
+        position++;  // Field boundary
+    }
+
+    // Append one entry per term
+    size_t added = 0;
+    for (const auto& entry : positions) {
+        PostingList& list = terms[entry.first];
+        size_t before = list.bytes.size();
+        writeVarint(list.bytes, doc - list.lastDoc);
+        writeVarint(list.bytes, static_cast<uint32_t>(entry.second.size()));
+        uint32_t last = 0;
+        for (uint32_t pos : entry.second) {
+            writeVarint(list.bytes, pos - last);
+            last = pos;
+        }
+        list.lastDoc = doc;
+        list.docCount++;
+        added += list.bytes.size() - before;
+    }
+    documentBytes.push_back(static_cast<uint32_t>(added));
+    liveBytes += added;
+
+    if (retiredBytes > liveBytes && retiredBytes >= MIN_COMPACT_BYTES) compact();
+}
+
+// Rewrites every posting list without retired documents. Live documents keep
+// their order, so renumbering them keeps the deltas positive and the position
+// bytes are copied unchanged.
+void TextIndex::compact() {
+    vector<int> live;
+    liveDocuments.toVector(live);
+    vector<uint32_t> renumbered(documents.size(), UINT32_MAX);  // Old -> new document (MAX = retired)
+    vector<TextHit> liveSources;
+    vector<uint32_t> liveSizes;
+    liveSources.reserve(live.size());
+    liveSizes.reserve(live.size());
+    for (int doc : live) {
+        renumbered[doc] = static_cast<uint32_t>(liveSources.size());
+        liveSources.push_back(documents[doc]);
+        liveSizes.push_back(documentBytes[doc]);
+    }
+
+    liveBytes = 0;
+    for (auto it = terms.begin(); it != terms.end();) {
+        const vector<uint8_t>& bytes = it->second.bytes;
+        PostingList rewritten;
+        size_t pos = 0;
+        uint32_t doc = 0;
+        while (pos < bytes.size()) {
+            doc += static_cast<uint32_t>(readVarint(bytes, pos));
+            uint32_t count = static_cast<uint32_t>(readVarint(bytes, pos));
+            size_t positionsStart = pos;
+            for (uint32_t i = 0; i < count; i++) readVarint(bytes, pos);
+            if (renumbered[doc] == UINT32_MAX) continue;  // Retired
+            writeVarint(rewritten.bytes, renumbered[doc] - rewritten.lastDoc);
+            writeVarint(rewritten.bytes, count);
+            rewritten.bytes.insert(rewritten.bytes.end(), bytes.begin() + positionsStart, bytes.begin() + pos);
+            rewritten.lastDoc = renumbered[doc];
+            rewritten.docCount++;
+        }
+        if (rewritten.docCount == 0) {
+            it = terms.erase(it);  // Term only appeared in retired documents
+            continue;
+        }
+        rewritten.bytes.shrink_to_fit();
+        liveBytes += rewritten.bytes.size();
+        it->second = move(rewritten);
+        ++it;
+    }
+
+    for (auto& entry : currentDocument) entry.second = renumbered[entry.second];
+    documents = move(liveSources);
+    documentBytes = move(liveSizes);  // Approximate now that deltas were re-encoded
+    liveDocuments = RoaringBitmap();
+    for (uint32_t doc = 0; doc < documents.size(); doc++) liveDocuments.add(doc);
+    retiredBytes = 0;
+}
+
+// ========== QUERYING ========== //
+
+// Decodes the positions of the wanted documents; others are skipped over
+void TextIndex::decode(const PostingList& list, const RoaringBitmap& wanted,
+                       unordered_map<uint32_t, vector<uint32_t>>& out) const {
+    size_t pos = 0;
+    uint32_t doc = 0;
+    while (pos < list.bytes.size()) {
+        doc += static_cast<uint32_t>(readVarint(list.bytes, pos));
+        uint32_t count = static_cast<uint32_t>(readVarint(list.bytes, pos));
+        if (!wanted.contains(doc)) {
+            for (uint32_t i = 0; i < count; i++) readVarint(list.bytes, pos);
+            continue;
+        }
+        vector<uint32_t>& positions = out[doc];
+        uint32_t last = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            last += static_cast<uint32_t>(readVarint(list.bytes, pos));
+            positions.push_back(last);
+        }
+    }
+}
+
+// Live documents containing a term (positions are skipped, not materialised)
+RoaringBitmap TextIndex::termDocuments(const string& term) const {
+    RoaringBitmap docs;
+    auto it = terms.find(term);
+    if (it == terms.end()) return docs;
+    const vector<uint8_t>& bytes = it->second.bytes;
+    size_t pos = 0;
+    uint32_t doc = 0;
+    while (pos < bytes.size()) {
+        doc += static_cast<uint32_t>(readVarint(bytes, pos));
+        uint32_t count = static_cast<uint32_t>(readVarint(bytes, pos));
+        for (uint32_t i = 0; i < count; i++) readVarint(bytes, pos);
+        if (liveDocuments.contains(doc)) docs.add(doc);
+    }
+    return docs;
+}
+
+// Documents containing the tokens consecutively
+RoaringBitmap TextIndex::phraseDocuments(const vector<string>& phrase) const {
+    RoaringBitmap result;
+    if (phrase.empty()) return result;
+
+    // Candidate documents contain every token
+    RoaringBitmap candidates = termDocuments(phrase[0]);
+    for (size_t i = 1; i < phrase.size(); i++) candidates = candidates & termDocuments(phrase[i]);
+    if (candidates.cardinality() == 0) return result;
+
+    vector<unordered_map<uint32_t, vector<uint32_t>>> positions(phrase.size());
+    for (size_t i = 0; i < phrase.size(); i++) decode(terms.at(phrase[i]), candidates, positions[i]);
+
+    vector<int> docs;
+    candidates.toVector(docs);
+    for (int doc : docs) {
+        for (uint32_t start : positions[0][doc]) {
+            bool match = true;
+            for (size_t i = 1; i < phrase.size() && match; i++) {
+                const vector<uint32_t>& next = positions[i][doc];
+                match = binary_search(next.begin(), next.end(), start + static_cast<uint32_t>(i));
+            }
+            if (match) {
+                result.add(static_cast<uint32_t>(doc));
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+// Evaluates a boolean query left to right
+bool TextIndex::search(const string& query, vector<TextHit>& hits) const {
+    // Split into words and quoted phrases
+    vector<pair<string, bool>> words;  // (text, was quoted)
+    string word;
+    bool quoted = false;
+    for (char c : query + " ") {
+        if (c == '"') {
+            if (quoted || !word.empty()) words.push_back({ word, quoted });
+            word.clear();
+            quoted = !quoted;
+        } else if (c == ' ' && !quoted) {
+            if (!word.empty()) words.push_back({ word, false });
+            word.clear();
+        } else {
+            word += c;
+        }
+    }
+    if (quoted) return false;  // Unterminated phrase
+
+    RoaringBitmap result;
+    bool haveResult = false, negate = false;
+    string op = "AND";  // Adjacent operands are ANDed
+    bool expectOperand = true;
+    for (const auto& w : words) {
+        if (!w.second && (w.first == "AND" || w.first == "OR")) {
+            if (expectOperand) return false;  // Operator without a preceding operand
+            op = w.first;
+            expectOperand = true;
+            continue;
+        }
+        if (!w.second && w.first == "NOT") {
+            negate = !negate;
+            continue;
+        }
+
+        vector<string> tokens;
+        tokenize(w.first, tokens);
+        if (tokens.empty()) continue;  // Punctuation only
+        RoaringBitmap operand = tokens.size() == 1 ? termDocuments(tokens[0]) : phraseDocuments(tokens);
+        if (negate) operand = liveDocuments.andNot(operand);
+
+        if (!haveResult) result = operand;
+        else if (op == "OR") result = result | operand;
+        else result = result & operand;
+        haveResult = true;
+        negate = false;
+        op = "AND";
+        expectOperand = false;
+    }
+    if (!haveResult || expectOperand || negate) return false;  // Empty query or dangling operator
+
+    vector<int> docs;
+    (result & liveDocuments).toVector(docs);  // Superseded versions never match
+    for (int doc : docs) hits.push_back(documents[doc]);
+    return true;
+}
+
+// Number of live documents
+size_t TextIndex::documentCount() const { return liveDocuments.cardinality(); }
+
+// Number of distinct terms
+size_t TextIndex::termCount() const { return terms.size(); }
+
+// Heap bytes used by the index
+size_t TextIndex::memoryUsage() const {
+    size_t bytes = terms.bucket_count() * sizeof(void*) + vectorBufferBytes(documents) +
+                   vectorBufferBytes(documentBytes) + liveDocuments.memoryUsage() +
+                   currentDocument.bucket_count() * sizeof(void*) +
+                   currentDocument.size() * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(void*));
+    for (const auto& entry : terms) {
+        bytes += sizeof(entry) + sizeof(void*) + stringHeapBytes(entry.first) +
+                 vectorBufferBytes(entry.second.bytes);
+    }
+    return bytes;
+}
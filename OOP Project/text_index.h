@@ -0,0 +1,79 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>         // For terms and queries
+#include <vector>         // For posting storage
+#include <unordered_map>  // For term dictionary
+#include <cstdint>        // For fixed-width types
+#include "bitmap_index.h" // For document sets
+using namespace std;
+
+// Kinds of clinical text that are indexed
+enum class TextSourceKind : char {
+    Record = 'R',       // Medical record: diagnosis, treatment plan, test reports
+    Appointment = 'A',  // Appointment diagnosis notes
+    Diseases = 'D'      // Patient's list of known conditions
+};
+
+// One search result: the text source that matched
+struct TextHit {
+    int patientId;        // Patient the text belongs to
+    TextSourceKind kind;  // What kind of text matched
+    int sourceId;         // Record/appointment ID (patient ID for diseases)
+};
+
+// Splits text into lowercase alphanumeric tokens
+void tokenize(const string& text, vector<string>& tokens);
+
+// Incremental inverted index over clinical text.
+// Every indexed source is a document; re-indexing a source appends a new document
+// and retires the old one, so posting lists are append-only with increasing
+// document numbers and can be stored as varint-compressed deltas. Once retired
+// documents hold more posting bytes than live ones, every list is rewritten
+// without them.
+class TextIndex {
+private:
+    // Compressed postings for one term: per document
+    // [doc delta][position count][position deltas...] as varints
+    struct PostingList {
+        vector<uint8_t> bytes;    // Encoded postings
+        uint32_t lastDoc = 0;     // Last document appended (base for next delta)
+        uint32_t docCount = 0;    // Documents containing the term (including retired)
+    };
+
+    unordered_map<string, PostingList> terms;         // Term dictionary
+    vector<TextHit> documents;                        // Document number -> source
+    vector<uint32_t> documentBytes;                   // Document number -> posting bytes it added
+    RoaringBitmap liveDocuments;                      // Documents not yet superseded
+    unordered_map<uint64_t, uint32_t> currentDocument; // Source key -> live document
+    size_t liveBytes = 0;                             // Posting bytes of live documents
+    size_t retiredBytes = 0;                          // Posting bytes of superseded documents
+
+    // Rewrites every posting list without retired documents and renumbers the rest
+    void compact();
+
+    // Decodes the positions of the wanted documents in a posting list
+    void decode(const PostingList& list, const RoaringBitmap& wanted,
+                unordered_map<uint32_t, vector<uint32_t>>& out) const;
+
+    // Documents containing a term
+    RoaringBitmap termDocuments(const string& term) const;
+
+    // Documents containing the tokens consecutively
+    RoaringBitmap phraseDocuments(const vector<string>& phrase) const;
+
+public:
+    // Indexes (or re-indexes) the text of one source; fields are not phrase-adjacent
+    void indexText(int patientId, TextSourceKind kind, int sourceId, const vector<string>& fields);
+
+    // Evaluates a query such as: pneumonia AND NOT covid, "chest pain" OR fever
+    // (adjacent operands are ANDed). Returns false if the query is malformed.
+    bool search(const string& query, vector<TextHit>& hits) const;
+
+    // Accessor methods
+    size_t documentCount() const;
+    size_t termCount() const;
+
+    // Heap bytes used by the index
+    size_t memoryUsage() const;
+};
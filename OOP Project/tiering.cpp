@@ -0,0 +1,267 @@
+#include "hospital.h"  // Includes the main hospital system header
+#include "workload.h"  // For generated patients and a quiet console
+#include <iomanip>     // For formatted figures
+#include <chrono>      // For load and unload latency
+#include <algorithm>   // For max
+
+// ========== PATIENT TIER IMPLEMENTATION ========== //
+
+// Starts tiering with segment files in the given directory
+bool PatientTier::open(const string& directory, size_t residentPatients) {
+    if (!segments.open(directory)) return false;
+    capacity = max<size_t>(residentPatients, 1);  // The patient being accessed always stays
+    nextSegment = 1;
+    managed = 0;
+    hits = misses = spills = cleanSpills = failures = 0;
+    faultSeconds = spillSeconds = 0;
+    return true;
+}
+
+// Stops tiering and deletes the segment files
+void PatientTier::close() {
+    segments.close();
+    resident.clear();
+    unordered_map<const Patient*, list<const Patient*>::iterator>().swap(positions);
+    capacity = 0;
+    managed = 0;
+}
+
+// Changes how many patients stay resident
+void PatientTier::setCapacity(size_t residentPatients) {
+    capacity = max<size_t>(residentPatients, 1);
+    evict();
+}
+
+// Starts managing a patient whose collections are loaded
+void PatientTier::attach(Patient* patient) {
+    patient->setTier(this, nextSegment++);
+    managed++;
+    resident.push_front(patient);
+    positions[patient] = resident.begin();
+    evict();
+}
+
+// Loads a patient's collections and stops managing it
+void PatientTier::detach(Patient* patient) {
+    if (patient->getSegmentHeader().segment == 0) return;  // Not attached
+    touch(patient);
+    auto it = positions.find(patient);
+    if (it != positions.end()) {
+        resident.erase(it->second);
+        positions.erase(it);
+    }
+    segments.erase(patient->getSegmentHeader().segment);
+    patient->setTier(nullptr, 0);
+    managed--;
+}
+
+// Records an access; an unloaded patient is read back and becomes most recent
+void PatientTier::touch(const Patient* patient) {
+    auto it = positions.find(patient);
+    if (it != positions.end()) {
+        hits++;
+        resident.splice(resident.begin(), resident, it->second);  // Most recently used first
+        return;
+    }
+    const SegmentHeader& header = patient->getSegmentHeader();
+    if (header.loaded) return;  // Not managed by this tier
+
+    auto start = chrono::steady_clock::now();
+    vector<uint8_t> blob;
+    if (!segments.read(header.segment, blob)) {
+        failures++;
+        cout << "\nError: could not read stored records of patient #" << patient->getId() << "\n";
+        return;
+    }
+    patient->loadCollections(blob);  // The segment stays, so an unchanged patient unloads for free
+    misses++;
+    resident.push_front(patient);
+    positions[patient] = resident.begin();
+    faultSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    evict();
+}
+
+// Unloads least recently used patients until within capacity
+void PatientTier::evict() {
+    size_t candidates = resident.size();  // Each patient is considered at most once
+    while (resident.size() > capacity && candidates-- > 0) {
+        const Patient* victim = resident.back();
+        if (victim->getRoomId() != -1) {  // Admitted patients stay resident
+            resident.splice(resident.begin(), resident, prev(resident.end()));
+            continue;
+        }
+        if (!spill(victim)) break;  // Keeps the patient in memory rather than losing data
+        resident.pop_back();
+        positions.erase(victim);
+    }
+}
+
+// Writes the segment if the collections changed since loading, then releases them
+bool PatientTier::spill(const Patient* patient) {
+    auto start = chrono::steady_clock::now();
+    const SegmentHeader& header = patient->getSegmentHeader();
+    if (header.dirty) {
+        vector<uint8_t> blob;
+        patient->writeCollections(blob);
+        if (!segments.write(header.segment, blob)) {
+            failures++;
+            return false;
+        }
+        patient->markSegmentWritten();
+    } else {
+        cleanSpills++;
+    }
+    patient->unloadCollections();
+    spills++;
+    spillSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// True while segment files are in use
+bool PatientTier::isEnabled() const { return segments.isOpen(); }
+
+// Patients whose collections stay resident
+size_t PatientTier::getCapacity() const { return capacity; }
+
+// Patients currently loaded
+size_t PatientTier::residentCount() const { return resident.size(); }
+
+// Patients whose collections are only on disk
+size_t PatientTier::unloadedCount() const { return managed - resident.size(); }
+
+// Fraction of accesses served without reading a segment
+double PatientTier::hitRate() const {
+    return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0;
+}
+
+// Heap bytes used by the LRU (nothing is kept per unloaded patient)
+size_t PatientTier::memoryUsage() const {
+    return resident.size() * (sizeof(const Patient*) + 2 * sizeof(void*)) +
+           positions.bucket_count() * sizeof(void*) +
+           positions.size() * (sizeof(pair<const Patient* const, list<const Patient*>::iterator>) + sizeof(void*));
+}
+
+// Displays residency, hit rate and I/O figures
+void PatientTier::displayReport() const {
+    cout << "\n=== TIERED PATIENT STORAGE ===\n";
+    if (!isEnabled()) {
+        cout << "Tiered storage is off (every patient is resident).\n";
+        return;
+    }
+    cout << fixed << setprecision(2);
+    cout << "Resident patients:  " << residentCount() << " (capacity " << capacity << ")\n";
+    cout << "On disk only:       " << unloadedCount() << "\n";
+    cout << "Accesses:           " << hits + misses << " (" << hits << " hits, " << misses << " loads)\n";
+    cout << "Hit rate:           " << hitRate() * 100 << "%\n";
+    if (misses) cout << "Average load:       " << faultSeconds * 1e6 / misses << " us\n";
+    cout << "Unloads:            " << spills << " (" << cleanSpills << " without a write";
+    if (spills) cout << ", average " << spillSeconds * 1e6 / spills << " us";
+    cout << ")\n";
+    cout << "Segment files:      " << segments.segmentCount() << " in " << segments.getDirectory() << "/ ("
+         << segments.bytesOnDisk() << " bytes)\n";
+    if (segments.compressedBytes()) {
+        cout << "Compression:        " << static_cast<double>(segments.uncompressedBytes()) /
+                                          segments.compressedBytes() << "x\n";
+    }
+    cout << "Tier bookkeeping:   " << memoryUsage() << " bytes in memory\n";
+    if (failures) cout << "I/O errors:         " << failures << "\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// ========== BENCHMARK ========== //
+
+// Bytes held by patients and their collections
+static size_t residentPatientBytes(const vector<Patient*>& patients) {
+    MemoryReport report;
+    for (const auto* patient : patients) patient->reportMemory(report);
+    return report.totalBytes();
+}
+
+// Runs generated patients through a small resident set and reports hit rate and memory
+void runTieredStorageBenchmark(size_t patients, size_t residentPatients) {
+    static const char* diagnoses[] = { "Hypertension", "Type 2 diabetes", "Asthma", "Migraine",
+                                       "Community acquired pneumonia", "Iron deficiency anaemia" };
+    static const char* plans[] = { "Lifestyle advice and review in three months",
+                                   "Start metformin 500mg twice daily, recheck HbA1c",
+                                   "Inhaled corticosteroid, spacer technique reviewed",
+                                   "Amoxicillin 500mg three times daily for seven days" };
+    PopulationBuilder people(2024);
+    auto pick = [&people](size_t n) { return people.pick(n); };
+
+    cout << "\nGenerating " << patients << " patients with appointments, prescriptions and records...\n";
+    ConsoleSilencer quiet;
+    ObjectPool<Patient> pool;
+    vector<Patient*> all;
+    vector<int> firstRecord;
+    all.reserve(patients);
+    firstRecord.reserve(patients);
+    for (size_t i = 0; i < patients; i++) {
+        Patient* patient = pool.create(people.patient(static_cast<int>(i + 1), 1));
+        patient->scheduleAppointment(1, "01/0" + to_string(1 + pick(9)) + "/2025 10:00");
+        patient->scheduleAppointment(2, "15/0" + to_string(1 + pick(9)) + "/2025 14:30");
+        patient->addPrescription(1);
+        int recordId = patient->addMedicalRecord(1, diagnoses[pick(6)], plans[pick(4)]);
+        patient->addMedicalRecord(2, diagnoses[pick(6)], plans[pick(4)]);
+        MedicalRecord* record;
+        patient->getMedicalRecord(recordId, record);
+        record->addTestResult("Full blood count within normal limits");
+        patient->markCollectionsChanged();
+        all.push_back(patient);
+        firstRecord.push_back(recordId);
+    }
+    quiet.restore();
+    size_t before = residentPatientBytes(all);
+
+    PatientTier tier;
+    if (!tier.open("tiered_benchmark_segments", residentPatients)) {
+        cout << "Error: could not create the segment directory.\n";
+        return;
+    }
+    auto start = chrono::steady_clock::now();
+    for (auto* patient : all) tier.attach(patient);
+    double spillSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t after = residentPatientBytes(all) + tier.memoryUsage();
+    cout << "Resident: " << before << " bytes before, " << after << " bytes with "
+         << tier.getCapacity() << " resident patients (" << fixed << setprecision(2)
+         << static_cast<double>(before) / after << "x smaller); segments written in "
+         << spillSeconds * 1000 << " ms\n";
+
+    // Profile views read only the fixed-size header
+    size_t records = 0;
+    start = chrono::steady_clock::now();
+    for (const auto* patient : all) records += patient->getSegmentHeader().recordCount;
+    double headerSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Profile summaries of all patients (" << records << " records counted) in "
+         << headerSeconds * 1000 << " ms without loading any segment\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+
+    // Most accesses go to the patients currently in the building, the rest anywhere;
+    // one in ten changes the patient, the rest only read
+    size_t active = max<size_t>(1, tier.getCapacity() * 4 / 5);
+    if (active > patients) active = patients;
+    size_t accesses = max<size_t>(100000, patients / 10), mismatches = 0;
+    ConsoleSilencer accessQuiet;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < accesses && patients; i++) {
+        size_t row = pick(10) ? pick(active) : pick(patients);
+        if (pick(10) == 0) {
+            MedicalRecord* record;
+            all[row]->getMedicalRecord(firstRecord[row], record);
+            mismatches += !record || record->getPatientId() != all[row]->getId();
+            all[row]->markCollectionsChanged();  // Counts as a write: the segment is rewritten on eviction
+        } else {
+            all[row]->displayAppointments();
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    accessQuiet.restore();
+    cout << accesses << " accesses (90% to " << active << " active patients, 10% writes) in "
+         << seconds * 1000 << " ms\n";
+    tier.displayReport();
+    if (mismatches) cout << "WARNING: " << mismatches << " records did not round-trip!\n";
+
+    for (auto* patient : all) patient->setTier(nullptr, 0);
+    tier.close();  // Deletes the segment files
+}
@@ -1,9 +1,20 @@
 #include "hospital.h"  // Main hospital system header
+#include "commands.h"  // Menu changes as undoable commands
+#include "simd_filter.h" // For filter kernel benchmark
+#include <chrono>      // For timing diagnostics
+#include <thread>      // For hardware thread count
+#include <algorithm>   // For max
 
 // ========== UTILITY FUNCTIONS ========== //
 
+static bool screenClearing = true;  // Off while a recorded session is replayed
+
+// Turns screen clearing on or off
+void setScreenClearing(bool enabled) { screenClearing = enabled; }
+
 // Clears console screen (cross-platform)
 void clearScreen() {
+    if (!screenClearing) return;
     #ifdef _WIN32
         system("cls");  // Windows command
     #else
@@ -28,8 +39,26 @@ void pressEnterToContinue() {
 
 // ========== CREATION FUNCTIONS ========== //
 
+// Reads a line for a field with a fixed format, asking again until it is accepted
+string readField(const string& prompt, bool (*isValid)(string_view), const string& rule) {
+    string value;
+    cout << prompt;
+    while (getline(cin, value) && !isValid(value)) {
+        cout << "Invalid entry (" << rule << "). " << prompt;
+    }
+    return value;
+}
+
+// Rules shown when a field is rejected
+static const string GENDER_RULE = "letters, up to 15";
+static const string CONTACT_RULE = "at least 3 digits, with + - ( ) . x allowed, up to 22 characters";
+static const string BLOOD_GROUP_RULE = "A+, A-, B+, B-, AB+, AB-, O+ or O-";
+static const string LICENSE_RULE = "letters, digits, - and /, up to 15";
+static const string SHIFT_RULE = "up to 15 characters, e.g. Night or 08:00-16:00";
+const string DATE_TIME_RULE = "a real date as DD/MM/YYYY HH:MM, from 1970";
+
 // Creates new patient with user input
-void createPatient(Patient*& patient) {
+void createPatient(HospitalSystem& hospital, Patient*& patient) {
     displayHeader("REGISTER NEW PATIENT");
     
     // Declare all needed variables
@@ -48,27 +77,24 @@ void createPatient(Patient*& patient) {
     cin >> age;
     cin.ignore();
     
-    cout << "Enter Gender: ";
-    getline(cin, gender);
+    gender = readField("Enter Gender: ", Person::isValidGender, GENDER_RULE);
     
     cout << "Enter Address: ";
     getline(cin, address);
     
-    cout << "Enter Contact Number: ";
-    getline(cin, contact);
+    contact = readField("Enter Contact Number: ", Person::isValidContactNumber, CONTACT_RULE);
     
-    cout << "Enter Blood Group: ";
-    getline(cin, bloodGroup);
+    bloodGroup = readField("Enter Blood Group: ", Patient::isValidBloodGroup, BLOOD_GROUP_RULE);
     
     cout << "Enter Assigned Doctor ID: ";
     cin >> doctorId;
     
     // Create new Patient object
-    patient = new Patient(id, name, age, gender, address, contact, bloodGroup, doctorId);
+    patient = hospital.newPatient(id, name, age, gender, address, contact, bloodGroup, doctorId);
 }
 
 // Creates new doctor with user input
-void createDoctor(Doctor*& doctor) {
+void createDoctor(HospitalSystem& hospital, Doctor*& doctor) {
     displayHeader("REGISTER NEW DOCTOR");
     
     int id, age;
@@ -83,8 +109,7 @@ void createDoctor(Doctor*& doctor) {
     cout << "Enter Full Name: ";
     getline(cin, name);
     
-    cout << "Enter Gender: ";
-    getline(cin, gender);
+    gender = readField("Enter Gender: ", Person::isValidGender, GENDER_RULE);
 
     cout << "Enter Department: ";
     getline(cin, department);
@@ -99,23 +124,20 @@ void createDoctor(Doctor*& doctor) {
     cout << "Enter Specialization: ";
     getline(cin, specialization);
 
-    cout << "Enter Licience Number: ";
-    cin >> license;
-    cin.ignore();
+    license = readField("Enter Licience Number: ", Doctor::isValidLicenseNumber, LICENSE_RULE);
 
     cout << "Enter Address: ";
     getline(cin, address);
     
-    cout << "Enter Contact Number: ";
-    getline(cin, contact);
+    contact = readField("Enter Contact Number: ", Person::isValidContactNumber, CONTACT_RULE);
 
     
-    doctor = new Doctor(id, name, age, gender, address, contact, salary, department, 
+    doctor = hospital.newDoctor(id, name, age, gender, address, contact, salary, department, 
                        joinDate, specialization, license);
 }
 
 // Creates new nurse with user input
-void createNurse(Nurse*& nurse) {
+void createNurse(HospitalSystem& hospital, Nurse*& nurse) {
     displayHeader("REGISTER NEW NURSE");
     
     int id, age;
@@ -130,8 +152,7 @@ void createNurse(Nurse*& nurse) {
     cout << "Enter Full Name: ";
     getline(cin, name);
     
-    cout << "Enter Gender: ";
-    getline(cin, gender);
+    gender = readField("Enter Gender: ", Person::isValidGender, GENDER_RULE);
 
     cout << "Enter Department: ";
     getline(cin, department);
@@ -143,8 +164,7 @@ void createNurse(Nurse*& nurse) {
     cin >> salary;
     cin.ignore();
 
-    cout << "Enter Shift Time: ";
-    getline(cin, shift);
+    shift = readField("Enter Shift Time: ", Nurse::isValidShiftTime, SHIFT_RULE);
 
     cout << "Enter Qualification: ";
     getline(cin, qualification);
@@ -152,15 +172,14 @@ void createNurse(Nurse*& nurse) {
     cout << "Enter Address: ";
     getline(cin, address);
     
-    cout << "Enter Contact Number: ";
-    getline(cin, contact);
+    contact = readField("Enter Contact Number: ", Person::isValidContactNumber, CONTACT_RULE);
     
-    nurse = new Nurse(id, name, age, gender, address, contact, salary, department, 
+    nurse = hospital.newNurse(id, name, age, gender, address, contact, salary, department, 
                      joinDate, shift, qualification);
 }
 
 // Creates new medicine with user input
-void createMedicine(Medicine*& medicine) {
+void createMedicine(HospitalSystem& hospital, Medicine*& medicine) {
     displayHeader("ADD NEW MEDICINE");
     
     string name, expiry;
@@ -182,18 +201,18 @@ void createMedicine(Medicine*& medicine) {
     cout << "Enter Expiry (DD/MM/YYYY): ";
     getline(cin, expiry);
     
-    medicine = new Medicine(name, price, quantity, expiry);
+    medicine = hospital.newMedicine(name, price, quantity, expiry);
 }
 
 // Creates new room with user input
-void createRoom(Room*& room) {
+void createRoom(HospitalSystem& hospital, Room*& room) {
     displayHeader("ADD NEW ROOM");
     
     string type;
     cout << "Enter Room Type (General/ICU/Private): ";
     getline(cin, type);
     
-    room = new Room(type);
+    room = hospital.newRoom(type);
 }
 
 // ========== OPERATION FUNCTIONS ========== //
@@ -214,6 +233,8 @@ void patientOperations(HospitalSystem& hospital, Patient* patient) {
         cout << "7. View Details\n";
         cout << "8. Assign to Room\n";
         cout << "9. Discharge from Room\n";
+        cout << "10. Update Blood Group\n";
+        cout << "11. Find Compatible Blood Donors\n";
         cout << "0. Back to Main Menu\n";
         cout << "Enter your choice: ";
         cin >> choice;
@@ -225,9 +246,9 @@ void patientOperations(HospitalSystem& hospital, Patient* patient) {
                 string dateTime;
                 cout << "\nEnter Doctor ID: ";
                 cin >> doctorId;
-                cout << "Enter Date/Time (DD/MM/YYYY HH:MM): ";
-                getline(cin, dateTime);
-                patient->scheduleAppointment(doctorId, dateTime);
+                cin.ignore();
+                dateTime = readField("Enter Date/Time (DD/MM/YYYY HH:MM): ", isValidDateTime, DATE_TIME_RULE);
+                hospital.execute(make_unique<ScheduleAppointmentCommand>(patient, doctorId, dateTime));
                 break;
             }
             case 2:
@@ -243,7 +264,7 @@ void patientOperations(HospitalSystem& hospital, Patient* patient) {
                 string disease;
                 cout << "\nEnter Medical Condition: ";
                 getline(cin, disease);
-                patient->addDisease(disease);
+                hospital.execute(make_unique<AddDiseaseCommand>(patient, disease));
                 break;
             }
             case 6: {
@@ -252,7 +273,7 @@ void patientOperations(HospitalSystem& hospital, Patient* patient) {
                 getline(cin, address);
                 cout << "Enter New Contact Number: ";
                 getline(cin, contact);
-                patient->updateContactInfo(address, contact);
+                hospital.execute(make_unique<UpdateContactCommand>(patient, address, contact));
                 break;
             }
             case 7:
@@ -266,8 +287,7 @@ void patientOperations(HospitalSystem& hospital, Patient* patient) {
                 Room* room;
                 hospital.findAvailableRoom(type, room);
                 if (room) {
-                    room->assignPatient(patient->getId());
-                    patient->assignRoom(room->getId());
+                    hospital.execute(make_unique<AssignRoomCommand>(patient, room));
                 } else {
                     cout << "\nNo available " << type << " rooms found!\n";
                 }
@@ -275,17 +295,38 @@ void patientOperations(HospitalSystem& hospital, Patient* patient) {
             }
             case 9: {
                 if (patient->getRoomId() != -1) {
-                    Room* room;
-                    hospital.findRoom(patient->getRoomId(), room);
-                    if (room) {
-                        room->vacateRoom();
-                    }
-                    patient->dischargeFromRoom();
+                    hospital.execute(make_unique<DischargeCommand>(patient));
                 } else {
                     cout << "\nPatient is not assigned to any room!\n";
                 }
                 break;
             }
+            case 10: {
+                string bloodGroup;
+                cout << "\nEnter Blood Group: ";
+                getline(cin, bloodGroup);
+                hospital.execute(make_unique<UpdateBloodGroupCommand>(patient, bloodGroup));
+                break;
+            }
+            case 11: {
+                if (bloodGroupCode(patient->getBloodGroup()) < 0) {
+                    cout << "\nUnrecognised blood group: " << patient->getBloodGroup() << "\n";
+                    break;
+                }
+                vector<Patient*> donors;
+                auto start = chrono::steady_clock::now();
+                hospital.findCompatibleDonors(patient, 10, donors);
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                
+                cout << "\n" << donors.size() << " compatible donor(s) for "
+                     << bloodGroupName(bloodGroupCode(patient->getBloodGroup())) << " in " << ms << " ms\n";
+                for (const auto& donor : donors) {
+                    cout << "- ID " << donor->getId() << ": " << donor->getName() << " ("
+                         << donor->getBloodGroup() << (donor->getRoomId() == -1 ? ", available" : ", admitted")
+                         << ")\n";
+                }
+                break;
+            }
             case 0:
                 return;
             default:
@@ -295,7 +336,7 @@ void patientOperations(HospitalSystem& hospital, Patient* patient) {
     } while (choice != 0);
 }
 // Handles all doctor-related operations
-void doctorOperations(Doctor* doctor) {
+void doctorOperations(HospitalSystem& hospital, Doctor* doctor) {
     displayHeader("DOCTOR OPERATIONS");
     
     int choice;
@@ -308,6 +349,9 @@ void doctorOperations(Doctor* doctor) {
         cout << "5. Create Medical Record\n";
         cout << "6. Update Contact Info\n";
         cout << "7. View Details\n";
+        cout << "8. Add Test Result\n";
+        cout << "9. Update Treatment Plan\n";
+        cout << "10. View Treatment Plan History\n";
         cout << "0. Back to Main Menu\n";
         cout << "Enter your choice: ";
         cin >> choice;
@@ -318,7 +362,7 @@ void doctorOperations(Doctor* doctor) {
                 string slot;
                 cout << "\nEnter Available Time Slot (e.g., Monday 9:00 AM): ";
                 getline(cin, slot);
-                doctor->addAvailableSlot(slot);
+                hospital.execute(make_unique<AddSlotCommand>(doctor, slot));
                 break;
             }
             case 2:
@@ -332,7 +376,7 @@ void doctorOperations(Doctor* doctor) {
                 cin.ignore();
                 cout << "Enter Diagnosis Notes: ";
                 getline(cin, notes);
-                doctor->completeAppointment(apptId, notes);
+                hospital.execute(make_unique<CompleteAppointmentCommand>(doctor, apptId, notes));
                 break;
             }
             case 4: {
@@ -358,7 +402,14 @@ void doctorOperations(Doctor* doctor) {
                 getline(cin, diagnosis);
                 cout << "Enter Treatment Plan: ";
                 getline(cin, plan);
-                doctor->addAppointment(patientId, "");
+                
+                Patient* patient;
+                hospital.findPatient(patientId, patient);
+                if (patient) {
+                    hospital.execute(make_unique<AddMedicalRecordCommand>(patient, doctor->getId(), diagnosis, plan));
+                } else {
+                    cout << "\nPatient not found!\n";
+                }
                 break;
             }
             case 6: {
@@ -367,12 +418,54 @@ void doctorOperations(Doctor* doctor) {
                 getline(cin, address);
                 cout << "Enter New Contact Number: ";
                 getline(cin, contact);
-                doctor->updateContactInfo(address, contact);
+                hospital.execute(make_unique<UpdateContactCommand>(doctor, address, contact));
                 break;
             }
             case 7:
                 doctor->displayDetails();
                 break;
+            case 8:
+            case 9: {
+                int patientId, recordId;
+                string text;
+                cout << "\nEnter Patient ID: ";
+                cin >> patientId;
+                cout << "Enter Record ID: ";
+                cin >> recordId;
+                cin.ignore();
+                cout << (choice == 8 ? "Enter Test Result: " : "Enter New Treatment Plan: ");
+                getline(cin, text);
+                
+                Patient* patient;
+                hospital.findPatient(patientId, patient);
+                if (!patient) {
+                    cout << "\nPatient not found!\n";
+                } else if (choice == 8) {
+                    hospital.execute(make_unique<AddTestResultCommand>(patient, recordId, text));
+                } else {
+                    hospital.execute(make_unique<UpdateTreatmentPlanCommand>(patient, recordId, text));
+                }
+                break;
+            }
+            case 10: {
+                int patientId, recordId;
+                cout << "\nEnter Patient ID: ";
+                cin >> patientId;
+                cout << "Enter Record ID: ";
+                cin >> recordId;
+                cin.ignore();
+                
+                Patient* patient;
+                hospital.findPatient(patientId, patient);
+                const MedicalRecord* record = nullptr;
+                if (patient) patient->findMedicalRecord(recordId, record);
+                if (record) {
+                    record->displayPlanHistory();
+                } else {
+                    cout << "\nMedical record not found!\n";
+                }
+                break;
+            }
             case 0:
                 return;
             default:
@@ -383,7 +476,7 @@ void doctorOperations(Doctor* doctor) {
 }
 
 // Handles all nurse-related operations
-void nurseOperations(Nurse* nurse) {
+void nurseOperations(HospitalSystem& hospital, Nurse* nurse) {
     displayHeader("NURSE OPERATIONS");
     
     int choice;
@@ -419,7 +512,7 @@ void nurseOperations(Nurse* nurse) {
                 getline(cin, address);
                 cout << "Enter New Contact Number: ";
                 getline(cin, contact);
-                nurse->updateContactInfo(address, contact);
+                hospital.execute(make_unique<UpdateContactCommand>(nurse, address, contact));
                 break;
             }
             case 4:
@@ -455,8 +548,8 @@ void inventoryOperations(HospitalSystem& hospital) {
         switch(choice) {
             case 1: {
                 Medicine* med;
-                createMedicine(med);
-                hospital.addMedicine(med);
+                createMedicine(hospital, med);
+                hospital.execute(make_unique<RegisterCommand>(med));
                 break;
             }
             case 2:
@@ -488,7 +581,7 @@ void inventoryOperations(HospitalSystem& hospital) {
                 Medicine* med;
                 hospital.findMedicine(id, med);
                 if (med) {
-                    med->updateStock(quantity);
+                    hospital.execute(make_unique<UpdateStockCommand>(med, quantity));
                 } else {
                     cout << "\nMedicine not found!\n";
                 }
@@ -496,8 +589,8 @@ void inventoryOperations(HospitalSystem& hospital) {
             }
             case 5: {
                 Room* room;
-                createRoom(room);
-                hospital.addRoom(room);
+                createRoom(hospital, room);
+                hospital.execute(make_unique<RegisterCommand>(room));
                 break;
             }
             case 6:
@@ -534,8 +627,7 @@ void billingOperations(HospitalSystem& hospital) {
                 int patientId;
                 cout << "\nEnter Patient ID: ";
                 cin >> patientId;
-                Billing* bill;
-                hospital.createBill(patientId, bill);
+                hospital.execute(make_unique<CreateBillCommand>(patientId));
                 break;
             }
             case 2: {
@@ -554,7 +646,7 @@ void billingOperations(HospitalSystem& hospital) {
                 Billing* bill;
                 hospital.findPatientBill(patientId, bill);
                 if (bill) {
-                    bill->addService(service, cost);
+                    hospital.execute(make_unique<AddServiceCommand>(bill, service, cost));
                 } else {
                     cout << "\nNo unpaid bill found for this patient!\n";
                 }
@@ -576,8 +668,7 @@ void billingOperations(HospitalSystem& hospital) {
                 
                 if (bill && med) {
                     med->checkAvailability(quantity);
-                    bill->addMedicine(medId, quantity, med->getPrice());
-                    med->updateStock(-quantity);
+                    hospital.execute(make_unique<AddMedicineToBillCommand>(bill, med, quantity));
                 } else {
                     cout << "\nBill or medicine not found!\n";
                 }
@@ -594,7 +685,7 @@ void billingOperations(HospitalSystem& hospital) {
                 Billing* bill;
                 hospital.findPatientBill(patientId, bill);
                 if (bill) {
-                    bill->processPayment(amount);
+                    hospital.execute(make_unique<ProcessPaymentCommand>(bill, amount));
                 } else {
                     cout << "\nNo unpaid bill found for this patient!\n";
                 }
@@ -610,4 +701,767 @@ void billingOperations(HospitalSystem& hospital) {
         }
         pressEnterToContinue();
     } while (choice != 0);
-}
\ No newline at end of file
+}
+// Handles system diagnostics and reports
+void diagnosticsOperations(HospitalSystem& hospital) {
+    displayHeader("SYSTEM DIAGNOSTICS");
+    
+    int choice;
+    do {
+        // Display menu options
+        cout << "\n1. Memory Usage Report\n";
+        cout << "2. Patient Population Query\n";
+        cout << "3. Staff Population Query\n";
+        cout << "4. Filter Kernel Benchmark\n";
+        cout << "5. Attribute Query (Bitmap Index)\n";
+        cout << "6. Clinical Text Search\n";
+        cout << "7. Name Search Benchmark\n";
+        cout << "8. Find Duplicate Patients\n";
+        cout << "9. Deduplication Benchmark\n";
+        cout << "10. Cold Clinical Text Compression\n";
+        cout << "11. Tiered Patient Storage\n";
+        cout << "12. Lookup Filters (Bloom)\n";
+        cout << "13. Report Snapshots\n";
+        cout << "14. Replication (Hot Standby)\n";
+        cout << "15. Checkpoints\n";
+        cout << "16. Concurrent Load Test\n";
+        cout << "17. Allocation Check (Separate Program)\n";
+        cout << "18. Bytes per Patient\n";
+        cout << "0. Back to Main Menu\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1:
+                hospital.displayMemoryReport();
+                break;
+            case 2:
+                populationQuery(hospital);
+                break;
+            case 3:
+                staffPopulationQuery(hospital);
+                break;
+            case 4: {
+                size_t rows;
+                cout << "\nNumber of rows (e.g. 100000000): ";
+                cin >> rows;
+                cout << "Active instruction set: " << filterIsaName(activeFilterIsa()) << "\n";
+                runFilterBenchmark(rows);
+                break;
+            }
+            case 5:
+                categoryQuery(hospital);
+                break;
+            case 6:
+                clinicalTextSearch(hospital);
+                break;
+            case 7: {
+                size_t rows;
+                cout << "\nNumber of names to generate (e.g. 1000000): ";
+                cin >> rows;
+                cin.ignore();
+                runNameSearchBenchmark(rows);
+                break;
+            }
+            case 8:
+                duplicateReport(hospital);
+                break;
+            case 9: {
+                size_t patients;
+                cout << "\nNumber of patients to generate (e.g. 2000000): ";
+                cin >> patients;
+                cin.ignore();
+                runDeduplicationBenchmark(patients, max(1u, thread::hardware_concurrency()));
+                break;
+            }
+            case 10:
+                coldTextOperations(hospital);
+                break;
+            case 11:
+                tieredStorageOperations(hospital);
+                break;
+            case 12:
+                lookupFilterOperations(hospital);
+                break;
+            case 13:
+                snapshotOperations(hospital);
+                break;
+            case 14:
+                replicationOperations(hospital);
+                break;
+            case 15:
+                checkpointOperations(hospital);
+                break;
+            case 16: {
+                LoadTestPlan plan;
+                static const char* roles[] = { "Front desk", "Doctor", "Pharmacy", "Cashier" };
+                cout << "\nPatients registered beforehand (e.g. 2000): ";
+                cin >> plan.patients;
+                for (int role = 0; role < 4; role++) {
+                    cout << roles[role] << " actors and operations/s each, 0 = flat out (e.g. "
+                         << plan.actors[role] << " " << plan.rates[role] << "): ";
+                    cin >> plan.actors[role] >> plan.rates[role];
+                }
+                cout << "Seconds to run (e.g. 5): ";
+                cin >> plan.seconds;
+                cin.ignore();
+                runLoadTest(plan);
+                break;
+            }
+            case 17:
+                // Counting every allocation means replacing operator new, which this program must not do
+                cout << "\nThe allocation check is its own program, so this one keeps the standard allocator.\n";
+                cout << "Build it with the build-alloc-check task and run: alloc_check <patients>\n";
+                cout << "It exits with status 1 if a lookup loop allocated.\n";
+                break;
+            case 18: {
+                size_t patients;
+                cout << "\nNumber of patients to generate per history depth (e.g. 20000): ";
+                cin >> patients;
+                cin.ignore();
+                runFootprintBenchmark(patients);
+                break;
+            }
+            case 0:
+                return;
+            default:
+                cout << "\nInvalid choice! Please try again.\n";
+        }
+        pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Prints query matches, listing only the first few IDs
+static void displayMatches(const string& kind, const vector<int>& ids, double ms) {
+    cout << "\n" << ids.size() << " matching " << kind << " in " << ms << " ms\n";
+    const size_t shown = 20;  // Avoids flooding the console on large populations
+    for (size_t i = 0; i < ids.size() && i < shown; i++) {
+        cout << "- ID " << ids[i] << "\n";
+    }
+    if (ids.size() > shown) {
+        cout << "... and " << ids.size() - shown << " more\n";
+    }
+}
+
+// Runs a population filter over the columnar patient store
+void populationQuery(HospitalSystem& hospital) {
+    displayHeader("PATIENT POPULATION QUERY");
+    
+    PatientFilter filter;
+    cout << "Blood Group (blank for any): ";
+    getline(cin, filter.bloodGroup);
+    cout << "Gender (blank for any): ";
+    getline(cin, filter.gender);
+    cout << "Minimum Age (-1 for none): ";
+    cin >> filter.minAge;
+    cout << "Maximum Age (-1 for none): ";
+    cin >> filter.maxAge;
+    cout << "Assigned Doctor ID (-1 for any): ";
+    cin >> filter.doctorId;
+    
+    vector<int> ids;
+    auto start = chrono::steady_clock::now();
+    hospital.queryPatients(filter, ids);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    
+    displayMatches("patient", ids, ms);
+}
+
+// Runs a population filter over the columnar staff store
+void staffPopulationQuery(HospitalSystem& hospital) {
+    displayHeader("STAFF POPULATION QUERY");
+    
+    StaffFilter filter;
+    string from, to;
+    cout << "Department (blank for any): ";
+    getline(cin, filter.department);
+    cout << "Gender (blank for any): ";
+    getline(cin, filter.gender);
+    cout << "Joined From (DD/MM/YYYY, blank for none): ";
+    getline(cin, from);
+    cout << "Joined To (DD/MM/YYYY, blank for none): ";
+    getline(cin, to);
+    cout << "Minimum Age (-1 for none): ";
+    cin >> filter.minAge;
+    cout << "Maximum Age (-1 for none): ";
+    cin >> filter.maxAge;
+    if (!from.empty()) filter.joinedFrom = dateToKey(from);
+    if (!to.empty()) filter.joinedTo = dateToKey(to);
+    
+    vector<int> ids;
+    auto start = chrono::steady_clock::now();
+    hospital.queryStaff(filter, ids);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    
+    displayMatches("staff", ids, ms);
+}
+
+// Answers blood group / gender / department combinations from the bitmap indexes
+void categoryQuery(HospitalSystem& hospital) {
+    displayHeader("ATTRIBUTE QUERY");
+    
+    string expression;
+    cout << "Fields: blood, gender, dept. Operators: AND, OR, NOT\n";
+    cout << "Example: blood=AB- AND NOT gender=Male\n\n";
+    cout << "Enter Query: ";
+    getline(cin, expression);
+    
+    vector<int> ids;
+    auto start = chrono::steady_clock::now();
+    bool valid = hospital.queryCategories(expression, ids);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    
+    if (!valid) {
+        cout << "\nInvalid query!\n";
+        return;
+    }
+    displayMatches("person(s)", ids, ms);
+}
+
+// Searches diagnoses, treatment plans, test reports, conditions and appointment notes
+void clinicalTextSearch(HospitalSystem& hospital) {
+    displayHeader("CLINICAL TEXT SEARCH");
+    
+    string query;
+    cout << "Operators: AND, OR, NOT; quote phrases. Adjacent words are ANDed.\n";
+    cout << "Example: pneumonia AND NOT covid\n\n";
+    cout << "Enter Query: ";
+    getline(cin, query);
+    
+    vector<TextHit> hits;
+    auto start = chrono::steady_clock::now();
+    bool valid = hospital.searchClinicalText(query, hits);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    
+    if (!valid) {
+        cout << "\nInvalid query!\n";
+        return;
+    }
+    cout << "\n" << hits.size() << " matching document(s) in " << ms << " ms\n";
+    const size_t shown = 20;  // Avoids flooding the console
+    for (size_t i = 0; i < hits.size() && i < shown; i++) {
+        cout << "- Patient " << hits[i].patientId << ": ";
+        switch (hits[i].kind) {
+            case TextSourceKind::Record:      cout << "Medical Record #" << hits[i].sourceId; break;
+            case TextSourceKind::Appointment: cout << "Appointment #" << hits[i].sourceId; break;
+            case TextSourceKind::Diseases:    cout << "Medical Conditions"; break;
+        }
+        cout << "\n";
+    }
+    if (hits.size() > shown) {
+        cout << "... and " << hits.size() - shown << " more\n";
+    }
+}
+
+// Finds people without knowing their ID
+void lookupOperations(HospitalSystem& hospital) {
+    int choice;
+    do {
+        displayHeader("FIND PERSON");
+        cout << "1. Search by Name\n";
+        cout << "2. Identify Caller (Phone Number)\n";
+        cout << "3. Search by Address\n";
+        cout << "0. Back to Main Menu\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1:
+                nameSearch(hospital);
+                break;
+            case 2:
+            case 3:
+                contactSearch(hospital, choice == 2);
+                break;
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Typo-tolerant name search ("Jon Smyth" finds "John Smith")
+void nameSearch(HospitalSystem& hospital) {
+    string query;
+    cout << "\nEnter Name (spelling need not be exact): ";
+    getline(cin, query);
+
+    vector<pair<Person*, double>> matches;
+    auto start = chrono::steady_clock::now();
+    hospital.searchByName(query, 10, matches);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    if (matches.empty()) {
+        cout << "\nNo similar names found.\n";
+        return;
+    }
+    cout << "\nBest matches (" << ms << " ms):\n";
+    for (const auto& match : matches) {
+        Person* person = match.first;
+        string role = dynamic_cast<Patient*>(person) ? "Patient"
+                    : dynamic_cast<Doctor*>(person) ? "Doctor" : "Nurse";
+        cout << "- " << person->getName() << " (" << role << " ID: " << person->getId()
+             << ", Age: " << person->getAge() << ") "
+             << static_cast<int>(match.second * 100 + 0.5) << "% match\n";
+    }
+}
+
+// Finds everyone registered under a phone number or address
+void contactSearch(HospitalSystem& hospital, bool byPhone) {
+    string key;
+    cout << (byPhone ? "\nEnter Phone Number: " : "\nEnter Address: ");
+    getline(cin, key);
+
+    const vector<Person*>& people = byPhone ? hospital.findByPhone(key) : hospital.findByAddress(key);
+    if (people.empty()) {
+        cout << "\nNo one is registered with that " << (byPhone ? "number" : "address") << ".\n";
+        return;
+    }
+    for (const Person* person : people) {
+        string role = dynamic_cast<const Patient*>(person) ? "Patient"
+                    : dynamic_cast<const Doctor*>(person) ? "Doctor" : "Nurse";
+        cout << "- " << person->getName() << " (" << role << " ID: " << person->getId() << ")"
+             << " | " << person->getContactNumber() << " | " << person->getAddress() << "\n";
+    }
+}
+
+// Warns about probable earlier registrations; returns true to register anyway
+bool confirmNotDuplicate(HospitalSystem& hospital, const Patient* patient) {
+    vector<pair<Patient*, double>> matches;
+    hospital.checkDuplicates(patient, matches);
+    if (matches.empty()) return true;
+
+    cout << "\nThis patient may already be registered:\n";
+    for (const auto& match : matches) {
+        const Patient* existing = match.first;
+        cout << "- " << existing->getName() << " (Patient ID: " << existing->getId()
+             << ", Age: " << existing->getAge() << ", Contact: " << existing->getContactNumber() << ") "
+             << static_cast<int>(match.second * 100 + 0.5) << "% likely\n";
+    }
+    char answer;
+    cout << "Register as a new patient anyway? (y/n): ";
+    cin >> answer;
+    cin.ignore();
+    return answer == 'y' || answer == 'Y';
+}
+
+// Lists probable duplicate registrations across all patients
+void duplicateReport(HospitalSystem& hospital) {
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    vector<DuplicatePair> pairs;
+    auto start = chrono::steady_clock::now();
+    hospital.findDuplicatePatients(threads, pairs);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "\n" << pairs.size() << " probable duplicate pair(s) found in " << ms << " ms ("
+         << threads << " threads)\n";
+    const size_t shown = 20;  // Avoids flooding the console
+    for (size_t i = 0; i < pairs.size() && i < shown; i++) {
+        const Patient* a = hospital.patientForRow(pairs[i].first);
+        const Patient* b = hospital.patientForRow(pairs[i].second);
+        cout << "- " << a->getName() << " (ID " << a->getId() << ") <-> " << b->getName()
+             << " (ID " << b->getId() << ") " << static_cast<int>(pairs[i].score * 100 + 0.5) << "%\n";
+    }
+    if (pairs.size() > shown) {
+        cout << "... and " << pairs.size() - shown << " more\n";
+    }
+}
+
+// Compresses clinical text that has not been used recently
+void coldTextOperations(HospitalSystem& hospital) {
+    int choice;
+    do {
+        displayHeader("COLD CLINICAL TEXT");
+        cout << "Text idle for " << hospital.getColdTextAge() << " day(s) is compressed.\n\n";
+        cout << "1. Compress Idle Text Now\n";
+        cout << "2. Change Idle Period\n";
+        cout << "3. Compression Report\n";
+        cout << "4. Compression Benchmark\n";
+        cout << "0. Back\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1: {
+                auto start = chrono::steady_clock::now();
+                size_t frozen = hospital.compressColdText();
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                cout << "\nCompressed " << frozen << " record(s)/appointment(s) in " << ms << " ms\n";
+                hospital.getColdTextStore().displayReport();
+                break;
+            }
+            case 2: {
+                int days;
+                cout << "\nEnter idle days before compression (0 = compress everything): ";
+                cin >> days;
+                cin.ignore();
+                if (days < 0) {
+                    cout << "\nInvalid period!\n";
+                } else {
+                    hospital.setColdTextAge(days);
+                }
+                break;
+            }
+            case 3:
+                hospital.getColdTextStore().displayReport();
+                break;
+            case 4: {
+                size_t records;
+                cout << "\nNumber of records to generate (e.g. 200000): ";
+                cin >> records;
+                cin.ignore();
+                runColdTextBenchmark(records);
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Keeps appointments, prescriptions and records of inactive patients on disk only
+void tieredStorageOperations(HospitalSystem& hospital) {
+    const string segmentDirectory = "patient_segments";  // Created in the working directory
+    int choice;
+    do {
+        displayHeader("TIERED PATIENT STORAGE");
+        const PatientTier& tier = hospital.getPatientTier();
+        if (tier.isEnabled()) {
+            cout << "On: the " << tier.getCapacity() << " most recently used patient(s) stay in memory.\n\n";
+        } else {
+            cout << "Off: every patient's records stay in memory.\n\n";
+        }
+        cout << "1. Enable / Change Resident Patients\n";
+        cout << "2. Disable (Load Everything Back)\n";
+        cout << "3. Storage Report\n";
+        cout << "4. Tiering Benchmark\n";
+        cout << "0. Back\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1: {
+                long long residentPatients;
+                cout << "\nPatients to keep in memory: ";
+                cin >> residentPatients;
+                cin.ignore();
+                if (residentPatients < 1) {
+                    cout << "\nInvalid number!\n";
+                } else if (hospital.enableTieredStorage(segmentDirectory, static_cast<size_t>(residentPatients))) {
+                    hospital.getPatientTier().displayReport();
+                } else {
+                    cout << "\nError: could not create " << segmentDirectory << "/\n";
+                }
+                break;
+            }
+            case 2:
+                hospital.disableTieredStorage();
+                cout << "\nAll patient records are back in memory.\n";
+                break;
+            case 3:
+                hospital.getPatientTier().displayReport();
+                break;
+            case 4: {
+                size_t patients, residentPatients;
+                cout << "\nNumber of patients to generate (e.g. 50000): ";
+                cin >> patients;
+                cout << "Patients to keep in memory (e.g. 2000): ";
+                cin >> residentPatients;
+                cin.ignore();
+                runTieredStorageBenchmark(patients, residentPatients);
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Lookup filter submenu: report, false-positive rate and benchmark
+void lookupFilterOperations(HospitalSystem& hospital) {
+    int choice;
+    do {
+        displayHeader("LOOKUP FILTERS");
+        cout << "Searches for unknown IDs are rejected without scanning the records.\n";
+        cout << "Target false-positive rate: " << hospital.getLookupFilterRate() * 100 << "%\n\n";
+        cout << "1. Filter Report\n";
+        cout << "2. Change False-Positive Rate\n";
+        cout << "3. Lookup Filter Benchmark\n";
+        cout << "0. Back\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1:
+                hospital.displayLookupFilterReport();
+                break;
+            case 2: {
+                double percent;
+                cout << "\nTarget false-positive rate in percent (e.g. 1): ";
+                cin >> percent;
+                cin.ignore();
+                if (!(percent > 0 && percent <= 50)) {
+                    cout << "\nInvalid rate! Enter a value above 0 and up to 50.\n";
+                } else {
+                    hospital.setLookupFilterRate(percent / 100);  // Rebuilds from the current records
+                    hospital.displayLookupFilterReport();
+                }
+                break;
+            }
+            case 3: {
+                size_t items;
+                double percent;
+                cout << "\nNumber of IDs to generate (e.g. 100000): ";
+                cin >> items;
+                cout << "Target false-positive rate in percent (e.g. 1): ";
+                cin >> percent;
+                cin.ignore();
+                if (!(percent > 0 && percent <= 50)) {
+                    cout << "\nInvalid rate!\n";
+                } else {
+                    runBloomFilterBenchmark(items, percent / 100);
+                }
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Report snapshot submenu: status and concurrent reader benchmark
+void snapshotOperations(HospitalSystem& hospital) {
+    int choice;
+    do {
+        displayHeader("REPORT SNAPSHOTS");
+        cout << "Inventory, room and billing reports read a point-in-time copy,\n";
+        cout << "so changes made while a report runs never block or mix in.\n\n";
+        cout << "1. Snapshot Status\n";
+        cout << "2. Concurrent Report Benchmark\n";
+        cout << "0. Back\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1:
+                hospital.displaySnapshotReport();
+                break;
+            case 2: {
+                size_t rows, writes;
+                unsigned readers;
+                cout << "\nNumber of rows (e.g. 10000): ";
+                cin >> rows;
+                cout << "Number of transfers (e.g. 1000000): ";
+                cin >> writes;
+                cout << "Reader threads (e.g. 2): ";
+                cin >> readers;
+                cin.ignore();
+                if (readers < 1 || readers > EpochManager::MAX_READERS) {
+                    cout << "\nInvalid number of readers!\n";
+                } else {
+                    runSnapshotBenchmark(rows, writes, readers);
+                }
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Log shipping status and replication lag benchmark
+void replicationOperations(HospitalSystem& hospital) {
+    int choice;
+    do {
+        displayHeader("REPLICATION");
+        cout << "Start the primary with:  program --primary <log file>\n";
+        cout << "and a standby with:      program --standby <log file>\n";
+        cout << "The standby replays every change as it is written and can be promoted\n";
+        cout << "to primary from its menu if this process stops.\n\n";
+        cout << "1. Shipping Status\n";
+        cout << "2. Replication Lag Benchmark\n";
+        cout << "0. Back\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1: {
+                const LogShipper& log = hospital.getReplicationLog();
+                if (!log.isOpen()) {
+                    cout << "\nNot shipping (started without --primary).\n";
+                } else {
+                    cout << "\nShipping to: " << log.getPath() << "\n";
+                    cout << "Last sequence: " << log.lastSequence() << "\n";
+                    cout << "Changes shipped since start: " << log.recordCount() << " ("
+                         << log.bytesWritten() << " bytes)\n";
+                }
+                break;
+            }
+            case 2: {
+                size_t mutations, rate;
+                cout << "\nNumber of changes (e.g. 20000): ";
+                cin >> mutations;
+                cout << "Changes per second (0 = as fast as possible): ";
+                cin >> rate;
+                cin.ignore();
+                runReplicationBenchmark(mutations, rate);
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Starts, saves, compacts and benchmarks incremental checkpoints
+void checkpointOperations(HospitalSystem& hospital) {
+    int choice;
+    do {
+        displayHeader("CHECKPOINTS");
+        cout << "A checkpoint saves every object once, then only objects changed since the\n";
+        cout << "last save. Start with:  program --checkpoint <directory>\n";
+        cout << "to restore from (or begin saving to) a directory.\n\n";
+        cout << "1. Checkpoint Status\n";
+        cout << "2. Start Checkpoints\n";
+        cout << "3. Stop Checkpoints\n";
+        cout << "4. Save Now\n";
+        cout << "5. Compact Deltas\n";
+        cout << "6. Full vs Delta Benchmark\n";
+        cout << "0. Back\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1:
+                hospital.displayCheckpointReport();
+                break;
+            case 2: {
+                string directory;
+                int interval;
+                cout << "\nDirectory (files in it are replaced): ";
+                getline(cin, directory);
+                cout << "Seconds between saves (e.g. 300): ";
+                cin >> interval;
+                cin.ignore();
+                if (hospital.enableCheckpoints(directory, interval)) {
+                    cout << "\nFull checkpoint written; changes will be saved as deltas.\n";
+                } else {
+                    cout << "\nError: could not write a checkpoint to " << directory << "\n";
+                }
+                break;
+            }
+            case 3:
+                if (hospital.isCheckpointing()) {
+                    hospital.saveCheckpoint();
+                    hospital.disableCheckpoints();
+                    cout << "\nLatest changes saved; checkpoints stopped.\n";
+                } else {
+                    cout << "\nCheckpoints are not running.\n";
+                }
+                break;
+            case 4:
+                if (hospital.saveCheckpoint()) {
+                    const CheckpointStore& store = hospital.getCheckpointStore();
+                    cout << "\nSaved " << store.lastRecordCount() << " objects (" << store.lastByteCount()
+                         << " bytes).\n";
+                } else {
+                    cout << "\nError: checkpoints are not running or the save failed.\n";
+                }
+                break;
+            case 5:
+                if (hospital.compactCheckpoints()) {
+                    cout << "\nDeltas merged; " << hospital.getCheckpointStore().bytesOnDisk() << " bytes on disk.\n";
+                } else {
+                    cout << "\nError: checkpoints are not running or compaction failed.\n";
+                }
+                break;
+            case 6: {
+                size_t patients, changes, saves;
+                cout << "\nNumber of patients (e.g. 20000): ";
+                cin >> patients;
+                cout << "Changes between saves (e.g. 500): ";
+                cin >> changes;
+                cout << "Number of saves (e.g. 100): ";
+                cin >> saves;
+                cin.ignore();
+                runCheckpointBenchmark(patients, changes, saves);
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
+
+// Lists, undoes and redoes recent changes made from the menus
+void historyOperations(HospitalSystem& hospital) {
+    int choice;
+    do {
+        displayHeader("UNDO / REDO");
+        const CommandLog& log = hospital.getCommandLog();
+        cout << log.undoCount() << " change(s) can be undone, " << log.redoCount() << " redone.\n";
+        cout << "Registrations and new bills are permanent; undo stops at them.\n\n";
+        cout << "1. Show Recent Changes\n";
+        cout << "2. Undo Last Change\n";
+        cout << "3. Redo Last Undone Change\n";
+        cout << "4. Set History Limit\n";
+        cout << "0. Back\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+        cin.ignore();
+
+        switch(choice) {
+            case 1:
+                log.displayHistory(10);
+                break;
+            case 2:
+                hospital.undo();
+                break;
+            case 3:
+                hospital.redo();
+                break;
+            case 4: {
+                size_t limit;
+                cout << "\nChanges to keep (currently " << log.getCapacity() << "): ";
+                cin >> limit;
+                cin.ignore();
+                hospital.setHistoryLimit(limit);
+                cout << "\nKeeping up to " << log.getCapacity() << " changes.\n";
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "\nInvalid choice!\n";
+        }
+        if (choice != 0) pressEnterToContinue();
+    } while (choice != 0);
+}
@@ -0,0 +1,71 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+// Standard library includes
+#include <string>   // For length-prefixed text
+#include <string_view> // For writing text held outside a string
+#include <vector>   // For byte buffers
+#include <cstdint>  // For fixed-width types
+#include <cstddef>  // For size_t
+#include <cstring>  // For memcpy
+using namespace std;
+
+// Appends value using 7 bits per byte (high bit = more bytes follow)
+inline void writeVarint(vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Reads a varint and advances the position
+inline uint64_t readVarint(const vector<uint8_t>& in, size_t& pos) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (true) {
+        uint8_t byte = in[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+        shift += 7;
+    }
+}
+
+// Appends text as a varint length followed by its bytes
+inline void writeString(vector<uint8_t>& out, string_view text) {
+    writeVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+// Reads length-prefixed text and advances the position
+inline string readString(const vector<uint8_t>& in, size_t& pos) {
+    size_t length = static_cast<size_t>(readVarint(in, pos));
+    string text(in.begin() + pos, in.begin() + pos + length);
+    pos += length;
+    return text;
+}
+
+// Appends a signed value, zigzag-mapped so small negatives stay short
+inline void writeSigned(vector<uint8_t>& out, int64_t value) {
+    writeVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+// Reads a zigzag-mapped signed value and advances the position
+inline int64_t readSigned(const vector<uint8_t>& in, size_t& pos) {
+    uint64_t value = readVarint(in, pos);
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Appends a double as its 8 raw bytes
+inline void writeDouble(vector<uint8_t>& out, double value) {
+    uint8_t bytes[sizeof(double)];
+    memcpy(bytes, &value, sizeof(double));
+    out.insert(out.end(), bytes, bytes + sizeof(double));
+}
+
+// Reads a double written by writeDouble and advances the position
+inline double readDouble(const vector<uint8_t>& in, size_t& pos) {
+    double value;
+    memcpy(&value, in.data() + pos, sizeof(double));
+    pos += sizeof(double);
+    return value;
+}
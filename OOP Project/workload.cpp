@@ -0,0 +1,89 @@
+#include "workload.h"  // Benchmark helper declarations
+
+// ========== CONSOLE SILENCER ========== //
+
+// Swaps the null buffer into cout
+ConsoleSilencer::ConsoleSilencer() : original(cout.rdbuf(&silent)) {}
+
+// Restores the console on leaving the scope
+ConsoleSilencer::~ConsoleSilencer() { restore(); }
+
+// Puts the original buffer back (once)
+void ConsoleSilencer::restore() {
+    if (!original) return;
+    cout.rdbuf(original);
+    original = nullptr;
+}
+
+// ========== POPULATION BUILDER ========== //
+
+// Name, code and drug lists the generated details are drawn from
+static const char* firstNames[] = { "Ayesha", "Muhammad", "Fatima", "Ali", "Zainab", "Hassan", "Maryam", "Omar" };
+static const char* lastNames[] = { "Khan", "Ahmed", "Malik", "Qureshi", "Siddiqui", "Chaudhry", "Sheikh" };
+static const char* longFirstNames[] = { "Alexandra", "Christopher", "Muhammad", "Elizabeth", "Jonathan", "Fatima" };
+static const char* longLastNames[] = { "Montgomery-Smith", "Abdullahi", "Richardson", "Vanderbilt", "Okonkwo" };
+static const char* bloodGroups[] = { "A+", "A-", "B+", "B-", "AB+", "AB-", "O+", "O-" };
+static const char* departments[] = { "Medicine", "Cardiology", "Paediatrics", "Surgery" };
+static const char* specializations[] = { "Physician", "Interventional Cardiology", "Neonatology", "General Surgery" };
+static const char* drugNames[] = { "Amoxicillin", "Metformin", "Amlodipine", "Paracetamol", "Atorvastatin",
+                                   "Amoxicillin Clavulanate" };
+
+// Starts the generator at seed
+PopulationBuilder::PopulationBuilder(unsigned seed, bool longNames) : generator(seed), longNames(longNames) {}
+
+// Uniform value below n
+size_t PopulationBuilder::pick(size_t n) { return static_cast<size_t>(generator() % n); }
+
+// First and last name from the short or long lists
+string PopulationBuilder::name() {
+    if (longNames) return string(longFirstNames[pick(6)]) + " " + longLastNames[pick(5)];
+    return string(firstNames[pick(8)]) + " " + lastNames[pick(7)];
+}
+
+// House and street in one neighbourhood
+string PopulationBuilder::address() {
+    return "House " + to_string(1 + pick(900)) + ", Street " + to_string(1 + pick(20)) + ", Gulberg";
+}
+
+// Mobile number in the format the contact index normalizes
+string PopulationBuilder::phone() { return "+92-300-" + to_string(1000000 + pick(9000000)); }
+
+// Patient with generated details; fields are drawn in a fixed order so runs repeat
+Patient PopulationBuilder::patient(int id, int doctorId) {
+    string patientName = name();
+    int age = 18 + static_cast<int>(pick(70));
+    const char* gender = pick(2) ? "Male" : "Female";
+    string patientAddress = address();
+    string contact = phone();
+    return Patient(id, patientName, age, gender, patientAddress, contact, bloodGroups[pick(8)], doctorId);
+}
+
+// Registers doctors across four departments
+vector<Doctor*> PopulationBuilder::addDoctors(HospitalSystem& hospital, int count) {
+    vector<Doctor*> doctors;
+    for (int i = 1; i <= count; i++) {
+        string doctorName = "Dr. " + name();
+        int age = 35 + static_cast<int>(pick(30));
+        const char* gender = pick(2) ? "Male" : "Female";
+        string doctorAddress = address();
+        string contact = phone();
+        Doctor* doctor = hospital.newDoctor(i, doctorName, age, gender, doctorAddress, contact, 150000,
+                                            departments[i % 4], "01/01/2015", specializations[i % 4],
+                                            "PMDC-" + to_string(100000 + i));
+        hospital.addDoctor(doctor);
+        doctors.push_back(doctor);
+    }
+    return doctors;
+}
+
+// Registers medicines named after common drugs and strengths
+vector<Medicine*> PopulationBuilder::addMedicines(HospitalSystem& hospital, int count, int quantity) {
+    vector<Medicine*> medicines;
+    for (int i = 0; i < count; i++) {
+        string drug = string(drugNames[i % 6]) + " " + to_string(125 * (i / 6 + 1)) + "mg";
+        Medicine* medicine = hospital.newMedicine(drug, 2.5 + i, quantity, "01/01/2030");
+        hospital.addMedicine(medicine);
+        medicines.push_back(medicine);
+    }
+    return medicines;
+}
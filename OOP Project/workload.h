@@ -0,0 +1,61 @@
+#pragma once  // Header guard to prevent multiple inclusions
+
+#include "hospital.h"  // For the entities the benchmarks generate
+#include <random>      // For the seeded generator
+using namespace std;
+
+// Discards everything written to cout while in scope (entity methods print
+// confirmations). The console comes back when the silencer is destroyed, even
+// if an exception leaves the scope, or earlier with restore(). Streams built on
+// the original buffer beforehand keep printing.
+class ConsoleSilencer {
+private:
+    // Stream buffer that discards everything
+    class NullBuffer : public streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+        streamsize xsputn(const char*, streamsize count) override { return count; }
+    };
+
+    NullBuffer silent;
+    streambuf* original;  // Buffer to put back (nullptr once restored)
+
+public:
+    ConsoleSilencer();
+    ~ConsoleSilencer();
+    ConsoleSilencer(const ConsoleSilencer&) = delete;
+    ConsoleSilencer& operator=(const ConsoleSilencer&) = delete;
+
+    // Puts the console back before the end of the scope
+    void restore();
+};
+
+// Generated people and stock for the diagnostics benchmarks, drawn from one
+// seeded generator so every benchmark builds the same kind of hospital and a
+// run can be repeated. Long names are longer than the short-string buffer
+// (for the allocation check).
+class PopulationBuilder {
+private:
+    mt19937 generator;
+    bool longNames;
+
+public:
+    explicit PopulationBuilder(unsigned seed = 2024, bool longNames = false);
+
+    // Uniform value below n (workload choices share the generator)
+    size_t pick(size_t n);
+
+    // Generated details
+    string name();     // "First Last"
+    string address();  // "House 12, Street 4, Gulberg"
+    string phone();    // "+92-300-1234567"
+
+    // Unregistered patient with generated details (for newPatient or a pool)
+    Patient patient(int id, int doctorId);
+
+    // Registers doctors with IDs 1 to count
+    vector<Doctor*> addDoctors(HospitalSystem& hospital, int count);
+
+    // Registers medicines with the given stock each
+    vector<Medicine*> addMedicines(HospitalSystem& hospital, int count, int quantity);
+};